@@ -0,0 +1,68 @@
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "atomic.hh"
+#include "bench/bench.hh"
+
+namespace {
+
+constexpr size_t kOps = 1 << 20;
+
+// Splits kOps calls of `op` over `threads` threads, and returns the wall time per call.
+template <typename F>
+double contended(int threads, F &&op) {
+  return bench::measure(1, [&](size_t) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&] {
+        for (size_t i = 0; i < kOps / threads; ++i) {
+          op();
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }) / kOps;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    std::printf("%d threads\n", threads);
+    std::atomic<int64_t> plain(0);
+    numbers::atomic<numbers::i64> counter;
+    bench::report("  std::atomic fetch_add", contended(threads, [&] { plain.fetch_add(1); }));
+    bench::report("  fetch_wrapping_add",
+                  contended(threads, [&] { counter.fetch_wrapping_add(numbers::i64(1)); }));
+    bench::report("  fetch_overflowing_add",
+                  contended(threads, [&] { bench::do_not_optimize(counter.fetch_overflowing_add(numbers::i64(1))); }));
+    bench::report("  fetch_saturating_add",
+                  contended(threads, [&] { counter.fetch_saturating_add(numbers::i64(1)); }));
+    bench::report("  fetch_checked_add",
+                  contended(threads, [&] { bench::do_not_optimize(counter.fetch_checked_add(numbers::i64(1))); }));
+    counter.store(numbers::i64::MAX);
+    bench::report("  fetch_saturating_add, saturated",
+                  contended(threads, [&] { counter.fetch_saturating_add(numbers::i64(1)); }));
+
+    std::mutex mutex;
+    numbers::uint128 guarded = 0;
+    numbers::atomic<numbers::u128> wide;
+    numbers::atomic_internal::locked_cell<numbers::uint128> locked(0);
+    bench::report("  u128 std::mutex", contended(threads, [&] {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    guarded += 1;
+                  }));
+    bench::report("  u128 spin lock fallback", contended(threads, [&] { locked.fetch_add(1); }));
+    bench::report("  u128 fetch_wrapping_add", contended(threads, [&] { wide.fetch_wrapping_add(numbers::u128(1)); }));
+    bench::report("  u128 fetch_saturating_add",
+                  contended(threads, [&] { wide.fetch_saturating_add(numbers::u128(1)); }));
+    bench::report("  u128 load", contended(threads, [&] { bench::do_not_optimize(wide.load()); }));
+  }
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "cast.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+std::vector<numbers::i32> random_values(unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int32_t> dist(-100000, 100000);
+  std::vector<numbers::i32> values(kCount);
+  for (auto &value : values) {
+    value = numbers::i32(dist(engine));
+  }
+  return values;
+}
+
+template <typename To>
+void run(const char *scalar_name, const char *batch_name) {
+  const auto src = random_values(1);
+  std::vector<To> dst(kCount);
+
+  bench::report(scalar_name, bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    dst[k] = numbers::saturating_cast<To>(src[k]);
+                  }
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+
+  bench::report(batch_name, bench::measure(1 << 10, [&](size_t) {
+                  numbers::saturating_cast(src.data(), src.size(), dst.data());
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+}
+
+}  // namespace
+
+int main() {
+  run<numbers::i16>("i32 -> i16 saturating_cast, per value", "i32 -> i16 saturating_cast, batch");
+  run<numbers::u16>("i32 -> u16 saturating_cast, per value", "i32 -> u16 saturating_cast, batch");
+  return 0;
+}
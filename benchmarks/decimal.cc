@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "decimal.hh"
+#include "random.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+using money = numbers::decimal64<4>;
+using wide = numbers::decimal128<18>;
+
+#ifdef __SIZEOF_INT128__
+// The hand written rescaling the decimal type replaces: a 128-bit product and
+// a 128-bit division, rounding half away from zero.
+int64_t naive_mul(int64_t a, int64_t b) {
+  const __int128 p = static_cast<__int128>(a) * b;
+  return static_cast<int64_t>((p + (p < 0 ? -5000 : 5000)) / 10000);
+}
+
+int64_t naive_div(int64_t a, int64_t b) {
+  const __int128 n = static_cast<__int128>(a) * 10000;
+  const __int128 half = b / 2 < 0 ? -(b / 2) : b / 2;
+  return static_cast<int64_t>((n + ((n < 0) != (b < 0) ? -half : half)) / b);
+}
+#endif
+
+template <typename F>
+double per_element(F &&fn) {
+  return bench::measure(1 << 8, [&](size_t) {
+           for (size_t k = 0; k < kCount; ++k) {
+             fn(k);
+           }
+         }) /
+         kCount;
+}
+
+}  // namespace
+
+int main() {
+  numbers::xoshiro256ss engine(1);
+  std::vector<int64_t> raw_a(kCount), raw_b(kCount), raw_dst(kCount);
+  std::vector<double> dbl_a(kCount), dbl_b(kCount), dbl_dst(kCount);
+  std::vector<money> dec_a(kCount), dec_b(kCount), dec_dst(kCount);
+  std::vector<wide> wide_a(kCount), wide_b(kCount), wide_dst(kCount);
+  for (size_t k = 0; k < kCount; ++k) {
+    // prices up to 10000.0000 and quantities up to 100.0000
+    raw_a[k] = numbers::uniform(engine, int64_t{1}, int64_t{100000000});
+    raw_b[k] = numbers::uniform(engine, int64_t{1}, int64_t{1000000});
+    dbl_a[k] = static_cast<double>(raw_a[k]) / 10000;
+    dbl_b[k] = static_cast<double>(raw_b[k]) / 10000;
+    dec_a[k] = money::from_units(numbers::i64(raw_a[k]));
+    dec_b[k] = money::from_units(numbers::i64(raw_b[k]));
+    wide_a[k] = *wide::parse(dec_a[k].to_string());
+    wide_b[k] = *wide::parse(dec_b[k].to_string());
+  }
+
+  bench::report("add, double", per_element([&](size_t k) { dbl_dst[k] = dbl_a[k] + dbl_b[k]; }));
+  bench::report("add, decimal64<4>", per_element([&](size_t k) { dec_dst[k] = dec_a[k] + dec_b[k]; }));
+  bench::report("mul, double", per_element([&](size_t k) { dbl_dst[k] = dbl_a[k] * dbl_b[k]; }));
+#ifdef __SIZEOF_INT128__
+  bench::report("mul, naive __int128", per_element([&](size_t k) { raw_dst[k] = naive_mul(raw_a[k], raw_b[k]); }));
+#endif
+  bench::report("mul, decimal64<4>", per_element([&](size_t k) { dec_dst[k] = dec_a[k] * dec_b[k]; }));
+  bench::report("mul, decimal128<18>", per_element([&](size_t k) { wide_dst[k] = wide_a[k] * wide_b[k]; }));
+  bench::report("div, double", per_element([&](size_t k) { dbl_dst[k] = dbl_a[k] / dbl_b[k]; }));
+#ifdef __SIZEOF_INT128__
+  bench::report("div, naive __int128", per_element([&](size_t k) { raw_dst[k] = naive_div(raw_a[k], raw_b[k]); }));
+#endif
+  bench::report("div, decimal64<4>", per_element([&](size_t k) { dec_dst[k] = dec_a[k] / dec_b[k]; }));
+  bench::report("div, decimal128<18>", per_element([&](size_t k) { wide_dst[k] = wide_a[k] / wide_b[k]; }));
+  bench::report("rescale<2>, decimal64<4>",
+                per_element([&](size_t k) { bench::do_not_optimize(dec_a[k].rescale<2>()); }));
+  bench::do_not_optimize(raw_dst.data());
+  bench::do_not_optimize(dbl_dst.data());
+  bench::do_not_optimize(dec_dst.data());
+  bench::do_not_optimize(wide_dst.data());
+
+  char buf[64];
+  bench::report("format, snprintf %.4f", per_element([&](size_t k) {
+                  bench::do_not_optimize(std::snprintf(buf, sizeof(buf), "%.4f", dbl_a[k]));
+                }));
+  bench::report("format, decimal64<4>::to_chars",
+                per_element([&](size_t k) { bench::do_not_optimize(dec_a[k].to_chars(buf, buf + sizeof(buf))); }));
+  std::vector<std::string> texts(kCount);
+  for (size_t k = 0; k < kCount; ++k) {
+    texts[k] = dec_a[k].to_string();
+  }
+  bench::report("parse, strtod",
+                per_element([&](size_t k) { bench::do_not_optimize(std::strtod(texts[k].c_str(), nullptr)); }));
+  bench::report("parse, decimal64<4>::parse",
+                per_element([&](size_t k) { bench::do_not_optimize(money::parse(texts[k])); }));
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "duration.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+std::vector<int64_t> random_ticks(unsigned seed) {
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<int64_t> dist(-(int64_t{1} << 60), int64_t{1} << 60);
+  std::vector<int64_t> values(kCount);
+  for (auto &value : values) {
+    value = dist(engine);
+  }
+  return values;
+}
+
+}  // namespace
+
+int main() {
+  const auto ticks = random_ticks(1);
+  std::vector<numbers::duration_ns> ns(kCount);
+  std::vector<numbers::duration_ps> ps(kCount);
+  for (size_t k = 0; k < kCount; ++k) {
+    ns[k] = numbers::duration_ns(numbers::i64(ticks[k]));
+    ps[k] = numbers::duration_ps(ns[k]) * numbers::i128(1000);
+  }
+  const numbers::timestamp_ns now = numbers::timestamp_ns::now<std::chrono::steady_clock>();
+  std::vector<numbers::timestamp_ns> deadlines(kCount);
+
+  bench::report("std::chrono now + timeout, per value", bench::measure(1 << 12, [&](size_t) {
+                  const auto base = now.to_chrono<std::chrono::steady_clock>();
+                  for (size_t k = 0; k < kCount; ++k) {
+                    bench::do_not_optimize(base + std::chrono::nanoseconds(ticks[k]));
+                  }
+                }) / kCount);
+  bench::report("timestamp_ns now + timeout, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    deadlines[k] = now + ns[k];
+                  }
+                  bench::do_not_optimize(deadlines.data());
+                }) / kCount);
+
+  std::vector<numbers::i64> ms(kCount);
+  bench::report("duration_ns count_as<milli>, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    ms[k] = ns[k].count_as<std::milli>();
+                  }
+                  bench::do_not_optimize(ms.data());
+                }) / kCount);
+
+  std::vector<numbers::i128> wide(kCount);
+  bench::report("duration_ps count_as<milli>, per value", bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    wide[k] = ps[k].count_as<std::milli>();
+                  }
+                  bench::do_not_optimize(wide.data());
+                }) / kCount);
+  const numbers::i128 divisor(1'000'000'000);
+  bench::report("i128 / 10^9, per value", bench::measure(1 << 6, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    wide[k] = ps[k].count() / divisor;
+                  }
+                  bench::do_not_optimize(wide.data());
+                }) / kCount);
+  return 0;
+}
@@ -0,0 +1,49 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "expr.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+template <typename T>
+std::vector<T> random_values(int lo, int hi, unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> dist(lo, hi);
+  std::vector<T> values(kCount);
+  for (auto &value : values) {
+    value = T(dist(engine));
+  }
+  return values;
+}
+
+template <typename T>
+void run(const char *chain_name, const char *expr_name) {
+  const auto a = random_values<T>(-1000, 1000, 1);
+  const auto b = random_values<T>(-1000, 1000, 2);
+  const auto c = random_values<T>(-1000, 1000, 3);
+  const auto d = random_values<T>(-1000, 1000, 4);
+
+  bench::report(chain_name, bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  T ret = a[k] * b[k] + c[k] - d[k];
+                  bench::do_not_optimize(ret);
+                }));
+
+  bench::report(expr_name, bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  T ret = numbers::expr(a[k]) * b[k] + c[k] - d[k];
+                  bench::do_not_optimize(ret);
+                }));
+}
+
+}  // namespace
+
+int main() {
+  run<numbers::i32>("i32 a * b + c - d, operator chain", "i32 a * b + c - d, expr");
+  run<numbers::i64>("i64 a * b + c - d, operator chain", "i64 a * b + c - d, expr");
+  run<numbers::i128>("i128 a * b + c - d, operator chain", "i128 a * b + c - d, expr");
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "fixed.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+std::vector<numbers::q15> random_q15(unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> dist(INT16_MIN, INT16_MAX);
+  std::vector<numbers::q15> values(kCount);
+  for (auto &value : values) {
+    value = numbers::q15::from_raw(numbers::i16(static_cast<int16_t>(dist(engine))));
+  }
+  return values;
+}
+
+}  // namespace
+
+int main() {
+  const auto a = random_q15(1);
+  const auto b = random_q15(2);
+  std::vector<numbers::q15> dst(kCount);
+
+  bench::report("q15 saturating_add, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    dst[k] = a[k].saturating_add(b[k]);
+                  }
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+  bench::report("q15 saturating_add, batch", bench::measure(1 << 12, [&](size_t) {
+                  numbers::saturating_add(a.data(), b.data(), kCount, dst.data());
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+
+  bench::report("q15 saturating_mul, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    dst[k] = a[k].saturating_mul(b[k]);
+                  }
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+  bench::report("q15 saturating_mul, batch", bench::measure(1 << 12, [&](size_t) {
+                  numbers::saturating_mul(a.data(), b.data(), kCount, dst.data());
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+
+  bench::report("q15 saturating_mac, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    dst[k] = dst[k].saturating_mac(a[k], b[k]);
+                  }
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+  bench::report("q15 saturating_mac, batch", bench::measure(1 << 12, [&](size_t) {
+                  numbers::saturating_mac(dst.data(), a.data(), b.data(), kCount);
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+
+  std::vector<float> floats(kCount);
+  std::mt19937 engine(3);
+  std::uniform_real_distribution<float> dist(-1.25f, 1.25f);
+  for (float &f : floats) {
+    f = dist(engine);
+  }
+  bench::report("float -> q15 from_float, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    dst[k] = numbers::q15::from_float(floats[k]);
+                  }
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+  bench::report("float -> q15 from_float, batch", bench::measure(1 << 12, [&](size_t) {
+                  numbers::from_float(floats.data(), kCount, dst.data());
+                  bench::do_not_optimize(dst.data());
+                }) / kCount);
+
+  std::vector<numbers::q31> q31s(kCount);
+  bench::report("float -> q31 from_float, per value", bench::measure(1 << 12, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    q31s[k] = numbers::q31::from_float(floats[k]);
+                  }
+                  bench::do_not_optimize(q31s.data());
+                }) / kCount);
+  bench::report("float -> q31 from_float, batch", bench::measure(1 << 12, [&](size_t) {
+                  numbers::from_float(floats.data(), kCount, q31s.data());
+                  bench::do_not_optimize(q31s.data());
+                }) / kCount);
+  return 0;
+}
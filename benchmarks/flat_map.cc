@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "flat_map.hh"
+
+namespace {
+
+constexpr size_t kKeys = 1 << 20;
+
+template <typename K>
+K make_key(uint64_t x);
+
+template <>
+numbers::u64 make_key<numbers::u64>(uint64_t x) {
+  return numbers::u64(x);
+}
+
+template <>
+numbers::u128 make_key<numbers::u128>(uint64_t x) {
+  return numbers::u128(numbers::make_uint128(x >> 3, x * 0x9e3779b97f4a7c15ull));
+}
+
+template <typename K>
+std::vector<K> random_keys(unsigned seed) {
+  std::mt19937_64 engine(seed);
+  std::vector<K> keys(kKeys);
+  for (auto &key : keys) {
+    key = make_key<K>(engine());
+  }
+  return keys;
+}
+
+template <typename K>
+void run(const char *name) {
+  const auto keys = random_keys<K>(1);
+  auto queries = keys;
+  std::shuffle(queries.begin(), queries.end(), std::mt19937_64(2));
+  std::vector<uint64_t> values(kKeys);
+  for (size_t i = 0; i < kKeys; ++i) {
+    values[i] = i;
+  }
+  std::printf("%s, %zu keys\n", name, kKeys);
+
+  bench::report("  std::unordered_map insert", bench::measure(1, [&](size_t) {
+                  std::unordered_map<K, uint64_t> map;
+                  for (size_t i = 0; i < kKeys; ++i) {
+                    map.emplace(keys[i], values[i]);
+                  }
+                  bench::do_not_optimize(map.size());
+                }) / kKeys);
+  bench::report("  flat_map insert", bench::measure(1, [&](size_t) {
+                  numbers::flat_map<K, uint64_t> map;
+                  for (size_t i = 0; i < kKeys; ++i) {
+                    map.insert(keys[i], values[i]);
+                  }
+                  bench::do_not_optimize(map.size());
+                }) / kKeys);
+  bench::report("  flat_map bulk insert", bench::measure(1, [&](size_t) {
+                  numbers::flat_map<K, uint64_t> map;
+                  map.insert(keys.data(), values.data(), kKeys);
+                  bench::do_not_optimize(map.size());
+                }) / kKeys);
+
+  std::unordered_map<K, uint64_t> std_map;
+  numbers::flat_map<K, uint64_t> flat_map;
+  for (size_t i = 0; i < kKeys; ++i) {
+    std_map.emplace(keys[i], values[i]);
+    flat_map.insert(keys[i], values[i]);
+  }
+  std::vector<uint64_t> found(kKeys);
+
+  bench::report("  std::unordered_map find", bench::measure(1, [&](size_t) {
+                  for (size_t i = 0; i < kKeys; ++i) {
+                    found[i] = std_map.find(queries[i])->second;
+                  }
+                  bench::do_not_optimize(found.data());
+                }) / kKeys);
+  bench::report("  flat_map find", bench::measure(1, [&](size_t) {
+                  for (size_t i = 0; i < kKeys; ++i) {
+                    found[i] = *flat_map.find(queries[i]);
+                  }
+                  bench::do_not_optimize(found.data());
+                }) / kKeys);
+  bench::report("  flat_map bulk find", bench::measure(1, [&](size_t) {
+                  flat_map.find(queries.data(), kKeys, found.data(), 0);
+                  bench::do_not_optimize(found.data());
+                }) / kKeys);
+}
+
+}  // namespace
+
+int main() {
+  run<numbers::u64>("u64 keys");
+  run<numbers::u128>("u128 keys");
+  return 0;
+}
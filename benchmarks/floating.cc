@@ -0,0 +1,52 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "floating.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+std::vector<float> random_floats(unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> dist(-3e9f, 3e9f);
+  std::vector<float> values(kCount);
+  for (auto &value : values) {
+    value = dist(engine);
+  }
+  return values;
+}
+
+}  // namespace
+
+int main() {
+  const auto floats = random_floats(1);
+  std::vector<numbers::i32> ints(kCount);
+  std::vector<double> doubles(kCount);
+
+  bench::report("f32 -> i32 saturating_from_float, per value", bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    ints[k] = numbers::saturating_from_float<numbers::i32>(floats[k]);
+                  }
+                  bench::do_not_optimize(ints.data());
+                }) / kCount);
+
+  bench::report("f32 -> i32 saturating_from_float, batch", bench::measure(1 << 10, [&](size_t) {
+                  numbers::saturating_from_float(floats.data(), floats.size(), ints.data());
+                  bench::do_not_optimize(ints.data());
+                }) / kCount);
+
+  bench::report("i32 -> f64 to_double, per value", bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    doubles[k] = numbers::to_double(ints[k]);
+                  }
+                  bench::do_not_optimize(doubles.data());
+                }) / kCount);
+
+  bench::report("i32 -> f64 to_double, batch", bench::measure(1 << 10, [&](size_t) {
+                  numbers::to_double(ints.data(), ints.size(), doubles.data());
+                  bench::do_not_optimize(doubles.data());
+                }) / kCount);
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "fused.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+template <typename T>
+std::vector<T> random_values(int lo, int hi, unsigned seed) {
+  std::mt19937 engine(seed);
+  std::uniform_int_distribution<int> dist(lo, hi);
+  std::vector<T> values(kCount);
+  for (auto &value : values) {
+    value = T(dist(engine));
+  }
+  return values;
+}
+
+template <typename T>
+void run(const char *chain_name, const char *fused_name) {
+  const auto price = random_values<T>(1, 100000, 1);
+  const auto qty = random_values<T>(-1000, 1000, 2);
+
+  T acc = 0;
+  bench::report(chain_name, bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  acc = acc + price[k] * qty[k];
+                  bench::do_not_optimize(acc);
+                }));
+
+  acc = 0;
+  bench::report(fused_name, bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  acc = numbers::mul_add(price[k], qty[k], acc);
+                  bench::do_not_optimize(acc);
+                }));
+}
+
+}  // namespace
+
+int main() {
+  run<numbers::i64>("i64 acc + price * qty, operator chain", "i64 acc + price * qty, mul_add");
+  run<numbers::i128>("i128 acc + price * qty, operator chain", "i128 acc + price * qty, mul_add");
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <unordered_set>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "hash.hh"
+
+namespace {
+
+constexpr size_t kKeys = 1 << 12;
+
+// The combination std::hash<uint128> used before: (hash(hi) << 1) ^ hash(lo).
+struct xor_hash {
+  size_t operator()(const numbers::u128 &v) const {
+    const numbers::uint128 raw = static_cast<numbers::uint128>(v);
+    return (std::hash<uint64_t>()(numbers::uint128_high64(raw)) << 1) ^
+           std::hash<uint64_t>()(numbers::uint128_low64(raw));
+  }
+};
+
+// Keys whose halves are related, (hi = x, lo = 2x), as in composite ids.
+std::vector<numbers::u128> structured_keys() {
+  std::vector<numbers::u128> keys(kKeys);
+  for (uint64_t x = 0; x < kKeys; ++x) {
+    keys[x] = numbers::u128(numbers::make_uint128(x, 2 * x));
+  }
+  return keys;
+}
+
+template <typename Hasher>
+void run_table(const char *name, const std::vector<numbers::u128> &keys) {
+  bench::report(name, bench::measure(8, [&](size_t) {
+                  std::unordered_set<numbers::u128, Hasher> set;
+                  set.reserve(keys.size());
+                  for (const auto &key : keys) {
+                    set.insert(key);
+                  }
+                  size_t found = 0;
+                  for (const auto &key : keys) {
+                    found += set.count(key);
+                  }
+                  bench::do_not_optimize(found);
+                }) / kKeys);
+}
+
+}  // namespace
+
+int main() {
+  const auto keys = structured_keys();
+  run_table<xor_hash>("u128 unordered_set insert + find, xor hash", keys);
+  run_table<std::hash<numbers::u128>>("u128 unordered_set insert + find, std::hash", keys);
+
+  std::vector<uint64_t> hashes(kKeys);
+  bench::report("u128 hash, per value", bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k < kKeys; ++k) {
+                    hashes[k] = numbers::hash(keys[k], 7);
+                  }
+                  bench::do_not_optimize(hashes.data());
+                }) / kKeys);
+  bench::report("u128 hash, batch", bench::measure(1 << 10, [&](size_t) {
+                  numbers::hash(keys.data(), keys.size(), hashes.data(), 7);
+                  bench::do_not_optimize(hashes.data());
+                }) / kKeys);
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <vector>
+
+#include "bench/bench.hh"
+#include "histogram.hh"
+#include "random.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+}  // namespace
+
+int main() {
+  numbers::xoshiro256ss engine(1);
+  std::vector<numbers::u64> latencies(kCount);
+  // mostly around 100us with a long tail
+  for (auto &latency : latencies) {
+    const uint64_t tail = numbers::uniform(engine, uint64_t{0}, uint64_t{99}) == 0 ? 100 : 1;
+    latency = numbers::uniform(engine, numbers::u64(50000), numbers::u64(150000 * tail));
+  }
+
+  numbers::histogram h;
+  bench::report("record", bench::measure(1 << 8, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    h.record(latencies[k]);
+                  }
+                  bench::do_not_optimize(h.count());
+                }) / kCount);
+  bench::report("percentile 99", bench::measure(1 << 10, [&](size_t) { bench::do_not_optimize(h.percentile(99)); }));
+
+  numbers::histogram other;
+  other.record(numbers::u64(1));
+  bench::report("merge", bench::measure(1 << 10, [&](size_t) { h.merge(other); }));
+  bench::report("serialize", bench::measure(1 << 10, [&](size_t) { bench::do_not_optimize(h.serialize().size()); }));
+  const std::vector<uint8_t> bytes = h.serialize();
+  bench::report("deserialize", bench::measure(1 << 10, [&](size_t) {
+                  bench::do_not_optimize(numbers::histogram::deserialize(bytes.data(), bytes.size()).count());
+                }));
+  return 0;
+}
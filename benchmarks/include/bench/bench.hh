@@ -0,0 +1,54 @@
+#ifndef NUMBERS_BENCH_BENCH_HH
+#define NUMBERS_BENCH_BENCH_HH
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace bench {
+
+// do_not_optimize()
+//
+// Forces the compiler to materialize `value`, so the computation producing it
+// can not be optimized away.
+template <typename T>
+inline void do_not_optimize(const T &value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  static volatile const T *sink;
+  sink = &value;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// measure()
+//
+// Runs `fn` `iterations` times per round and returns the best time per
+// iteration in nanoseconds over a few rounds.
+template <typename F>
+double measure(size_t iterations, F &&fn) {
+  constexpr int rounds = 5;
+  double best = 0;
+  for (int round = 0; round < rounds; ++round) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      fn(i);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iterations);
+    best = round == 0 ? ns : std::min(best, ns);
+  }
+  return best;
+}
+
+inline void report(const char *name, double ns_per_op) { std::printf("%-48s %10.3f ns/op\n", name, ns_per_op); }
+
+}  // namespace bench
+
+#endif
@@ -0,0 +1,74 @@
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "int128.hh"
+#include "io.hh"
+
+// Built twice: int128_benchmark calls division, formatting and the float
+// constructors in the library, int128_header_only_benchmark compiles them in
+// with NUMBERS_HEADER_ONLY, where they can be inlined.
+#ifdef NUMBERS_HEADER_ONLY
+#define MODE "header-only "
+#else
+#define MODE "library "
+#endif
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+std::vector<numbers::uint128> random_values(unsigned seed, int bits) {
+  std::mt19937_64 engine(seed);
+  std::vector<numbers::uint128> values(kCount);
+  for (auto &value : values) {
+    const numbers::uint128 wide = numbers::make_uint128(engine(), engine());
+    value = wide >> (128 - bits);
+  }
+  return values;
+}
+
+}  // namespace
+
+int main() {
+  const auto values = random_values(1, 128);
+  const auto divisors = random_values(2, 40);
+  std::vector<double> doubles(kCount);
+  for (size_t k = 0; k < kCount; ++k) {
+    doubles[k] = static_cast<double>(values[k]);
+  }
+
+  numbers::uint128 out;
+  bench::report(MODE "uint128 / 10", bench::measure(1 << 20, [&](size_t i) {
+                  out = values[i % kCount] / 10;
+                  bench::do_not_optimize(out);
+                }));
+  bench::report(MODE "uint128 % 1000000007", bench::measure(1 << 20, [&](size_t i) {
+                  out = values[i % kCount] % 1000000007;
+                  bench::do_not_optimize(out);
+                }));
+  bench::report(MODE "uint128 / variable 40-bit", bench::measure(1 << 20, [&](size_t i) {
+                  out = values[i % kCount] / (divisors[i % kCount] | 1);
+                  bench::do_not_optimize(out);
+                }));
+
+  numbers::int128 signed_out;
+  bench::report(MODE "int128 / -10", bench::measure(1 << 20, [&](size_t i) {
+                  signed_out = numbers::int128(values[i % kCount] >> 1) / -10;
+                  bench::do_not_optimize(signed_out);
+                }));
+
+  bench::report(MODE "uint128(double)", bench::measure(1 << 20, [&](size_t i) {
+                  out = numbers::uint128(doubles[i % kCount]);
+                  bench::do_not_optimize(out);
+                }));
+
+  std::ostringstream os;
+  bench::report(MODE "uint128 operator<<", bench::measure(1 << 16, [&](size_t i) {
+                  os.str("");
+                  os << values[i % kCount];
+                  bench::do_not_optimize(os);
+                }));
+  return 0;
+}
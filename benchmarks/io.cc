@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "bench/bench.hh"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+namespace {
+
+// Two programs doing the same integer work: one including numbers.h alone,
+// and one also including <iostream>, which is what numbers.h used to include.
+constexpr const char *kProgram =
+    "#include \"numbers.h\"\n"
+    "int main(int argc, char **) { return static_cast<int>(numbers::i32(argc) * numbers::i32(2)) - 2; }\n";
+
+const std::string kDir = NUMBERS_BENCH_DIR;
+
+std::string write_source(const char *name, const std::string &text) {
+  const std::string path = kDir + "/" + name;
+  std::ofstream(path) << text;
+  return path;
+}
+
+std::string compile_command(const std::string &source, const std::string &flags) {
+  return std::string("\"") + NUMBERS_BENCH_CXX + "\" -std=c++17 -I\"" + NUMBERS_BENCH_INCLUDE + "\" " + flags + " \"" +
+         source + "\"";
+}
+
+bool run(const std::string &command) { return std::system(command.c_str()) == 0; }
+
+void spawn(const std::string &path) {
+  char *argv[] = {const_cast<char *>(path.c_str()), nullptr};
+  pid_t pid;
+  if (posix_spawn(&pid, path.c_str(), nullptr, nullptr, argv, environ) == 0) {
+    int status;
+    waitpid(pid, &status, 0);
+  }
+}
+
+}  // namespace
+
+int main() {
+  const std::string core = write_source("io_core.cc", kProgram);
+  const std::string iostream = write_source("io_iostream.cc", std::string("#include <iostream>\n") + kProgram);
+
+  bench::report("compile with numbers.h", bench::measure(3, [&](size_t) {
+                  run(compile_command(core, "-fsyntax-only"));
+                }));
+  bench::report("compile with numbers.h and <iostream>", bench::measure(3, [&](size_t) {
+                  run(compile_command(iostream, "-fsyntax-only"));
+                }));
+
+  const std::string core_exe = kDir + "/io_core";
+  const std::string iostream_exe = kDir + "/io_iostream";
+  if (!run(compile_command(core, "-O2 -o \"" + core_exe + "\"")) ||
+      !run(compile_command(iostream, "-O2 -o \"" + iostream_exe + "\""))) {
+    std::printf("could not build the startup programs\n");
+    return 1;
+  }
+  bench::report("start a program with numbers.h", bench::measure(200, [&](size_t) { spawn(core_exe); }));
+  bench::report("start a program with numbers.h and <iostream>",
+                bench::measure(200, [&](size_t) { spawn(iostream_exe); }));
+  return 0;
+}
+
+#else
+
+int main() {
+  std::printf("the io benchmark runs the compiler and programs, which it only does on POSIX systems\n");
+  return 0;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "mixed.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+template <typename T>
+std::vector<T> random_values(int64_t lo, int64_t hi, unsigned seed) {
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<int64_t> dist(lo, hi);
+  std::vector<T> values(kCount);
+  for (auto &value : values) {
+    value = T(dist(engine));
+  }
+  return values;
+}
+
+// What users write today to stay safe: promote both operands to i128.
+std::optional<numbers::i64> promoted_add(numbers::i64 lhs, numbers::u64 rhs) {
+  const numbers::i128 sum = numbers::i128(static_cast<int64_t>(lhs)) + numbers::i128(static_cast<uint64_t>(rhs));
+  if (sum < numbers::i128(INT64_MIN) || sum > numbers::i128(INT64_MAX)) {
+    return {};
+  }
+  return numbers::i64(static_cast<int64_t>(static_cast<numbers::int128>(sum)));
+}
+
+}  // namespace
+
+int main() {
+  const auto a = random_values<numbers::i64>(-1000000, 1000000, 1);
+  const auto b = random_values<numbers::u64>(0, 1000000, 2);
+
+  bench::report("i64 + u64, promoted to i128", bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  bench::do_not_optimize(promoted_add(a[k], b[k]));
+                }));
+
+  bench::report("i64 + u64, checked_add", bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  bench::do_not_optimize(numbers::checked_add(a[k], b[k]));
+                }));
+
+  bench::report("u32 * i16, checked_mul", bench::measure(1 << 22, [&](size_t i) {
+                  const size_t k = i % kCount;
+                  bench::do_not_optimize(numbers::checked_mul(numbers::u32(static_cast<uint64_t>(b[k])),
+                                                              numbers::i16(static_cast<int64_t>(a[k]) >> 8)));
+                }));
+  return 0;
+}
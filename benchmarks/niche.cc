@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "niche.hh"
+
+namespace {
+
+// 100M rows, so the std::optional column alone takes 1.6 GB
+constexpr size_t kRows = 100'000'000;
+
+std::vector<numbers::i64> random_column(unsigned seed) {
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<int64_t> dist(-(int64_t{1} << 32), int64_t{1} << 32);
+  std::vector<numbers::i64> values(kRows);
+  for (auto &value : values) {
+    value = numbers::i64(dist(engine));
+  }
+  return values;
+}
+
+template <typename Column, typename Fill>
+void run(const char *name, const std::vector<numbers::i64> &a, Fill fill) {
+  Column column(kRows);
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s checked_mul, per row", name);
+  bench::report(label, bench::measure(1, [&](size_t) {
+                  for (size_t k = 0; k < kRows; ++k) {
+                    column[k] = fill(a[k], a[kRows - 1 - k]);
+                  }
+                  bench::do_not_optimize(column.data());
+                }) / kRows);
+  numbers::i64 sum;
+  std::snprintf(label, sizeof(label), "%s sum, per row", name);
+  bench::report(label, bench::measure(1, [&](size_t) {
+                  sum = numbers::i64(0);
+                  for (size_t k = 0; k < kRows; ++k) {
+                    sum = sum.wrapping_add(column[k].value_or(numbers::i64(0)));
+                  }
+                  bench::do_not_optimize(sum);
+                }) / kRows);
+  std::snprintf(label, sizeof(label), "%s column", name);
+  std::printf("%-48s %10zu MB\n", label, sizeof(column[0]) * kRows >> 20);
+}
+
+}  // namespace
+
+int main() {
+  const auto a = random_column(1);
+  run<std::vector<std::optional<numbers::i64>>>(
+      "std::optional<i64>", a, [](const numbers::i64 &x, const numbers::i64 &y) { return x.checked_mul(y); });
+  run<std::vector<numbers::niche_optional<numbers::i64>>>(
+      "niche_optional<i64>", a,
+      [](const numbers::i64 &x, const numbers::i64 &y) { return numbers::niche_checked_mul(x, y); });
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "internal/traits.hh"
+#include "numbers.h"
+
+// The checked operators in loops that never overflow, where only the compare
+// and the jump to the reporting code should be left, and the cost of one
+// overflow that is thrown and caught.
+
+namespace {
+
+constexpr size_t kCount = 1 << 12;
+
+template <typename N>
+std::vector<N> random_values(unsigned seed, int64_t bound) {
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<int64_t> dist(-bound, bound);
+  std::vector<N> values(kCount);
+  for (auto &value : values) {
+    value = N(static_cast<numbers_internal::raw_type_t<N>>(dist(engine)));
+  }
+  return values;
+}
+
+// Several checked operations per element, each one a call site of its own.
+numbers::i64 polynomial(numbers::i64 x, numbers::i64 a, numbers::i64 b) {
+  return ((x * a + b) * x - a) * numbers::i64(3) + (b - x) / numbers::i64(7);
+}
+
+}  // namespace
+
+int main() {
+  const auto i64s = random_values<numbers::i64>(1, int64_t{1} << 20);
+  const auto i32s = random_values<numbers::i32>(2, 1 << 10);
+  const auto u32s = random_values<numbers::u32>(3, int64_t{1} << 31);
+  std::vector<numbers::u32> small(kCount);
+  for (size_t k = 0; k < kCount; ++k) {
+    small[k] = numbers::u32(static_cast<uint32_t>(static_cast<int64_t>(i32s[k]) + 1024));
+  }
+
+  bench::report("i64 sum with operator+, per element", bench::measure(1 << 10, [&](size_t) {
+                  numbers::i64 sum = 0;
+                  for (const auto &value : i64s) {
+                    sum = sum + value;
+                  }
+                  bench::do_not_optimize(sum);
+                }) / kCount);
+
+  bench::report("i32 a * b - c, per element", bench::measure(1 << 10, [&](size_t) {
+                  numbers::i32 sum = 0;
+                  for (size_t k = 0; k + 2 < kCount; ++k) {
+                    sum = i32s[k] * i32s[k + 1] - i32s[k + 2];
+                    bench::do_not_optimize(sum);
+                  }
+                }) / kCount);
+
+  bench::report("u32 a * b + c, per element", bench::measure(1 << 10, [&](size_t) {
+                  numbers::u32 sum = 0;
+                  for (size_t k = 0; k + 2 < kCount; ++k) {
+                    sum = small[k] * small[k + 1] + u32s[k + 2] / numbers::u32(3);
+                    bench::do_not_optimize(sum);
+                  }
+                }) / kCount);
+
+  bench::report("i64 polynomial of 7 operators, per element", bench::measure(1 << 10, [&](size_t) {
+                  for (size_t k = 0; k + 2 < kCount; ++k) {
+                    numbers::i64 value = polynomial(i64s[k], i64s[k + 1], i64s[k + 2]);
+                    bench::do_not_optimize(value);
+                  }
+                }) / kCount);
+
+  bench::report("i32 overflow thrown and caught", bench::measure(1 << 12, [&](size_t i) {
+                  try {
+                    numbers::i32 value = numbers::i32(2147483647) + i32s[i % kCount].saturating_abs() + numbers::i32(1);
+                    bench::do_not_optimize(value);
+                  } catch (const std::runtime_error &err) {
+                    bench::do_not_optimize(err);
+                  }
+                }));
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "random.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+template <typename Engine>
+void run_engine(const char *name) {
+  Engine engine;
+  bench::report(name, bench::measure(1 << 20, [&](size_t) { bench::do_not_optimize(engine()); }));
+}
+
+}  // namespace
+
+int main() {
+  run_engine<std::mt19937_64>("std::mt19937_64");
+  run_engine<numbers::pcg64>("pcg64");
+  run_engine<numbers::xoshiro256ss>("xoshiro256ss");
+
+  numbers::xoshiro256ss engine(1);
+  std::vector<uint64_t> raw(kCount);
+  std::vector<numbers::u64> values(kCount);
+
+  std::uniform_int_distribution<uint64_t> dist(0, 999999);
+  bench::report("u64 in [0, 1e6), std::uniform_int_distribution", bench::measure(1 << 8, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    raw[k] = dist(engine);
+                  }
+                  bench::do_not_optimize(raw.data());
+                }) / kCount);
+  bench::report("u64 in [0, 1e6), uniform", bench::measure(1 << 8, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    values[k] = numbers::uniform(engine, numbers::u64(0), numbers::u64(999999));
+                  }
+                  bench::do_not_optimize(values.data());
+                }) / kCount);
+  bench::report("u64 in [0, 1e6), fill_uniform", bench::measure(1 << 8, [&](size_t) {
+                  numbers::fill_uniform(engine, values.data(), kCount, numbers::u64(0), numbers::u64(999999));
+                  bench::do_not_optimize(values.data());
+                }) / kCount);
+
+  std::vector<numbers::u128> wide(kCount);
+  const numbers::u128 hi = numbers::u128(numbers::make_uint128(1000, 0));
+  bench::report("u128 in [0, 1000 * 2^64], uniform", bench::measure(1 << 8, [&](size_t) {
+                  for (size_t k = 0; k < kCount; ++k) {
+                    wide[k] = numbers::uniform(engine, numbers::u128(0), hi);
+                  }
+                  bench::do_not_optimize(wide.data());
+                }) / kCount);
+  bench::report("u128 in [0, 1000 * 2^64], fill_uniform", bench::measure(1 << 8, [&](size_t) {
+                  numbers::fill_uniform(engine, wide.data(), kCount, numbers::u128(0), hi);
+                  bench::do_not_optimize(wide.data());
+                }) / kCount);
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "rational.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+using r64 = numbers::rational<numbers::i64>;
+using r128 = numbers::rational<numbers::i128>;
+
+template <typename R, typename I>
+std::vector<R> random_fractions(unsigned seed) {
+  std::mt19937_64 engine(seed);
+  std::uniform_int_distribution<int64_t> num(-1'000'000'000'000, 1'000'000'000'000);
+  std::uniform_int_distribution<int64_t> den(1, 1'000'000'000'000);
+  std::vector<R> values(kCount);
+  for (auto &value : values) {
+    value = R::from(I(num(engine)), I(den(engine)));
+  }
+  return values;
+}
+
+template <typename T, typename Less>
+void run_sort(const char *name, const std::vector<T> &values, Less less) {
+  std::vector<T> work(values.size());
+  bench::report(name, bench::measure(16, [&](size_t) {
+                  std::copy(values.begin(), values.end(), work.begin());
+                  std::sort(work.begin(), work.end(), less);
+                  bench::do_not_optimize(work.data());
+                }) / kCount);
+}
+
+}  // namespace
+
+int main() {
+  const auto r64s = random_fractions<r64, numbers::i64>(1);
+  const auto r128s = random_fractions<r128, numbers::i128>(1);
+
+  // the same values as doubles, which sort quickly but not exactly
+  std::vector<double> doubles(kCount);
+  std::transform(r64s.begin(), r64s.end(), doubles.begin(), [](const r64 &r) { return r.to_double(); });
+  run_sort("sort double, per element", doubles, std::less<double>());
+
+#ifdef __SIZEOF_INT128__
+  struct naive {
+    int64_t num;
+    int64_t den;
+  };
+  std::vector<naive> naives(kCount);
+  std::transform(r64s.begin(), r64s.end(), naives.begin(), [](const r64 &r) {
+    return naive{static_cast<int64_t>(r.numerator()), static_cast<int64_t>(r.denominator())};
+  });
+  run_sort("sort naive __int128 cross product, per element", naives, [](const naive &a, const naive &b) {
+    return static_cast<__int128>(a.num) * b.den < static_cast<__int128>(b.num) * a.den;
+  });
+#endif
+
+  run_sort("sort rational<i64>, per element", r64s, std::less<r64>());
+  run_sort("sort rational<i128>, per element", r128s, std::less<r128>());
+
+  r64 acc;
+  bench::report("rational<i64> add", bench::measure(1 << 16, [&](size_t i) {
+                  acc = r64s[i % kCount].saturating_add(r64s[(i + 1) % kCount]);
+                  bench::do_not_optimize(acc);
+                }));
+  bench::report("rational<i64> mul", bench::measure(1 << 16, [&](size_t i) {
+                  acc = r64s[i % kCount].saturating_mul(r64s[(i + 1) % kCount]);
+                  bench::do_not_optimize(acc);
+                }));
+  r128 wide;
+  bench::report("rational<i128> add", bench::measure(1 << 16, [&](size_t i) {
+                  wide = r128s[i % kCount] + r128s[(i + 1) % kCount];
+                  bench::do_not_optimize(wide);
+                }));
+  bench::report("rational<i128> mul", bench::measure(1 << 16, [&](size_t i) {
+                  wide = r128s[i % kCount] * r128s[(i + 1) % kCount];
+                  bench::do_not_optimize(wide);
+                }));
+  return 0;
+}
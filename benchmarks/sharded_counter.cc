@@ -0,0 +1,54 @@
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "atomic.hh"
+#include "bench/bench.hh"
+#include "sharded_counter.hh"
+
+namespace {
+
+constexpr size_t kOps = 1 << 20;
+
+// Splits kOps calls of `op` over `threads` threads, and returns the wall time per call.
+template <typename F>
+double contended(int threads, F &&op) {
+  return bench::measure(1, [&](size_t) {
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&] {
+        for (size_t i = 0; i < kOps / threads; ++i) {
+          op();
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }) / kOps;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    std::printf("%d threads\n", threads);
+    std::atomic<uint64_t> plain(0);
+    numbers::atomic<numbers::u64> single;
+    numbers::sharded_counter<numbers::u64> per_cpu;
+    numbers::sharded_counter<numbers::u64> per_thread(threads);
+    bench::report("  std::atomic fetch_add", contended(threads, [&] { plain.fetch_add(1, std::memory_order_relaxed); }));
+    bench::report("  atomic fetch_saturating_add",
+                  contended(threads, [&] { single.fetch_saturating_add(numbers::u64(1), std::memory_order_relaxed); }));
+    bench::report("  sharded_counter add, hardware thread shards",
+                  contended(threads, [&] { per_cpu.add(numbers::u64(1)); }));
+    bench::report("  sharded_counter add, one shard per thread",
+                  contended(threads, [&] { per_thread.add(numbers::u64(1)); }));
+    bench::report("  sharded_counter load", bench::measure(1 << 16, [&](size_t) {
+                    bench::do_not_optimize(per_thread.load());
+                  }));
+  }
+  return 0;
+}
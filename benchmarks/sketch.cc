@@ -0,0 +1,60 @@
+#include <string>
+#include <vector>
+
+#include "bench/bench.hh"
+#include "random.hh"
+#include "sketch.hh"
+
+namespace {
+
+constexpr size_t kCount = 1 << 14;
+
+template <typename C>
+void run_count_min(const std::string &name, const std::vector<numbers::u64> &keys) {
+  numbers::count_min<C> sketch(1 << 20, 4);
+  bench::report((name + " add").c_str(), bench::measure(1 << 6, [&](size_t) {
+                  for (const numbers::u64 key : keys) {
+                    sketch.add(key);
+                  }
+                }) / kCount);
+  bench::report((name + " add, batch").c_str(), bench::measure(1 << 6, [&](size_t) {
+                  sketch.add(keys.data(), keys.size());
+                }) / kCount);
+  bench::report((name + " add_conservative, batch").c_str(), bench::measure(1 << 6, [&](size_t) {
+                  sketch.add_conservative(keys.data(), keys.size());
+                }) / kCount);
+  bench::report((name + " estimate").c_str(), bench::measure(1 << 6, [&](size_t) {
+                  for (const numbers::u64 key : keys) {
+                    bench::do_not_optimize(sketch.estimate(key));
+                  }
+                }) / kCount);
+  numbers::count_min<C> other(1 << 20, 4);
+  bench::report((name + " merge, per counter").c_str(),
+                bench::measure(1 << 6, [&](size_t) { sketch.merge(other); }) / (4 << 20));
+}
+
+}  // namespace
+
+int main() {
+  numbers::xoshiro256ss engine(1);
+  std::vector<numbers::u64> keys(kCount);
+  numbers::fill_uniform(engine, keys.data(), kCount, numbers::u64(0), numbers::u64(1 << 20));
+
+  run_count_min<numbers::u8>("count_min<u8>", keys);
+  run_count_min<numbers::u16>("count_min<u16>", keys);
+  run_count_min<numbers::u32>("count_min<u32>", keys);
+
+  numbers::hyperloglog hll(14);
+  bench::report("hyperloglog add", bench::measure(1 << 6, [&](size_t) {
+                  for (const numbers::u64 key : keys) {
+                    hll.add(key);
+                  }
+                }) / kCount);
+  bench::report("hyperloglog add, batch",
+                bench::measure(1 << 6, [&](size_t) { hll.add(keys.data(), keys.size()); }) / kCount);
+  bench::report("hyperloglog estimate", bench::measure(1 << 6, [&](size_t) { bench::do_not_optimize(hll.estimate()); }));
+  numbers::hyperloglog other(14);
+  bench::report("hyperloglog merge, per register",
+                bench::measure(1 << 10, [&](size_t) { hll.merge(other); }) / (1 << 14));
+  return 0;
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Generates a single header from the public headers of numbers.
+
+Every quoted include is replaced by the file it names, once, looked up next to
+the including file first and in the include directory after that, the way the
+compiler resolves them. System includes are kept as they are. The result
+defines NUMBERS_HEADER_ONLY, so the definitions that normally live in the
+library come along as inline functions.
+
+Usage: amalgamate.py <include_dir> <output> <header>...
+"""
+
+import os
+import re
+import sys
+
+INCLUDE = re.compile(r'^\s*#\s*include\s+"([^"]+)"')
+
+
+class Amalgamator:
+    def __init__(self, include_dir):
+        self.include_dir = os.path.abspath(include_dir)
+        self.seen = set()
+        self.lines = []
+
+    def resolve(self, name, current_dir):
+        for base in (current_dir, self.include_dir):
+            path = os.path.normpath(os.path.join(base, name))
+            if os.path.isfile(path):
+                return path
+        raise SystemExit(f"amalgamate: can not find \"{name}\" included from {current_dir}")
+
+    def add(self, path):
+        if path in self.seen:
+            return
+        self.seen.add(path)
+        relative = os.path.relpath(path, self.include_dir).replace(os.sep, "/")
+        self.lines.append(f"// begin {relative}\n")
+        with open(path, encoding="utf-8") as source:
+            for line in source:
+                match = INCLUDE.match(line)
+                if match:
+                    self.add(self.resolve(match.group(1), os.path.dirname(path)))
+                else:
+                    self.lines.append(line if line.endswith("\n") else line + "\n")
+        self.lines.append(f"// end {relative}\n")
+
+
+def main(argv):
+    if len(argv) < 4:
+        raise SystemExit(__doc__)
+    include_dir, output, headers = argv[1], argv[2], argv[3:]
+    amalgamator = Amalgamator(include_dir)
+    for header in headers:
+        amalgamator.add(amalgamator.resolve(header, amalgamator.include_dir))
+
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(output, "w", encoding="utf-8") as out:
+        out.write("// numbers, amalgamated from its public headers by build_support/amalgamate.py\n")
+        out.write("#ifndef NUMBERS_AMALGAMATED_HH\n#define NUMBERS_AMALGAMATED_HH\n\n")
+        out.write("#ifndef NUMBERS_HEADER_ONLY\n#define NUMBERS_HEADER_ONLY\n#endif\n\n")
+        out.writelines(amalgamator.lines)
+        out.write("\n#endif  // NUMBERS_AMALGAMATED_HH\n")
+
+
+if __name__ == "__main__":
+    main(sys.argv)
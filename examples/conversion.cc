@@ -1,4 +1,6 @@
 #include <iostream>
+#include "cast.hh"
+#include "io.hh"
 #include "numbers.h"
 
 int main(int argc, char const *argv[]) {
@@ -15,5 +17,11 @@ int main(int argc, char const *argv[]) {
   b = 345;
   c = static_cast<numbers::i64>(b);
   std::cout << "a = " << a << ", b = " << b << ", c = " << c << '\n';
+
+  // range checked conversions
+  numbers::i64 big = 1'000'000;
+  std::optional<numbers::i16> d = numbers::checked_cast<numbers::i16>(big);
+  numbers::u16 e = numbers::saturating_cast<numbers::u16>(numbers::i32(-5));
+  std::cout << "d has value: " << d.has_value() << ", e = " << e << '\n';
   return 0;
 }
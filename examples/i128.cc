@@ -1,3 +1,5 @@
+#include <iostream>
+#include "io.hh"
 #include "numbers.h"
 
 int main(int argc, char const *argv[]) {
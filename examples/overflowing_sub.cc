@@ -1,6 +1,7 @@
 #include <iostream>
 #include <tuple>
 
+#include "io.hh"
 #include "numbers.h"
 
 void for_error() {
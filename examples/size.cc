@@ -1,3 +1,4 @@
+#include <iostream>
 #include "numbers.h"
 
 int main(int argc, char const *argv[]) {
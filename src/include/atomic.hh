@@ -0,0 +1,433 @@
+#ifndef NUMBERS_ATOMIC_HH
+#define NUMBERS_ATOMIC_HH
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NUMBERS_ATOMIC_CAS16 1
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedCompareExchange128)
+#define NUMBERS_ATOMIC_CAS16 1
+#endif
+
+namespace numbers {
+
+// Atomic integers
+//
+// `atomic<N>` holds one of the aliases i8 ... i128, u8 ... u128 and adds the
+// overflow aware read-modify-write operations to the usual load, store,
+// exchange and compare_exchange. Each fetch_ operation returns the previous
+// value, like std::atomic::fetch_add, and computes the new one with the
+// member of the same name of `N`:
+//
+//   fetch_add(d)              throws numbers::overflow_error instead of overflowing,
+//                             and then leaves the value unchanged
+//   fetch_checked_add(d)      returns std::nullopt instead of overflowing
+//   fetch_overflowing_add(d)  wraps around, and returns whether it did
+//   fetch_saturating_add(d)   clamps to N::MIN or N::MAX
+//   fetch_wrapping_add(d)     wraps around
+//
+// and likewise for sub.
+//
+// The wrapping and overflowing operations are a single atomic add, e.g.
+// `lock xadd` on x86: the overflow is worked out from the previous value
+// afterwards. The checked and saturating operations need to see the previous
+// value before deciding what to store, so they are compare-and-swap loops; a
+// saturating operation that would not change the value, e.g. adding to a
+// counter stuck at N::MAX, returns without writing.
+//
+// atomic<i128> and atomic<u128> are 16-byte aligned. On x86-64 every
+// operation, load included, is a `lock cmpxchg16b` loop, so they are lock
+// free but a load takes the cache line exclusively like a store does. On
+// other targets they fall back to a spin lock inside the object, and
+// is_always_lock_free is false.
+//
+// Example:
+//
+//   numbers::atomic<numbers::u64> requests;
+//   requests.fetch_saturating_add(numbers::u64(1));
+//   if (!bytes.fetch_checked_add(numbers::i64(n))) { ... }
+
+namespace atomic_internal {
+
+template <typename N>
+constexpr bool is_supported_v = numbers_internal::is_numbers_type_v<N>;
+
+// The failure order of a compare-and-swap can not be release or acq_rel.
+constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+  return order == std::memory_order_acq_rel   ? std::memory_order_acquire
+         : order == std::memory_order_release ? std::memory_order_relaxed
+                                              : order;
+}
+
+// The 128-bit cells hold the value as two words, low word first.
+template <typename T>
+constexpr uint64_t low_word(T v) noexcept {
+  if constexpr (std::is_same_v<T, uint128>) {
+    return uint128_low64(v);
+  } else {
+    return int128_low64(v);
+  }
+}
+
+template <typename T>
+constexpr uint64_t high_word(T v) noexcept {
+  if constexpr (std::is_same_v<T, uint128>) {
+    return uint128_high64(v);
+  } else {
+    return static_cast<uint64_t>(int128_high64(v));
+  }
+}
+
+template <typename T>
+T from_words(uint64_t lo, uint64_t hi) noexcept {
+  return T(make_uint128(hi, lo));
+}
+
+// Two's complement addition, which wraps around for int128 too.
+template <typename T>
+T wrapping_add(T lhs, T rhs) noexcept {
+  return T(uint128(lhs) + uint128(rhs));
+}
+
+template <typename T>
+T wrapping_sub(T lhs, T rhs) noexcept {
+  return T(uint128(lhs) - uint128(rhs));
+}
+
+#if defined(NUMBERS_ATOMIC_CAS16)
+
+// Compares the 16 bytes at `p` with `expected`, and replaces them with
+// `desired` if they are equal; otherwise loads them into `expected`. It is a
+// full barrier, whatever memory order is asked for.
+inline bool cas16(uint64_t *p, uint64_t expected[2], const uint64_t desired[2]) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return _InterlockedCompareExchange128(reinterpret_cast<volatile long long *>(p), static_cast<long long>(desired[1]),
+                                        static_cast<long long>(desired[0]),
+                                        reinterpret_cast<long long *>(expected)) != 0;
+#else
+  struct alignas(16) words {
+    uint64_t w[2];
+  };
+  bool ok;
+  __asm__ __volatile__("lock cmpxchg16b %1\n\tsete %0"
+                       : "=q"(ok), "+m"(*reinterpret_cast<words *>(p)), "+a"(expected[0]), "+d"(expected[1])
+                       : "b"(desired[0]), "c"(desired[1])
+                       : "memory", "cc");
+  return ok;
+#endif
+}
+
+// A lock free 128-bit cell built on cmpxchg16b, with the subset of the
+// std::atomic interface atomic<N> uses.
+template <typename T>
+class alignas(16) cas16_cell {
+ public:
+  static constexpr bool is_always_lock_free = true;
+
+  constexpr cas16_cell(T v) noexcept : w_{low_word(v), high_word(v)} {}
+
+  bool is_lock_free() const noexcept { return true; }
+
+  // There is no plain 16-byte atomic load: comparing with 0 and writing 0
+  // back either fails and loads the value, or leaves the 0 that was there.
+  T load(std::memory_order = std::memory_order_seq_cst) const noexcept {
+    uint64_t expected[2] = {0, 0};
+    const uint64_t desired[2] = {0, 0};
+    cas16(w_, expected, desired);
+    return from_words<T>(expected[0], expected[1]);
+  }
+
+  void store(T v, std::memory_order order = std::memory_order_seq_cst) noexcept { exchange(v, order); }
+
+  T exchange(T v, std::memory_order = std::memory_order_seq_cst) noexcept {
+    uint64_t expected[2];
+    guess(expected);
+    const uint64_t desired[2] = {low_word(v), high_word(v)};
+    while (!cas16(w_, expected, desired)) {
+    }
+    return from_words<T>(expected[0], expected[1]);
+  }
+
+  bool compare_exchange_strong(T &expected, T desired, std::memory_order = std::memory_order_seq_cst,
+                               std::memory_order = std::memory_order_seq_cst) noexcept {
+    uint64_t cur[2] = {low_word(expected), high_word(expected)};
+    const uint64_t next[2] = {low_word(desired), high_word(desired)};
+    const bool ok = cas16(w_, cur, next);
+    expected = from_words<T>(cur[0], cur[1]);
+    return ok;
+  }
+
+  bool compare_exchange_weak(T &expected, T desired, std::memory_order success = std::memory_order_seq_cst,
+                             std::memory_order failure = std::memory_order_seq_cst) noexcept {
+    return compare_exchange_strong(expected, desired, success, failure);
+  }
+
+  T fetch_add(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+    uint64_t w[2];
+    guess(w);
+    T cur = from_words<T>(w[0], w[1]);
+    while (!compare_exchange_weak(cur, wrapping_add(cur, delta))) {
+    }
+    return cur;
+  }
+
+  T fetch_sub(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+    uint64_t w[2];
+    guess(w);
+    T cur = from_words<T>(w[0], w[1]);
+    while (!compare_exchange_weak(cur, wrapping_sub(cur, delta))) {
+    }
+    return cur;
+  }
+
+ private:
+  // Reads the two words separately, which may tear. That is good enough for
+  // the expected value of a compare-and-swap: a wrong guess fails and loads
+  // the right value, while a right one saves a cmpxchg16b.
+  void guess(uint64_t w[2]) const noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    w[0] = *static_cast<volatile const uint64_t *>(&w_[0]);
+    w[1] = *static_cast<volatile const uint64_t *>(&w_[1]);
+#else
+    w[0] = __atomic_load_n(&w_[0], __ATOMIC_RELAXED);
+    w[1] = __atomic_load_n(&w_[1], __ATOMIC_RELAXED);
+#endif
+  }
+
+  // a load writes too
+  mutable uint64_t w_[2];
+};
+
+#endif
+
+// The fallback for targets without a 16-byte compare-and-swap: the value is
+// guarded by a spin lock stored next to it.
+template <typename T>
+class alignas(16) locked_cell {
+ public:
+  static constexpr bool is_always_lock_free = false;
+
+  constexpr locked_cell(T v) noexcept : v_(v) {}
+
+  bool is_lock_free() const noexcept { return false; }
+
+  T load(std::memory_order = std::memory_order_seq_cst) const noexcept {
+    guard lock(lock_);
+    return v_;
+  }
+
+  void store(T v, std::memory_order = std::memory_order_seq_cst) noexcept {
+    guard lock(lock_);
+    v_ = v;
+  }
+
+  T exchange(T v, std::memory_order = std::memory_order_seq_cst) noexcept {
+    guard lock(lock_);
+    const T ret = v_;
+    v_ = v;
+    return ret;
+  }
+
+  bool compare_exchange_strong(T &expected, T desired, std::memory_order = std::memory_order_seq_cst,
+                               std::memory_order = std::memory_order_seq_cst) noexcept {
+    guard lock(lock_);
+    if (v_ != expected) {
+      expected = v_;
+      return false;
+    }
+    v_ = desired;
+    return true;
+  }
+
+  bool compare_exchange_weak(T &expected, T desired, std::memory_order success = std::memory_order_seq_cst,
+                             std::memory_order failure = std::memory_order_seq_cst) noexcept {
+    return compare_exchange_strong(expected, desired, success, failure);
+  }
+
+  T fetch_add(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+    guard lock(lock_);
+    const T ret = v_;
+    v_ = wrapping_add(v_, delta);
+    return ret;
+  }
+
+  T fetch_sub(T delta, std::memory_order = std::memory_order_seq_cst) noexcept {
+    guard lock(lock_);
+    const T ret = v_;
+    v_ = wrapping_sub(v_, delta);
+    return ret;
+  }
+
+ private:
+  class guard {
+   public:
+    explicit guard(std::atomic_flag &flag) noexcept : flag_(flag) {
+      while (flag_.test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~guard() { flag_.clear(std::memory_order_release); }
+
+   private:
+    std::atomic_flag &flag_;
+  };
+
+  T v_;
+  mutable std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+};
+
+template <typename T>
+using cell_t = std::conditional_t<(sizeof(T) <= sizeof(uint64_t)), std::atomic<T>,
+#if defined(NUMBERS_ATOMIC_CAS16)
+                                  cas16_cell<T>
+#else
+                                  locked_cell<T>
+#endif
+                                  >;
+
+}  // namespace atomic_internal
+
+template <typename N>
+class atomic {
+  static_assert(atomic_internal::is_supported_v<N>, "atomic needs one of the aliases");
+
+  using raw_type = numbers_internal::raw_type_t<N>;
+
+ public:
+  atomic() noexcept : v_(0) {}
+  constexpr atomic(N v) noexcept : v_(static_cast<raw_type>(v)) {}
+
+  atomic(const atomic &) = delete;
+  atomic &operator=(const atomic &) = delete;
+
+  static constexpr bool is_always_lock_free = atomic_internal::cell_t<raw_type>::is_always_lock_free;
+  bool is_lock_free() const noexcept { return v_.is_lock_free(); }
+
+  N load(std::memory_order order = std::memory_order_seq_cst) const noexcept { return N(v_.load(order)); }
+  void store(N v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    v_.store(static_cast<raw_type>(v), order);
+  }
+  N exchange(N v, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return N(v_.exchange(static_cast<raw_type>(v), order));
+  }
+  operator N() const noexcept { return load(); }
+
+  bool compare_exchange_weak(N &expected, N desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    raw_type raw = static_cast<raw_type>(expected);
+    const bool ret =
+        v_.compare_exchange_weak(raw, static_cast<raw_type>(desired), order, atomic_internal::failure_order(order));
+    expected = N(raw);
+    return ret;
+  }
+
+  bool compare_exchange_strong(N &expected, N desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    raw_type raw = static_cast<raw_type>(expected);
+    const bool ret =
+        v_.compare_exchange_strong(raw, static_cast<raw_type>(desired), order, atomic_internal::failure_order(order));
+    expected = N(raw);
+    return ret;
+  }
+
+  // The value the update gave up on is kept for the error.
+  N fetch_add(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept(false) {
+    N seen;
+    const std::optional<N> ret = update_if(
+        [delta, &seen](N cur) {
+          seen = cur;
+          return cur.checked_add(delta);
+        },
+        order);
+    if (!ret) {
+      overflow_internal::report("add", static_cast<raw_type>(seen), static_cast<raw_type>(delta));
+    }
+    return *ret;
+  }
+
+  N fetch_sub(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept(false) {
+    N seen;
+    const std::optional<N> ret = update_if(
+        [delta, &seen](N cur) {
+          seen = cur;
+          return cur.checked_sub(delta);
+        },
+        order);
+    if (!ret) {
+      overflow_internal::report("sub", static_cast<raw_type>(seen), static_cast<raw_type>(delta));
+    }
+    return *ret;
+  }
+
+  std::optional<N> fetch_checked_add(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update_if([delta](N cur) { return cur.checked_add(delta); }, order);
+  }
+
+  std::optional<N> fetch_checked_sub(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return update_if([delta](N cur) { return cur.checked_sub(delta); }, order);
+  }
+
+  std::tuple<N, bool> fetch_overflowing_add(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    const N prev = fetch_wrapping_add(delta, order);
+    return {prev, std::get<1>(prev.overflowing_add(delta))};
+  }
+
+  std::tuple<N, bool> fetch_overflowing_sub(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    const N prev = fetch_wrapping_sub(delta, order);
+    return {prev, std::get<1>(prev.overflowing_sub(delta))};
+  }
+
+  N fetch_saturating_add(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return *update_if([delta](N cur) { return std::optional<N>(cur.saturating_add(delta)); }, order);
+  }
+
+  N fetch_saturating_sub(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return *update_if([delta](N cur) { return std::optional<N>(cur.saturating_sub(delta)); }, order);
+  }
+
+  // std::atomic arithmetic is defined to wrap around, for signed types too; the 128-bit cells do the same.
+  N fetch_wrapping_add(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return N(v_.fetch_add(static_cast<raw_type>(delta), order));
+  }
+
+  N fetch_wrapping_sub(N delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+    return N(v_.fetch_sub(static_cast<raw_type>(delta), order));
+  }
+
+ private:
+  // Replaces the value by `fn(value)` and returns the previous value, unless
+  // `fn` returns std::nullopt, which is returned as is.
+  template <typename F>
+  std::optional<N> update_if(F &&fn, std::memory_order order) noexcept {
+    // When nothing is written the operation is only a load, ordered like a failed compare-and-swap.
+    const std::memory_order load_order = atomic_internal::failure_order(order);
+    raw_type cur = v_.load(load_order);
+    for (;;) {
+      const std::optional<N> next = fn(N(cur));
+      if (!next) {
+        return {};
+      }
+      if (static_cast<raw_type>(*next) == cur) {
+        return N(cur);
+      }
+      if (v_.compare_exchange_weak(cur, static_cast<raw_type>(*next), order, load_order)) {
+        return N(cur);
+      }
+    }
+  }
+
+  atomic_internal::cell_t<raw_type> v_;
+};
+
+}  // namespace numbers
+
+#endif
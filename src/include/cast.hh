@@ -0,0 +1,175 @@
+#ifndef NUMBERS_CAST_HH
+#define NUMBERS_CAST_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Integer conversions
+//
+// Converts between any two integer types: the numbers aliases (i8 ... i128,
+// u8 ... u128), int128, uint128 and the built-in integers. Unlike the
+// converting constructors and the explicit conversion operators, which wrap
+// around, the conversion is range checked. Whether a check is needed at all is
+// decided at compile time, so a widening conversion costs nothing.
+//
+//   try_from<To>(v)          throws numbers::overflow_error if `v` does not fit `To`
+//   checked_cast<To>(v)      returns std::nullopt if `v` does not fit `To`
+//   overflowing_cast<To>(v)  returns the wrapped value and whether it did not fit
+//   saturating_cast<To>(v)   clamps `v` to the range of `To`
+//   wrapping_cast<To>(v)     keeps the low bits, like static_cast
+//
+// Example:
+//
+//   numbers::i64 big = 1'000'000;
+//   std::optional<numbers::i16> a = numbers::checked_cast<numbers::i16>(big);  // std::nullopt
+//   numbers::u8 b = numbers::saturating_cast<numbers::u8>(numbers::i32(-5));   // 0
+//   numbers::i64 c = numbers::try_from<numbers::i64>(numbers::i32(7));         // never throws
+//
+// The batch variants convert `count` values from `src` into `dst`, using SIMD
+// pack instructions for the 32 to 16 bit and 16 to 8 bit conversions where
+// available.
+//
+//   saturating_cast(src, count, dst)
+//   wrapping_cast(src, count, dst)
+//   checked_cast(src, count, dst)   saturates, and returns false if any value did not fit
+
+namespace cast_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename T>
+constexpr bool is_castable_v = numbers_internal::is_numbers_type_v<T> || numbers_internal::is_integer_v<T>;
+
+template <typename To, typename From>
+using enable_if_castable_t = std::enable_if_t<is_castable_v<To> && is_castable_v<From>>;
+
+template <typename From>
+constexpr raw_type_t<From> raw(From v) noexcept {
+  return static_cast<raw_type_t<From>>(v);
+}
+
+template <typename To, typename From>
+constexpr bool fits(From v) noexcept {
+  return numbers_internal::in_range<raw_type_t<To>>(raw(v));
+}
+
+template <typename To, typename From>
+To wrap(From v) noexcept {
+  return To(static_cast<raw_type_t<To>>(raw(v)));
+}
+
+// SIMD kernels, defined in cast.cc. Each one handles `count` values and
+// returns true if all of them were in range; the stored values are saturated.
+bool saturate_i32_to_i16(const int32_t *src, size_t count, int16_t *dst) noexcept;
+bool saturate_i32_to_u16(const int32_t *src, size_t count, uint16_t *dst) noexcept;
+bool saturate_i16_to_i8(const int16_t *src, size_t count, int8_t *dst) noexcept;
+bool saturate_i16_to_u8(const int16_t *src, size_t count, uint8_t *dst) noexcept;
+
+// The numbers aliases are laid out exactly like their primitive type, so an
+// array of them is handed to the kernels as an array of the primitive type.
+template <typename RawTo, typename RawFrom, typename To, typename From>
+constexpr bool uses_kernel_v = std::is_same_v<raw_type_t<From>, RawFrom> && std::is_same_v<raw_type_t<To>, RawTo> &&
+                               sizeof(From) == sizeof(RawFrom) && sizeof(To) == sizeof(RawTo);
+
+template <typename To, typename From>
+bool saturate(const From *src, size_t count, To *dst) noexcept {
+  if constexpr (uses_kernel_v<int16_t, int32_t, To, From>) {
+    return saturate_i32_to_i16(reinterpret_cast<const int32_t *>(src), count, reinterpret_cast<int16_t *>(dst));
+  } else if constexpr (uses_kernel_v<uint16_t, int32_t, To, From>) {
+    return saturate_i32_to_u16(reinterpret_cast<const int32_t *>(src), count, reinterpret_cast<uint16_t *>(dst));
+  } else if constexpr (uses_kernel_v<int8_t, int16_t, To, From>) {
+    return saturate_i16_to_i8(reinterpret_cast<const int16_t *>(src), count, reinterpret_cast<int8_t *>(dst));
+  } else if constexpr (uses_kernel_v<uint8_t, int16_t, To, From>) {
+    return saturate_i16_to_u8(reinterpret_cast<const int16_t *>(src), count, reinterpret_cast<uint8_t *>(dst));
+  } else {
+    using raw_to = raw_type_t<To>;
+    bool all = true;
+    for (size_t i = 0; i < count; ++i) {
+      const auto v = raw(src[i]);
+      if (numbers_internal::in_range<raw_to>(v)) {
+        dst[i] = To(static_cast<raw_to>(v));
+      } else {
+        all = false;
+        dst[i] = To(numbers_internal::is_below_zero(v) ? std::numeric_limits<raw_to>::min()
+                                                       : std::numeric_limits<raw_to>::max());
+      }
+    }
+    return all;
+  }
+}
+
+}  // namespace cast_internal
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+To try_from(From v) noexcept(false) {
+  if (!cast_internal::fits<To>(v)) {
+    overflow_internal::report_unary("cast", cast_internal::raw(v));
+  }
+  return cast_internal::wrap<To>(v);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+std::optional<To> checked_cast(From v) noexcept {
+  if (!cast_internal::fits<To>(v)) {
+    return {};
+  }
+  return cast_internal::wrap<To>(v);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+std::tuple<To, bool> overflowing_cast(From v) noexcept {
+  return {cast_internal::wrap<To>(v), !cast_internal::fits<To>(v)};
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+To saturating_cast(From v) noexcept {
+  using raw_to = numbers_internal::raw_type_t<To>;
+  if (!cast_internal::fits<To>(v)) {
+    return To(numbers_internal::is_below_zero(cast_internal::raw(v)) ? std::numeric_limits<raw_to>::min()
+                                                                     : std::numeric_limits<raw_to>::max());
+  }
+  return cast_internal::wrap<To>(v);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+To wrapping_cast(From v) noexcept {
+  return cast_internal::wrap<To>(v);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+void saturating_cast(const From *src, size_t count, To *dst) noexcept {
+  cast_internal::saturate(src, count, dst);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+bool checked_cast(const From *src, size_t count, To *dst) noexcept {
+  return cast_internal::saturate(src, count, dst);
+}
+
+template <typename To, typename From, typename = cast_internal::enable_if_castable_t<To, From>>
+void wrapping_cast(const From *src, size_t count, To *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = cast_internal::wrap<To>(src[i]);
+  }
+}
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/cast_impl.hh"
+#endif
+
+#endif
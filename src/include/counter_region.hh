@@ -0,0 +1,96 @@
+#ifndef NUMBERS_COUNTER_REGION_HH
+#define NUMBERS_COUNTER_REGION_HH
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "atomic.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Shared counter regions
+//
+// `counter_region` maps a file, or an anonymous segment, that holds a fixed
+// number of u64 and u128 counters, so that several processes can update and
+// read the same counters. Every slot is a `numbers::atomic`, so writers use
+// its saturating, wrapping or checked fetch operations directly on the shared
+// memory, and a reader only needs the mapping: snapshot() is plain loads and
+// makes no system call.
+//
+//   create(path, u64_slots, u128_slots)  creates the file, or attaches to it if it
+//                                        already holds a region of that layout, so
+//                                        the counters persist across restarts
+//   open(path)                           attaches to an existing region
+//   anonymous(u64_slots, u128_slots)     a region shared with the children forked
+//                                        after it is made
+//
+//   add(i, delta)            saturating add to u64 slot `i`, or u128 slot `i` for a u128 `delta`
+//   u64_slot(i), u128_slot(i) the atomic in slot `i`, for the other operations
+//   snapshot(u64s, u128s)    copies every slot out
+//
+// The layout is a 64-byte header followed by the u64 slots and then the u128
+// slots, starting on a cache line. Slot indices are not checked. The u128
+// slots are lock free on x86-64; elsewhere they fall back to a spin lock in
+// the slot itself, which also works across processes. On a file on /dev/shm
+// the region lives in memory only.
+//
+// Creating a file is not synchronised with other processes creating the same
+// file; one process should create the region and the others open it.
+//
+// Example:
+//
+//   auto region = numbers::counter_region::create("/dev/shm/workers", 16, 2);
+//   region.add(kRequests, numbers::u64(1));
+//   region.u128_slot(kBytes).fetch_wrapping_add(numbers::u128(size));
+
+class counter_region {
+ public:
+  static counter_region create(const std::string &path, size_t u64_slots, size_t u128_slots) noexcept(false);
+  static counter_region open(const std::string &path) noexcept(false);
+  static counter_region anonymous(size_t u64_slots, size_t u128_slots) noexcept(false);
+
+  counter_region(counter_region &&other) noexcept;
+  counter_region &operator=(counter_region &&other) noexcept;
+  counter_region(const counter_region &) = delete;
+  counter_region &operator=(const counter_region &) = delete;
+  ~counter_region();
+
+  size_t u64_slots() const noexcept { return u64_slots_; }
+  size_t u128_slots() const noexcept { return u128_slots_; }
+
+  atomic<u64> &u64_slot(size_t i) const noexcept { return u64_[i]; }
+  atomic<u128> &u128_slot(size_t i) const noexcept { return u128_[i]; }
+
+  void add(size_t i, u64 delta) const noexcept { u64_[i].fetch_saturating_add(delta, std::memory_order_relaxed); }
+  void add(size_t i, u128 delta) const noexcept { u128_[i].fetch_saturating_add(delta, std::memory_order_relaxed); }
+
+  // Each slot is read atomically, but the slots are not read at one instant.
+  void snapshot(u64 *u64_dst, u128 *u128_dst) const noexcept {
+    for (size_t i = 0; i < u64_slots_; ++i) {
+      u64_dst[i] = u64_[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < u128_slots_; ++i) {
+      u128_dst[i] = u128_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  counter_region(void *base, size_t size, size_t u64_slots, size_t u128_slots) noexcept;
+
+  void *base_;
+  size_t size_;
+  size_t u64_slots_;
+  size_t u128_slots_;
+  atomic<u64> *u64_;
+  atomic<u128> *u128_;
+};
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/counter_region_impl.hh"
+#endif
+
+#endif
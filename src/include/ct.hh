@@ -0,0 +1,198 @@
+#ifndef NUMBERS_CT_HH
+#define NUMBERS_CT_HH
+
+#include <limits>
+
+#include "integer.hh"
+#include "internal/config.h"
+#include "internal/traits.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Checked arithmetic for constants
+//
+// `numbers::ct::add`, `sub`, `mul` and `shl` compute a numbers integer and
+// stop the compilation when the result does not fit, if they are evaluated at
+// compile time:
+//
+//   constexpr numbers::u32 kHeaderSize = numbers::ct::mul(kFieldCount, numbers::u32(4));
+//   constexpr numbers::u64 kWindow = numbers::ct::shl(numbers::u64(1), 40);
+//   constexpr numbers::i8 kBad = numbers::ct::add(numbers::i8(100), numbers::i8(100));  // does not compile
+//
+// The error names the failing operation, e.g. "call to non-constexpr function
+// numbers::ct_internal::add_overflows_in_constant_expression(...)".
+//
+// At run time add, sub and mul take the checked_ members, and an overflow
+// throws numbers::overflow_error with the operands and the location of the
+// call. shl(a, amount) overflows when amount is not in [0, bits) or when a
+// bit, including the sign, would be shifted out.
+
+namespace ct_internal {
+
+// Not constexpr on purpose: reaching one during constant evaluation is the
+// compile error, and its name is the diagnostic.
+template <typename R>
+[[noreturn]] void add_overflows_in_constant_expression(R a, R b, source_location location) {
+  overflow_internal::report_at("add", a, b, location);
+}
+
+template <typename R>
+[[noreturn]] void sub_overflows_in_constant_expression(R a, R b, source_location location) {
+  overflow_internal::report_at("sub", a, b, location);
+}
+
+template <typename R>
+[[noreturn]] void mul_overflows_in_constant_expression(R a, R b, source_location location) {
+  overflow_internal::report_at("mul", a, b, location);
+}
+
+template <typename R>
+[[noreturn]] void shl_overflows_in_constant_expression(R a, int amount, source_location location) {
+  overflow_internal::report_at("shl", a, amount, location);
+}
+
+// The overflow tests below compare against the limits instead of looking at
+// the wrapped result, since signed overflow is not a constant expression.
+template <typename R>
+constexpr bool add_overflows(R a, R b) noexcept {
+  constexpr R kMin = std::numeric_limits<R>::min();
+  constexpr R kMax = std::numeric_limits<R>::max();
+  if constexpr (std::numeric_limits<R>::is_signed) {
+    return b > 0 ? a > kMax - b : a < kMin - b;
+  } else {
+    return a > kMax - b;
+  }
+}
+
+template <typename R>
+constexpr bool sub_overflows(R a, R b) noexcept {
+  constexpr R kMin = std::numeric_limits<R>::min();
+  constexpr R kMax = std::numeric_limits<R>::max();
+  if constexpr (std::numeric_limits<R>::is_signed) {
+    return b > 0 ? a < kMin + b : a > kMax + b;
+  } else {
+    return a < b;
+  }
+}
+
+template <typename R>
+constexpr bool mul_overflows(R a, R b) noexcept {
+  constexpr R kMin = std::numeric_limits<R>::min();
+  constexpr R kMax = std::numeric_limits<R>::max();
+  if constexpr (std::numeric_limits<R>::is_signed) {
+    if (a > 0) {
+      return b > 0 ? a > kMax / b : b < kMin / a;
+    }
+    if (b > 0) {
+      return a < kMin / b;
+    }
+    return a != 0 && b < kMax / a;
+  } else {
+    return b != 0 && a > kMax / b;
+  }
+}
+
+template <typename R>
+constexpr bool shl_overflows(R a, int amount) noexcept {
+  constexpr int kBits = std::numeric_limits<R>::digits + std::numeric_limits<R>::is_signed;
+  if (amount < 0 || amount >= kBits) {
+    return true;
+  }
+  if constexpr (std::numeric_limits<R>::is_signed) {
+    if (a < 0) {
+      return a < static_cast<R>(std::numeric_limits<R>::min() >> amount);
+    }
+  }
+  return a > static_cast<R>(std::numeric_limits<R>::max() >> amount);
+}
+
+}  // namespace ct_internal
+
+namespace ct {
+
+template <typename T>
+constexpr T add(T a, numbers_internal::type_identity_t<T> b,
+                source_location location = source_location::current()) noexcept(false) {
+  static_assert(numbers_internal::is_numbers_type_v<T>, "ct::add takes numbers integer types");
+  using raw_type = numbers_internal::raw_type_t<T>;
+  const auto lhs = static_cast<raw_type>(a);
+  const auto rhs = static_cast<raw_type>(b);
+#ifdef NUMBERS_IS_CONSTANT_EVALUATED
+  if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+    if (const auto sum = a.checked_add(b)) {
+      return *sum;
+    }
+    overflow_internal::report_at("add", lhs, rhs, location);
+  }
+#endif
+  if (ct_internal::add_overflows(lhs, rhs)) {
+    ct_internal::add_overflows_in_constant_expression(lhs, rhs, location);
+  }
+  return a.wrapping_add(b);
+}
+
+template <typename T>
+constexpr T sub(T a, numbers_internal::type_identity_t<T> b,
+                source_location location = source_location::current()) noexcept(false) {
+  static_assert(numbers_internal::is_numbers_type_v<T>, "ct::sub takes numbers integer types");
+  using raw_type = numbers_internal::raw_type_t<T>;
+  const auto lhs = static_cast<raw_type>(a);
+  const auto rhs = static_cast<raw_type>(b);
+#ifdef NUMBERS_IS_CONSTANT_EVALUATED
+  if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+    if (const auto difference = a.checked_sub(b)) {
+      return *difference;
+    }
+    overflow_internal::report_at("sub", lhs, rhs, location);
+  }
+#endif
+  if (ct_internal::sub_overflows(lhs, rhs)) {
+    ct_internal::sub_overflows_in_constant_expression(lhs, rhs, location);
+  }
+  return a.wrapping_sub(b);
+}
+
+template <typename T>
+constexpr T mul(T a, numbers_internal::type_identity_t<T> b,
+                source_location location = source_location::current()) noexcept(false) {
+  static_assert(numbers_internal::is_numbers_type_v<T>, "ct::mul takes numbers integer types");
+  using raw_type = numbers_internal::raw_type_t<T>;
+  const auto lhs = static_cast<raw_type>(a);
+  const auto rhs = static_cast<raw_type>(b);
+#ifdef NUMBERS_IS_CONSTANT_EVALUATED
+  if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+    if (const auto product = a.checked_mul(b)) {
+      return *product;
+    }
+    overflow_internal::report_at("mul", lhs, rhs, location);
+  }
+#endif
+  if (ct_internal::mul_overflows(lhs, rhs)) {
+    ct_internal::mul_overflows_in_constant_expression(lhs, rhs, location);
+  }
+  return a.wrapping_mul(b);
+}
+
+template <typename T>
+constexpr T shl(T a, int amount, source_location location = source_location::current()) noexcept(false) {
+  static_assert(numbers_internal::is_numbers_type_v<T>, "ct::shl takes numbers integer types");
+  using raw_type = numbers_internal::raw_type_t<T>;
+  const auto raw = static_cast<raw_type>(a);
+  if (ct_internal::shl_overflows(raw, amount)) {
+    ct_internal::shl_overflows_in_constant_expression(raw, amount, location);
+  }
+  if (amount == 0) {
+    return a;
+  }
+  // Shifting by one less and doubling keeps every step in range, also for
+  // negative values, which may not be shifted left before C++20.
+  return T(static_cast<raw_type>(raw * static_cast<raw_type>(raw_type{1} << (amount - 1)) * 2));
+}
+
+}  // namespace ct
+
+}  // namespace numbers
+
+#endif
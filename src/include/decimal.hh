@@ -0,0 +1,553 @@
+#ifndef NUMBERS_DECIMAL_HH
+#define NUMBERS_DECIMAL_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/divide.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+
+namespace numbers {
+
+// Decimal fixed point
+//
+// `decimal<Storage, Scale>` is a count of 10^-Scale units held in `Storage`,
+// i64 or i128, e.g. decimal<i64, 4> holds amounts of money to a hundredth of
+// a cent exactly. decimal64<Scale> and decimal128<Scale> are shorthands for the
+// two storages. The scale is at most 18 for i64 and 38 for i128.
+//
+// Like the integer aliases, every operation comes in the flavours
+//
+//   a + b, a - b, a * b, a / b          throw numbers::overflow_error on overflow
+//   checked_add(b) ...                  std::nullopt on overflow
+//   overflowing_add(b) ...              the wrapped result and whether it overflowed
+//   saturating_add(b) ...               clamps to the smallest or largest value
+//
+// Multiplication and division round the exact result to the scale, to the
+// nearest with ties to even (banker's rounding) by default, or with ties away
+// from zero for rounding::half_up. Dividing by zero is an overflow.
+//
+//   rescale<S>(mode)        the value at scale S, rounded when S < Scale
+//   parse(text, mode)       "-12.345" to a decimal, rounding extra digits, or
+//                           std::nullopt if it is not a number or out of range
+//   to_chars(first, last)   writes the shortest text with exactly Scale
+//                           fractional digits, like std::to_chars
+//
+// Scaling divides by powers of ten from a table, with precomputed
+// reciprocals instead of a division instruction, and products of i128
+// values are formed in 256 bits, so no intermediate result overflows. Parsing
+// and formatting do not allocate.
+//
+// Example:
+//
+//   using money = numbers::decimal64<4>;
+//   money price = *money::parse("19.99");
+//   money total = price * money::from_integer(numbers::i64(3));  // 59.9700
+//   char buf[money::kMaxChars];
+//   char *end = total.to_chars(buf, buf + sizeof(buf));
+
+enum class rounding { half_even, half_up };
+
+namespace decimal_internal {
+
+using numbers_internal::raw_type_t;
+using magnitude = numbers_internal::magnitude256;
+using numbers_internal::divide;
+using numbers_internal::divide_words;
+using numbers_internal::multiply;
+
+// 10^k and the reciprocal of 10^k shifted left until its top bit is set, as
+// used by the division below: (2^128 - 1) / (10^k << shift) - 2^64.
+struct pow10_reciprocal {
+  uint64_t divisor;
+  int shift;
+  uint64_t inverse;
+};
+
+inline constexpr pow10_reciprocal kPow10Reciprocal[20] = {
+    {0x0000000000000001ull, 63, 0xffffffffffffffffull},  // 10^0
+    {0x000000000000000aull, 60, 0x9999999999999999ull},  // 10^1
+    {0x0000000000000064ull, 57, 0x47ae147ae147ae14ull},  // 10^2
+    {0x00000000000003e8ull, 54, 0x0624dd2f1a9fbe76ull},  // 10^3
+    {0x0000000000002710ull, 50, 0xa36e2eb1c432ca57ull},  // 10^4
+    {0x00000000000186a0ull, 47, 0x4f8b588e368f0846ull},  // 10^5
+    {0x00000000000f4240ull, 44, 0x0c6f7a0b5ed8d36bull},  // 10^6
+    {0x0000000000989680ull, 40, 0xad7f29abcaf48578ull},  // 10^7
+    {0x0000000005f5e100ull, 37, 0x5798ee2308c39df9ull},  // 10^8
+    {0x000000003b9aca00ull, 34, 0x12e0be826d694b2eull},  // 10^9
+    {0x00000002540be400ull, 30, 0xb7cdfd9d7bdbab7dull},  // 10^10
+    {0x000000174876e800ull, 27, 0x5fd7fe17964955fdull},  // 10^11
+    {0x000000e8d4a51000ull, 24, 0x19799812dea11197ull},  // 10^12
+    {0x000009184e72a000ull, 20, 0xc25c268497681c26ull},  // 10^13
+    {0x00005af3107a4000ull, 17, 0x6849b86a12b9b01eull},  // 10^14
+    {0x00038d7ea4c68000ull, 14, 0x203af9ee756159b2ull},  // 10^15
+    {0x002386f26fc10000ull, 10, 0xcd2b297d889bc2b6ull},  // 10^16
+    {0x016345785d8a0000ull, 7, 0x70ef54646d496892ull},   // 10^17
+    {0x0de0b6b3a7640000ull, 4, 0x2725dd1d243aba0eull},   // 10^18
+    {0x8ac7230489e80000ull, 0, 0xd83c94fb6d2ac34aull},   // 10^19
+};
+
+inline constexpr uint128 kPow10[39] = {
+    make_uint128(0x0000000000000000ull, 0x0000000000000001ull),  // 10^0
+    make_uint128(0x0000000000000000ull, 0x000000000000000aull),  // 10^1
+    make_uint128(0x0000000000000000ull, 0x0000000000000064ull),  // 10^2
+    make_uint128(0x0000000000000000ull, 0x00000000000003e8ull),  // 10^3
+    make_uint128(0x0000000000000000ull, 0x0000000000002710ull),  // 10^4
+    make_uint128(0x0000000000000000ull, 0x00000000000186a0ull),  // 10^5
+    make_uint128(0x0000000000000000ull, 0x00000000000f4240ull),  // 10^6
+    make_uint128(0x0000000000000000ull, 0x0000000000989680ull),  // 10^7
+    make_uint128(0x0000000000000000ull, 0x0000000005f5e100ull),  // 10^8
+    make_uint128(0x0000000000000000ull, 0x000000003b9aca00ull),  // 10^9
+    make_uint128(0x0000000000000000ull, 0x00000002540be400ull),  // 10^10
+    make_uint128(0x0000000000000000ull, 0x000000174876e800ull),  // 10^11
+    make_uint128(0x0000000000000000ull, 0x000000e8d4a51000ull),  // 10^12
+    make_uint128(0x0000000000000000ull, 0x000009184e72a000ull),  // 10^13
+    make_uint128(0x0000000000000000ull, 0x00005af3107a4000ull),  // 10^14
+    make_uint128(0x0000000000000000ull, 0x00038d7ea4c68000ull),  // 10^15
+    make_uint128(0x0000000000000000ull, 0x002386f26fc10000ull),  // 10^16
+    make_uint128(0x0000000000000000ull, 0x016345785d8a0000ull),  // 10^17
+    make_uint128(0x0000000000000000ull, 0x0de0b6b3a7640000ull),  // 10^18
+    make_uint128(0x0000000000000000ull, 0x8ac7230489e80000ull),  // 10^19
+    make_uint128(0x0000000000000005ull, 0x6bc75e2d63100000ull),  // 10^20
+    make_uint128(0x0000000000000036ull, 0x35c9adc5dea00000ull),  // 10^21
+    make_uint128(0x000000000000021eull, 0x19e0c9bab2400000ull),  // 10^22
+    make_uint128(0x000000000000152dull, 0x02c7e14af6800000ull),  // 10^23
+    make_uint128(0x000000000000d3c2ull, 0x1bcecceda1000000ull),  // 10^24
+    make_uint128(0x0000000000084595ull, 0x161401484a000000ull),  // 10^25
+    make_uint128(0x000000000052b7d2ull, 0xdcc80cd2e4000000ull),  // 10^26
+    make_uint128(0x00000000033b2e3cull, 0x9fd0803ce8000000ull),  // 10^27
+    make_uint128(0x00000000204fce5eull, 0x3e25026110000000ull),  // 10^28
+    make_uint128(0x00000001431e0faeull, 0x6d7217caa0000000ull),  // 10^29
+    make_uint128(0x0000000c9f2c9cd0ull, 0x4674edea40000000ull),  // 10^30
+    make_uint128(0x0000007e37be2022ull, 0xc0914b2680000000ull),  // 10^31
+    make_uint128(0x000004ee2d6d415bull, 0x85acef8100000000ull),  // 10^32
+    make_uint128(0x0000314dc6448d93ull, 0x38c15b0a00000000ull),  // 10^33
+    make_uint128(0x0001ed09bead87c0ull, 0x378d8e6400000000ull),  // 10^34
+    make_uint128(0x0013426172c74d82ull, 0x2b878fe800000000ull),  // 10^35
+    make_uint128(0x00c097ce7bc90715ull, 0xb34b9f1000000000ull),  // 10^36
+    make_uint128(0x0785ee10d5da46d9ull, 0x00f436a000000000ull),  // 10^37
+    make_uint128(0x4b3b4ca85a86c47aull, 0x098a224000000000ull),  // 10^38
+};
+
+// Divides `m` in place by 10^k, k <= 38, and returns the remainder.
+inline uint128 divide_pow10(magnitude &m, int k) noexcept {
+  if (k <= 19) {
+    const pow10_reciprocal &p = kPow10Reciprocal[k];
+    return divide_words(m, p.divisor, p.shift, p.inverse);
+  }
+  const pow10_reciprocal &lo = kPow10Reciprocal[19];
+  const pow10_reciprocal &hi = kPow10Reciprocal[k - 19];
+  const uint64_t r1 = divide_words(m, lo.divisor, lo.shift, lo.inverse);
+  const uint64_t r2 = divide_words(m, hi.divisor, hi.shift, hi.inverse);
+  return uint128(r2) * lo.divisor + r1;
+}
+
+// Whether a quotient should be rounded away from zero, given its remainder.
+inline bool round_away(uint128 remainder, uint128 divisor, bool odd, rounding mode) noexcept {
+  const uint128 rest = divisor - remainder;
+  if (remainder != rest) {
+    return remainder > rest;
+  }
+  return mode == rounding::half_up || odd;
+}
+
+inline void increment(magnitude &m) noexcept {
+  for (uint64_t &w : m.w) {
+    if (++w != 0) {
+      break;
+    }
+  }
+}
+
+template <typename T>
+magnitude magnitude_of(T v) noexcept {
+  if constexpr (std::is_same_v<T, int128>) {
+    const uint128 u = v < 0 ? uint128(0) - uint128(v) : uint128(v);
+    return {{uint128_low64(u), uint128_high64(u), 0, 0}};
+  } else {
+    const uint64_t u = v < 0 ? uint64_t{0} - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    return {{u, 0, 0, 0}};
+  }
+}
+
+// Stores the two's complement of `m`, negated if `negative`, truncated to `T`,
+// and returns true if it did not fit.
+template <typename T>
+bool to_signed(const magnitude &m, bool negative, T &ret) noexcept {
+  constexpr int kWords = sizeof(T) / sizeof(uint64_t);
+  const uint64_t top = m.w[kWords - 1];
+  bool overflow = (kWords == 1 ? (m.w[1] | m.w[2] | m.w[3]) : (m.w[2] | m.w[3])) != 0;
+  if ((top >> 63) != 0) {
+    // only -2^(N-1) has its top bit set
+    const bool is_min = top == (uint64_t{1} << 63) && (kWords == 1 || m.w[0] == 0);
+    overflow = overflow || !(negative && is_min);
+  }
+  if constexpr (std::is_same_v<T, int128>) {
+    uint128 u = make_uint128(m.w[1], m.w[0]);
+    u = negative ? uint128(0) - u : u;
+    ret = make_int128(int128_internal::BitCastToSigned(uint128_high64(u)), uint128_low64(u));
+  } else {
+    const uint64_t u = negative ? uint64_t{0} - m.w[0] : m.w[0];
+    ret = static_cast<T>(u);
+  }
+  return overflow;
+}
+
+// a * b / 10^scale, rounded.
+template <typename T>
+bool multiply_scaled(T a, T b, int scale, rounding mode, T &ret) noexcept {
+  const bool negative = (a < 0) != (b < 0);
+  magnitude m;
+  if constexpr (std::is_same_v<T, int128>) {
+    m = multiply(magnitude_of(a), magnitude_of(b));
+  } else {
+    const uint128 p = uint128(magnitude_of(a).w[0]) * magnitude_of(b).w[0];
+    m = {{uint128_low64(p), uint128_high64(p), 0, 0}};
+  }
+  const uint128 remainder = divide_pow10(m, scale);
+  if (round_away(remainder, kPow10[scale], m.w[0] & 1, mode)) {
+    increment(m);
+  }
+  return to_signed(m, negative, ret);
+}
+
+// a * 10^scale / b for b != 0, rounded.
+template <typename T>
+bool divide_scaled(T a, T b, int scale, rounding mode, T &ret) noexcept {
+  const bool negative = (a < 0) != (b < 0);
+  magnitude m = multiply(magnitude_of(a), {{uint128_low64(kPow10[scale]), uint128_high64(kPow10[scale]), 0, 0}});
+  const magnitude d = magnitude_of(b);
+  const uint128 divisor = make_uint128(d.w[1], d.w[0]);
+  const uint128 remainder = divide(m, divisor);
+  if (round_away(remainder, divisor, m.w[0] & 1, mode)) {
+    increment(m);
+  }
+  return to_signed(m, negative, ret);
+}
+
+// v * 10^up or v / 10^down, rounded.
+template <typename T>
+bool rescale(T v, int from, int to, rounding mode, T &ret) noexcept {
+  const bool negative = v < 0;
+  magnitude m = magnitude_of(v);
+  if (to >= from) {
+    m = multiply(m, {{uint128_low64(kPow10[to - from]), uint128_high64(kPow10[to - from]), 0, 0}});
+  } else {
+    const uint128 remainder = divide_pow10(m, from - to);
+    if (round_away(remainder, kPow10[from - to], m.w[0] & 1, mode)) {
+      increment(m);
+    }
+  }
+  return to_signed(m, negative, ret);
+}
+
+template <typename T>
+constexpr int kMaxScale = std::is_same_v<T, int128> ? 38 : 18;
+
+}  // namespace decimal_internal
+
+template <typename Storage, int Scale>
+class decimal {
+  static_assert(std::is_same_v<Storage, i64> || std::is_same_v<Storage, i128>, "decimal storage is i64 or i128");
+
+  using raw_type = numbers_internal::raw_type_t<Storage>;
+
+  static_assert(Scale >= 0 && Scale <= decimal_internal::kMaxScale<raw_type>, "decimal scale out of range");
+
+ public:
+  static constexpr int scale = Scale;
+  // The longest text to_chars writes: a sign, 39 digits, a point and a leading zero.
+  static constexpr size_t kMaxChars = 42;
+
+  constexpr decimal() noexcept : units_(0) {}
+
+  static constexpr decimal from_units(Storage units) noexcept { return decimal(static_cast<raw_type>(units)); }
+
+  static std::optional<decimal> checked_from_integer(Storage whole) noexcept {
+    raw_type ret;
+    if (decimal_internal::rescale(static_cast<raw_type>(whole), 0, Scale, rounding::half_even, ret)) {
+      return {};
+    }
+    return decimal(ret);
+  }
+
+  static decimal from_integer(Storage whole) noexcept(false) {
+    const std::optional<decimal> ret = checked_from_integer(whole);
+    if (!ret) {
+      overflow_internal::report("mul", static_cast<raw_type>(whole), decimal_internal::kPow10[Scale]);
+    }
+    return *ret;
+  }
+
+  inline static const decimal MIN = decimal(std::numeric_limits<raw_type>::min());
+  inline static const decimal MAX = decimal(std::numeric_limits<raw_type>::max());
+
+  // The count of 10^-Scale units.
+  constexpr Storage units() const noexcept { return Storage(units_); }
+
+  // The integer part, truncated toward zero.
+  Storage integer_part() const noexcept {
+    decimal_internal::magnitude m = decimal_internal::magnitude_of(units_);
+    decimal_internal::divide_pow10(m, Scale);
+    raw_type ret;
+    decimal_internal::to_signed(m, units_ < 0, ret);
+    return Storage(ret);
+  }
+
+  double to_double() const noexcept {
+    return static_cast<double>(units_) / static_cast<double>(decimal_internal::kPow10[Scale]);
+  }
+
+  decimal operator+(const decimal &other) const noexcept(false) {
+    return decimal(static_cast<raw_type>(Storage(units_) + Storage(other.units_)));
+  }
+  std::optional<decimal> checked_add(const decimal &other) const noexcept {
+    return from_checked(Storage(units_).checked_add(Storage(other.units_)));
+  }
+  std::tuple<decimal, bool> overflowing_add(const decimal &other) const noexcept {
+    return from_overflowing(Storage(units_).overflowing_add(Storage(other.units_)));
+  }
+  decimal saturating_add(const decimal &other) const noexcept {
+    return decimal(static_cast<raw_type>(Storage(units_).saturating_add(Storage(other.units_))));
+  }
+
+  decimal operator-(const decimal &other) const noexcept(false) {
+    return decimal(static_cast<raw_type>(Storage(units_) - Storage(other.units_)));
+  }
+  std::optional<decimal> checked_sub(const decimal &other) const noexcept {
+    return from_checked(Storage(units_).checked_sub(Storage(other.units_)));
+  }
+  std::tuple<decimal, bool> overflowing_sub(const decimal &other) const noexcept {
+    return from_overflowing(Storage(units_).overflowing_sub(Storage(other.units_)));
+  }
+  decimal saturating_sub(const decimal &other) const noexcept {
+    return decimal(static_cast<raw_type>(Storage(units_).saturating_sub(Storage(other.units_))));
+  }
+
+  decimal operator-() const noexcept(false) { return decimal(static_cast<raw_type>(-Storage(units_))); }
+
+  decimal operator*(const decimal &other) const noexcept(false) { return mul(other, rounding::half_even); }
+  decimal mul(const decimal &other, rounding mode) const noexcept(false) {
+    const auto [ret, overflow] = overflowing_mul(other, mode);
+    if (overflow) {
+      overflow_internal::report("mul", units_, other.units_);
+    }
+    return ret;
+  }
+  std::optional<decimal> checked_mul(const decimal &other, rounding mode = rounding::half_even) const noexcept {
+    return checked(overflowing_mul(other, mode));
+  }
+  std::tuple<decimal, bool> overflowing_mul(const decimal &other,
+                                            rounding mode = rounding::half_even) const noexcept {
+    raw_type ret;
+    const bool overflow = decimal_internal::multiply_scaled(units_, other.units_, Scale, mode, ret);
+    return {decimal(ret), overflow};
+  }
+  decimal saturating_mul(const decimal &other, rounding mode = rounding::half_even) const noexcept {
+    const auto [ret, overflow] = overflowing_mul(other, mode);
+    return overflow ? clamp((units_ < 0) != (other.units_ < 0)) : ret;
+  }
+
+  decimal operator/(const decimal &other) const noexcept(false) { return div(other, rounding::half_even); }
+  decimal div(const decimal &other, rounding mode) const noexcept(false) {
+    const auto [ret, overflow] = overflowing_div(other, mode);
+    if (overflow) {
+      overflow_internal::report("div", units_, other.units_);
+    }
+    return ret;
+  }
+  std::optional<decimal> checked_div(const decimal &other, rounding mode = rounding::half_even) const noexcept {
+    return checked(overflowing_div(other, mode));
+  }
+  // Dividing by zero gives zero and an overflow.
+  std::tuple<decimal, bool> overflowing_div(const decimal &other,
+                                            rounding mode = rounding::half_even) const noexcept {
+    if (other.units_ == 0) {
+      return {decimal(), true};
+    }
+    raw_type ret;
+    const bool overflow = decimal_internal::divide_scaled(units_, other.units_, Scale, mode, ret);
+    return {decimal(ret), overflow};
+  }
+  // Dividing zero by zero gives zero.
+  decimal saturating_div(const decimal &other, rounding mode = rounding::half_even) const noexcept {
+    if (other.units_ == 0) {
+      return units_ == 0 ? decimal() : clamp(units_ < 0);
+    }
+    const auto [ret, overflow] = overflowing_div(other, mode);
+    return overflow ? clamp((units_ < 0) != (other.units_ < 0)) : ret;
+  }
+
+  template <int To>
+  std::optional<decimal<Storage, To>> checked_rescale(rounding mode = rounding::half_even) const noexcept {
+    static_assert(To >= 0 && To <= decimal_internal::kMaxScale<raw_type>, "decimal scale out of range");
+    raw_type ret;
+    if (decimal_internal::rescale(units_, Scale, To, mode, ret)) {
+      return {};
+    }
+    return decimal<Storage, To>::from_units(Storage(ret));
+  }
+
+  template <int To>
+  decimal<Storage, To> rescale(rounding mode = rounding::half_even) const noexcept(false) {
+    const std::optional<decimal<Storage, To>> ret = checked_rescale<To>(mode);
+    if (!ret) {
+      // only scaling up overflows
+      overflow_internal::report("mul", units_, decimal_internal::kPow10[To > Scale ? To - Scale : 0]);
+    }
+    return *ret;
+  }
+
+  // An optional sign, digits with an optional point, and nothing else. Digits
+  // past the scale are rounded with `mode`.
+  static std::optional<decimal> parse(std::string_view text, rounding mode = rounding::half_even) noexcept {
+    size_t i = 0;
+    const bool negative = i < text.size() && text[i] == '-';
+    i += i < text.size() && (text[i] == '-' || text[i] == '+');
+
+    // the magnitude in units, and the count of digits after the point consumed
+    uint128 units = 0;
+    int fraction = -1;
+    int first_dropped = -1;
+    bool sticky = false;
+    bool any_digit = false;
+    for (; i < text.size(); ++i) {
+      const char c = text[i];
+      if (c == '.' && fraction < 0) {
+        fraction = 0;
+        continue;
+      }
+      if (c < '0' || c > '9') {
+        return {};
+      }
+      any_digit = true;
+      const int digit = c - '0';
+      if (fraction >= Scale) {
+        if (first_dropped < 0) {
+          first_dropped = digit;
+        } else {
+          sticky = sticky || digit != 0;
+        }
+        continue;
+      }
+      // 10 * units + digit must stay below 2^128, and 2^128 - 1 = 10 * kMaxOver10 + 5
+      constexpr uint128 kMaxOver10 = make_uint128(0x1999999999999999ull, 0x9999999999999999ull);
+      if (units > kMaxOver10 || (units == kMaxOver10 && digit > 5)) {
+        return {};
+      }
+      units = units * 10 + digit;
+      fraction += fraction >= 0;
+    }
+    if (!any_digit) {
+      return {};
+    }
+
+    // the trailing zeros of the fraction
+    const uint128 zeros = decimal_internal::kPow10[Scale - (fraction < 0 ? 0 : fraction)];
+    decimal_internal::magnitude m = decimal_internal::multiply(
+        {{uint128_low64(units), uint128_high64(units), 0, 0}}, {{uint128_low64(zeros), uint128_high64(zeros), 0, 0}});
+    if (first_dropped >= 0) {
+      const bool half = first_dropped == 5 && !sticky;
+      const bool up = first_dropped > 5 || (first_dropped == 5 && sticky) ||
+                      (half && (mode == rounding::half_up || (m.w[0] & 1) != 0));
+      if (up) {
+        decimal_internal::increment(m);
+      }
+    }
+    raw_type ret;
+    if (decimal_internal::to_signed(m, negative, ret)) {
+      return {};
+    }
+    return decimal(ret);
+  }
+
+  // Writes the value with exactly Scale fractional digits and returns the end
+  // of the text, or nullptr if it does not fit in [first, last).
+  char *to_chars(char *first, char *last) const noexcept {
+    // the digits, least significant first, 19 at a time
+    char digits[40];
+    int n = 0;
+    decimal_internal::magnitude m = decimal_internal::magnitude_of(units_);
+    while ((m.w[0] | m.w[1]) != 0) {
+      uint64_t chunk = static_cast<uint64_t>(decimal_internal::divide_pow10(m, 19));
+      const bool last_chunk = (m.w[0] | m.w[1]) == 0;
+      for (int k = 0; k < 19 && !(last_chunk && chunk == 0); ++k) {
+        digits[n++] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+      }
+    }
+    while (n <= Scale) {
+      digits[n++] = '0';
+    }
+
+    const size_t size = (units_ < 0) + static_cast<size_t>(n) + (Scale > 0);
+    if (static_cast<size_t>(last - first) < size) {
+      return nullptr;
+    }
+    char *p = first;
+    if (units_ < 0) {
+      *p++ = '-';
+    }
+    for (int k = n - 1; k >= 0; --k) {
+      *p++ = digits[k];
+      if (k == Scale && Scale > 0) {
+        *p++ = '.';
+      }
+    }
+    return p;
+  }
+
+  std::string to_string() const {
+    char buf[kMaxChars];
+    return std::string(buf, to_chars(buf, buf + kMaxChars));
+  }
+
+  friend bool operator==(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ == rhs.units_; }
+  friend bool operator!=(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ != rhs.units_; }
+  friend bool operator<(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ < rhs.units_; }
+  friend bool operator<=(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ <= rhs.units_; }
+  friend bool operator>(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ > rhs.units_; }
+  friend bool operator>=(const decimal &lhs, const decimal &rhs) noexcept { return lhs.units_ >= rhs.units_; }
+
+ private:
+  constexpr explicit decimal(raw_type units) noexcept : units_(units) {}
+
+  static decimal clamp(bool negative) noexcept { return negative ? MIN : MAX; }
+
+  static std::optional<decimal> from_checked(const std::optional<Storage> &v) noexcept {
+    if (!v) {
+      return {};
+    }
+    return decimal(static_cast<raw_type>(*v));
+  }
+  static std::tuple<decimal, bool> from_overflowing(const std::tuple<Storage, bool> &v) noexcept {
+    return {decimal(static_cast<raw_type>(std::get<0>(v))), std::get<1>(v)};
+  }
+  static std::optional<decimal> checked(const std::tuple<decimal, bool> &v) noexcept {
+    if (std::get<1>(v)) {
+      return {};
+    }
+    return std::get<0>(v);
+  }
+
+  raw_type units_;
+};
+
+template <int Scale>
+using decimal64 = decimal<i64, Scale>;
+
+template <int Scale>
+using decimal128 = decimal<i128, Scale>;
+
+}  // namespace numbers
+
+#endif
@@ -0,0 +1,438 @@
+#ifndef NUMBERS_DURATION_HH
+#define NUMBERS_DURATION_HH
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ratio>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/divide.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+
+namespace numbers {
+
+// Durations and timestamps
+//
+// `duration_ns` is a length of time and `timestamp_ns` a point in time since
+// some clock's epoch, both in i64 nanoseconds, which reach about 292 years
+// either way. `duration_ps` and `timestamp_ps` count i128 picoseconds instead.
+// They are basic_duration<IntT, Period> and basic_timestamp<IntT, Period>.
+//
+// Deadline arithmetic saturates. MAX stands for "never" and MIN for "long
+// ago", so `now + duration_ns::MAX` is timestamp_ns::MAX rather than a time in
+// the past as with std::chrono. The operators saturate, the checked_ variants
+// return std::nullopt instead, and division by zero throws a "div"
+// numbers::overflow_error.
+//
+//   seconds(n), milliseconds(n) ...  n in that unit, saturating
+//   count()                          the number of ticks
+//   count_as<std::milli>()           the number of whole milliseconds,
+//                                    truncated toward zero like duration_cast
+//   from_chrono(d), to_chrono()      from and to std::chrono durations and
+//                                    time points, truncated toward zero and
+//                                    saturating
+//
+// A std::chrono duration or a basic_duration whose period is a whole number
+// of ticks converts implicitly, so `deadline + std::chrono::seconds(5)` and
+// `duration_ps(d_ns)` work. When the periods
+// match, a conversion is a copy of the count. Scaling to a coarser unit
+// divides by a constant: counts below 2^64 use the compiler's
+// multiply-and-shift, and wider ones divide word by word with a reciprocal
+// computed at compile time.
+//
+// Example:
+//
+//   using namespace std::chrono_literals;
+//   auto now = numbers::timestamp_ns::now<std::chrono::steady_clock>();
+//   numbers::timestamp_ns deadline = now + timeout;  // timeout MAX gives MAX
+//   numbers::duration_ns left = deadline - now;
+//   if (left <= 0ms) { ... }
+
+namespace duration_internal {
+
+using numbers_internal::magnitude256;
+
+// |v| and whether v is negative, for integers of up to 128 bits.
+template <typename T>
+constexpr uint128 magnitude(T v, bool &negative) noexcept {
+  if constexpr (std::numeric_limits<T>::is_signed) {
+    negative = v < 0;
+    return negative ? uint128(0) - uint128(v) : uint128(v);
+  } else {
+    negative = false;
+    return uint128(v);
+  }
+}
+
+// The value of T nearest to m or -m.
+template <typename T>
+constexpr T clamp(bool negative, uint128 m) noexcept {
+  const uint128 max = uint128(std::numeric_limits<T>::max());
+  if (!negative) {
+    return m > max ? std::numeric_limits<T>::max() : static_cast<T>(m);
+  }
+  if constexpr (std::numeric_limits<T>::is_signed) {
+    return m > max + 1 ? std::numeric_limits<T>::min() : static_cast<T>(uint128(0) - m);
+  } else {
+    return T(0);
+  }
+}
+
+constexpr int leading_zeros(uint64_t d) noexcept {
+  int n = 0;
+  for (; (d >> 63) == 0; d <<= 1) {
+    ++n;
+  }
+  return n;
+}
+
+// (2^128 - 1) / d - 2^64 for `d` with its top bit set, as
+// numbers_internal::reciprocal computes it, but a bit at a time so that it is
+// a constant expression. The dividend is ~d:~0.
+constexpr uint64_t constant_reciprocal(uint64_t d) noexcept {
+  uint64_t r = ~d;
+  uint64_t q = 0;
+  for (int i = 0; i < 64; ++i) {
+    const bool carry = (r >> 63) != 0;
+    r = (r << 1) | 1;
+    q <<= 1;
+    if (carry || r >= d) {
+      r -= d;
+      q |= 1;
+    }
+  }
+  return q;
+}
+
+template <uint64_t D>
+struct constant_divisor {
+  static constexpr int shift = leading_zeros(D);
+  static constexpr uint64_t inverse = constant_reciprocal(D << shift);
+};
+
+// count * Ratio, truncated toward zero and clamped to the range of T. The
+// product is formed in 256 bits, so only the result can saturate.
+template <typename T, typename Ratio, typename From>
+constexpr T scale(From count) noexcept {
+  static_assert(std::numeric_limits<From>::is_integer, "durations convert from integer counts");
+  if constexpr (Ratio::num == 1 && std::is_integral_v<From> && std::numeric_limits<From>::is_signed &&
+                std::numeric_limits<T>::digits >= std::numeric_limits<From>::digits) {
+    // the quotient of a machine integer always fits
+    if constexpr (static_cast<uintmax_t>(Ratio::den) > static_cast<uintmax_t>(std::numeric_limits<From>::max())) {
+      return T(0);
+    } else {
+      return static_cast<T>(count / static_cast<From>(Ratio::den));
+    }
+  }
+  bool negative = false;
+  const uint128 m = magnitude(count, negative);
+  if constexpr (Ratio::num == 1 && Ratio::den == 1) {
+    return clamp<T>(negative, m);
+  } else {
+    magnitude256 w{{uint128_low64(m), uint128_high64(m), 0, 0}};
+    if constexpr (Ratio::num != 1) {
+      constexpr uint64_t num = Ratio::num;
+      if (w.w[1] == 0) {
+        const uint128 p = uint128(w.w[0]) * num;
+        w = {{uint128_low64(p), uint128_high64(p), 0, 0}};
+      } else {
+        w = numbers_internal::multiply(w, {{num, 0, 0, 0}});
+      }
+    }
+    if constexpr (Ratio::den != 1) {
+      constexpr uint64_t den = Ratio::den;
+      if ((w.w[1] | w.w[2] | w.w[3]) == 0) {
+        w.w[0] /= den;
+      } else {
+        numbers_internal::divide_words(w, den, constant_divisor<den>::shift, constant_divisor<den>::inverse);
+      }
+    }
+    if ((w.w[2] | w.w[3]) != 0) {
+      return clamp<T>(negative, ~uint128(0));
+    }
+    return clamp<T>(negative, make_uint128(w.w[1], w.w[0]));
+  }
+}
+
+// a / b for b != 0, truncated toward zero and clamped, so MIN / -1 is MAX.
+// 128-bit counts divide through the 64-bit words rather than a bit at a time.
+template <typename T>
+T quotient(T a, T b) noexcept {
+  if constexpr (sizeof(T) <= sizeof(uint64_t)) {
+    if (b == -1) {
+      return a == std::numeric_limits<T>::min() ? std::numeric_limits<T>::max() : -a;
+    }
+    return a / b;
+  } else {
+    bool a_negative = false;
+    bool b_negative = false;
+    const uint128 ma = magnitude(a, a_negative);
+    const uint128 mb = magnitude(b, b_negative);
+    magnitude256 w{{uint128_low64(ma), uint128_high64(ma), 0, 0}};
+    numbers_internal::divide(w, mb);
+    return clamp<T>(a_negative != b_negative, make_uint128(w.w[1], w.w[0]));
+  }
+}
+
+}  // namespace duration_internal
+
+template <typename IntT, typename Period>
+class basic_timestamp;
+
+template <typename IntT, typename Period>
+class basic_duration {
+  static_assert(std::is_same_v<IntT, i64> || std::is_same_v<IntT, i128>, "duration storage is i64 or i128");
+
+  using raw_type = numbers_internal::raw_type_t<IntT>;
+
+  // Whether a tick of period P is a whole number of ticks of this one.
+  template <typename P>
+  static constexpr bool is_exact_v = std::ratio_divide<P, Period>::den == 1;
+
+  static constexpr basic_duration from_raw(raw_type ticks) noexcept {
+    basic_duration d;
+    d.ticks_ = ticks;
+    return d;
+  }
+
+ public:
+  using rep = IntT;
+  using period = Period;
+
+  constexpr basic_duration() noexcept : ticks_(0) {}
+  constexpr explicit basic_duration(IntT ticks) noexcept : ticks_(static_cast<raw_type>(ticks)) {}
+
+  // A std::chrono duration of a whole number of ticks, saturating.
+  template <typename Rep, typename P, typename = std::enable_if_t<is_exact_v<P>>>
+  constexpr basic_duration(const std::chrono::duration<Rep, P> &d) noexcept
+      : ticks_(duration_internal::scale<raw_type, std::ratio_divide<P, Period>>(d.count())) {}
+
+  // A duration of another period that is a whole number of ticks, saturating.
+  template <typename OtherIntT, typename P, typename = std::enable_if_t<is_exact_v<P>>>
+  basic_duration(const basic_duration<OtherIntT, P> &d) noexcept
+      : ticks_(duration_internal::scale<raw_type, std::ratio_divide<P, Period>>(
+            static_cast<numbers_internal::raw_type_t<OtherIntT>>(d.count()))) {}
+
+  // Any std::chrono duration with an integer count, truncated toward zero and saturating.
+  template <typename Rep, typename P>
+  static constexpr basic_duration from_chrono(const std::chrono::duration<Rep, P> &d) noexcept {
+    return from_count<P>(d.count());
+  }
+
+  static basic_duration nanoseconds(IntT n) noexcept { return from_count<std::nano>(static_cast<raw_type>(n)); }
+  static basic_duration microseconds(IntT n) noexcept { return from_count<std::micro>(static_cast<raw_type>(n)); }
+  static basic_duration milliseconds(IntT n) noexcept { return from_count<std::milli>(static_cast<raw_type>(n)); }
+  static basic_duration seconds(IntT n) noexcept { return from_count<std::ratio<1>>(static_cast<raw_type>(n)); }
+  static basic_duration minutes(IntT n) noexcept { return from_count<std::ratio<60>>(static_cast<raw_type>(n)); }
+  static basic_duration hours(IntT n) noexcept { return from_count<std::ratio<3600>>(static_cast<raw_type>(n)); }
+
+  inline static const basic_duration MIN = from_raw(std::numeric_limits<raw_type>::min());
+  inline static const basic_duration MAX = from_raw(std::numeric_limits<raw_type>::max());
+
+  IntT count() const noexcept { return IntT(ticks_); }
+
+  // The count in units of P, truncated toward zero and saturating.
+  template <typename P>
+  IntT count_as() const noexcept {
+    return IntT(duration_internal::scale<raw_type, std::ratio_divide<Period, P>>(ticks_));
+  }
+
+  // As a std::chrono duration, truncated toward zero and saturating. By
+  // default the count is int64_t ticks of this period, so for duration_ns it
+  // is std::chrono::nanoseconds.
+  template <typename ToDuration = std::chrono::duration<int64_t, Period>>
+  constexpr ToDuration to_chrono() const noexcept {
+    using rep_type = typename ToDuration::rep;
+    using ratio = std::ratio_divide<Period, typename ToDuration::period>;
+    return ToDuration(duration_internal::scale<rep_type, ratio>(ticks_));
+  }
+
+  basic_duration operator+(const basic_duration &other) const noexcept { return saturating_add(other); }
+  std::optional<basic_duration> checked_add(const basic_duration &other) const noexcept {
+    return from_checked(count().checked_add(other.count()));
+  }
+  basic_duration saturating_add(const basic_duration &other) const noexcept {
+    return basic_duration(count().saturating_add(other.count()));
+  }
+
+  basic_duration operator-(const basic_duration &other) const noexcept { return saturating_sub(other); }
+  std::optional<basic_duration> checked_sub(const basic_duration &other) const noexcept {
+    return from_checked(count().checked_sub(other.count()));
+  }
+  basic_duration saturating_sub(const basic_duration &other) const noexcept {
+    return basic_duration(count().saturating_sub(other.count()));
+  }
+
+  basic_duration operator-() const noexcept { return basic_duration(count().saturating_neg()); }
+
+  basic_duration operator*(const IntT &n) const noexcept { return saturating_mul(n); }
+  friend basic_duration operator*(const IntT &n, const basic_duration &d) noexcept { return d.saturating_mul(n); }
+  std::optional<basic_duration> checked_mul(const IntT &n) const noexcept {
+    return from_checked(count().checked_mul(n));
+  }
+  basic_duration saturating_mul(const IntT &n) const noexcept { return basic_duration(count().saturating_mul(n)); }
+
+  basic_duration operator/(const IntT &n) const noexcept(false) {
+    const raw_type d = static_cast<raw_type>(n);
+    if (d == 0) {
+      overflow_internal::report("div", ticks_, d);
+    }
+    return from_raw(duration_internal::quotient(ticks_, d));
+  }
+  std::optional<basic_duration> checked_div(const IntT &n) const noexcept {
+    const raw_type d = static_cast<raw_type>(n);
+    if (d == 0 || (d == -1 && ticks_ == std::numeric_limits<raw_type>::min())) {
+      return {};
+    }
+    return from_raw(duration_internal::quotient(ticks_, d));
+  }
+
+  // How many times `other` fits, truncated toward zero.
+  IntT operator/(const basic_duration &other) const noexcept(false) {
+    if (other.ticks_ == 0) {
+      overflow_internal::report("div", ticks_, other.ticks_);
+    }
+    return IntT(duration_internal::quotient(ticks_, other.ticks_));
+  }
+
+  basic_duration &operator+=(const basic_duration &other) noexcept { return *this = *this + other; }
+  basic_duration &operator-=(const basic_duration &other) noexcept { return *this = *this - other; }
+
+  friend constexpr bool operator==(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ == rhs.ticks_;
+  }
+  friend constexpr bool operator!=(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ != rhs.ticks_;
+  }
+  friend constexpr bool operator<(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ < rhs.ticks_;
+  }
+  friend constexpr bool operator<=(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ <= rhs.ticks_;
+  }
+  friend constexpr bool operator>(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ > rhs.ticks_;
+  }
+  friend constexpr bool operator>=(const basic_duration &lhs, const basic_duration &rhs) noexcept {
+    return lhs.ticks_ >= rhs.ticks_;
+  }
+
+ private:
+  friend class basic_timestamp<IntT, Period>;
+
+  template <typename P, typename Rep>
+  static constexpr basic_duration from_count(Rep n) noexcept {
+    return from_raw(duration_internal::scale<raw_type, std::ratio_divide<P, Period>>(n));
+  }
+
+  static std::optional<basic_duration> from_checked(const std::optional<IntT> &ticks) noexcept {
+    if (!ticks) {
+      return {};
+    }
+    return basic_duration(*ticks);
+  }
+
+  raw_type ticks_;
+};
+
+template <typename IntT, typename Period>
+class basic_timestamp {
+  using raw_type = numbers_internal::raw_type_t<IntT>;
+
+ public:
+  using duration = basic_duration<IntT, Period>;
+  using rep = IntT;
+  using period = Period;
+
+  // The epoch.
+  constexpr basic_timestamp() noexcept = default;
+
+  static constexpr basic_timestamp from_epoch(const duration &since) noexcept { return basic_timestamp(since); }
+
+  // A std::chrono time point, truncated toward zero and saturating.
+  template <typename Clock, typename Dur>
+  static constexpr basic_timestamp from_chrono(const std::chrono::time_point<Clock, Dur> &t) noexcept {
+    return basic_timestamp(duration::from_chrono(t.time_since_epoch()));
+  }
+
+  template <typename Clock>
+  static basic_timestamp now() noexcept(noexcept(Clock::now())) {
+    return from_chrono(Clock::now());
+  }
+
+  inline static const basic_timestamp MIN = basic_timestamp(duration::from_raw(std::numeric_limits<raw_type>::min()));
+  inline static const basic_timestamp MAX = basic_timestamp(duration::from_raw(std::numeric_limits<raw_type>::max()));
+
+  constexpr duration since_epoch() const noexcept { return since_; }
+
+  // As a time point of `Clock`, truncated toward zero and saturating.
+  template <typename Clock, typename ToDuration = std::chrono::duration<int64_t, Period>>
+  constexpr std::chrono::time_point<Clock, ToDuration> to_chrono() const noexcept {
+    return std::chrono::time_point<Clock, ToDuration>(since_.template to_chrono<ToDuration>());
+  }
+
+  basic_timestamp operator+(const duration &d) const noexcept { return basic_timestamp(since_ + d); }
+  friend basic_timestamp operator+(const duration &d, const basic_timestamp &t) noexcept { return t + d; }
+  std::optional<basic_timestamp> checked_add(const duration &d) const noexcept {
+    return from_checked(since_.checked_add(d));
+  }
+
+  basic_timestamp operator-(const duration &d) const noexcept { return basic_timestamp(since_ - d); }
+  std::optional<basic_timestamp> checked_sub(const duration &d) const noexcept {
+    return from_checked(since_.checked_sub(d));
+  }
+
+  // The time from `other` to this, saturating.
+  duration operator-(const basic_timestamp &other) const noexcept { return since_ - other.since_; }
+  std::optional<duration> checked_sub(const basic_timestamp &other) const noexcept {
+    return since_.checked_sub(other.since_);
+  }
+
+  basic_timestamp &operator+=(const duration &d) noexcept { return *this = *this + d; }
+  basic_timestamp &operator-=(const duration &d) noexcept { return *this = *this - d; }
+
+  friend constexpr bool operator==(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ == rhs.since_;
+  }
+  friend constexpr bool operator!=(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ != rhs.since_;
+  }
+  friend constexpr bool operator<(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ < rhs.since_;
+  }
+  friend constexpr bool operator<=(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ <= rhs.since_;
+  }
+  friend constexpr bool operator>(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ > rhs.since_;
+  }
+  friend constexpr bool operator>=(const basic_timestamp &lhs, const basic_timestamp &rhs) noexcept {
+    return lhs.since_ >= rhs.since_;
+  }
+
+ private:
+  constexpr explicit basic_timestamp(const duration &since) noexcept : since_(since) {}
+
+  static std::optional<basic_timestamp> from_checked(const std::optional<duration> &since) noexcept {
+    if (!since) {
+      return {};
+    }
+    return basic_timestamp(*since);
+  }
+
+  duration since_;
+};
+
+using duration_ns = basic_duration<i64, std::nano>;
+using timestamp_ns = basic_timestamp<i64, std::nano>;
+using duration_ps = basic_duration<i128, std::pico>;
+using timestamp_ps = basic_timestamp<i128, std::pico>;
+
+}  // namespace numbers
+
+#endif
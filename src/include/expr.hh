@@ -0,0 +1,437 @@
+#ifndef NUMBERS_EXPR_HH
+#define NUMBERS_EXPR_HH
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/config.h"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "internal/wide.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Lazy checked expressions
+//
+// `numbers::expr(a) * b + c - d` builds an expression tree instead of
+// evaluating each operator eagerly. The tree carries a compile-time bound on
+// the magnitude of every intermediate value, which selects the narrowest of
+// int64_t, int128 or a 256-bit integer that can hold all of them exactly. The
+// whole expression is evaluated once in that type and only the final result is
+// range checked, so intermediate overflow that cancels out is not reported.
+// When the result does not fit, value() throws the numbers::overflow_error of
+// the first operator that overflows when they are applied one at a time.
+//
+// Every numbers operand of an expression must share the same type; built-in
+// integer operands adopt it. Expressions whose bound exceeds 256 bits fall back
+// to checking each step in the 256-bit domain.
+//
+// Example:
+//
+//   numbers::i32 ret = numbers::expr(a) * b + c - d;  // throws on overflow
+//   std::optional<numbers::i32> maybe = (numbers::expr(a) * b + c - d).checked();
+
+namespace expr_internal {
+
+using numbers_internal::is_numbers_type;
+using numbers_internal::raw_type_t;
+
+// An upper bound of |value| for every value of `T`, as a power of two.
+template <typename T>
+constexpr double magnitude_bound() {
+  double bound = 1.0;
+  for (int i = 0; i < std::numeric_limits<raw_type_t<T>>::digits; ++i) {
+    bound *= 2.0;
+  }
+  return bound;
+}
+
+constexpr double power_of_two(int exponent) {
+  double ret = 1.0;
+  for (int i = 0; i < exponent; ++i) {
+    ret *= 2.0;
+  }
+  return ret;
+}
+
+// Rounding up the bound after every operation keeps it a true upper bound
+// despite the rounding of double arithmetic.
+constexpr double round_up(double bound) { return bound * (1.0 + 1.0 / power_of_two(50)); }
+
+// The common numbers type of two operands; `void` stands for a built-in integer.
+template <typename L, typename R>
+struct common_value {
+  static_assert(std::is_void_v<L> || std::is_void_v<R> || std::is_same_v<L, R>,
+                "all numbers operands of an expression must have the same type");
+  using type = std::conditional_t<std::is_void_v<L>, R, L>;
+};
+
+template <typename W, typename T>
+W widen(T v) {
+  if constexpr (std::is_same_v<W, numbers_internal::int256>) {
+    return numbers_internal::int256::from(v);
+  } else {
+    return static_cast<W>(v);
+  }
+}
+
+struct add_op {
+  template <typename W>
+  static W apply(const W &lhs, const W &rhs) {
+    return lhs + rhs;
+  }
+
+  static bool apply_checked(const numbers_internal::int256 &lhs, const numbers_internal::int256 &rhs,
+                            numbers_internal::int256 &ret) {
+    return numbers_internal::int256::overflowing_add(lhs, rhs, ret);
+  }
+
+  static constexpr double bound(double lhs, double rhs) { return round_up(lhs + rhs); }
+};
+
+struct sub_op {
+  template <typename W>
+  static W apply(const W &lhs, const W &rhs) {
+    return lhs - rhs;
+  }
+
+  static bool apply_checked(const numbers_internal::int256 &lhs, const numbers_internal::int256 &rhs,
+                            numbers_internal::int256 &ret) {
+    return numbers_internal::int256::overflowing_sub(lhs, rhs, ret);
+  }
+
+  static constexpr double bound(double lhs, double rhs) { return round_up(lhs + rhs); }
+};
+
+struct mul_op {
+  template <typename W>
+  static W apply(const W &lhs, const W &rhs) {
+    return lhs * rhs;
+  }
+
+  static bool apply_checked(const numbers_internal::int256 &lhs, const numbers_internal::int256 &rhs,
+                            numbers_internal::int256 &ret) {
+    return numbers_internal::int256::overflowing_mul(lhs, rhs, ret);
+  }
+
+  static constexpr double bound(double lhs, double rhs) { return round_up(lhs * rhs); }
+};
+
+// Evaluates `e` one operator at a time with the throwing operators of its
+// value type, which report the first step that overflows. Only called once
+// the whole result is known not to fit.
+template <typename E>
+NUMBERS_COLD NUMBERS_NOINLINE typename E::value_type evaluate_stepwise(const E &e) {
+  return e.template step<typename E::value_type>();
+}
+
+}  // namespace expr_internal
+
+// Every expression node derives from `expression`, which holds the public
+// evaluation interface.
+struct expression_tag {};
+
+template <typename T>
+struct is_expression : std::is_base_of<expression_tag, T> {};
+
+template <typename T>
+constexpr bool is_expression_v = is_expression<T>::value;
+
+namespace expr_internal {
+
+// Picks the evaluation domain of an expression from its bound and performs the
+// final range check against the result type.
+template <typename E>
+struct evaluation {
+  using value_type = typename E::value_type;
+  static_assert(!std::is_void_v<value_type>, "an expression needs at least one numbers operand");
+  using raw = raw_type_t<value_type>;
+
+  static constexpr bool needs_checked = !(E::bound < power_of_two(255));
+
+  using wide_domain = std::conditional_t<(E::bound < power_of_two(127)), int128, numbers_internal::int256>;
+  using domain = std::conditional_t<(E::bound < power_of_two(63)), int64_t, wide_domain>;
+
+  template <typename W>
+  static bool fits(const W &val) {
+    if constexpr (std::is_same_v<W, numbers_internal::int256>) {
+      return val.template fits<raw>();
+    } else if constexpr (std::is_same_v<raw, uint64_t>) {
+      return !(val < 0) && uint128(val) <= uint128(std::numeric_limits<raw>::max());
+    } else {
+      return !(val < W(std::numeric_limits<raw>::min())) && !(W(std::numeric_limits<raw>::max()) < val);
+    }
+  }
+
+  template <typename W>
+  static raw truncate(const W &val) {
+    if constexpr (std::is_same_v<W, numbers_internal::int256>) {
+      return val.template truncate<raw>();
+    } else if constexpr (std::is_same_v<raw, uint128> || std::is_same_v<raw, int128>) {
+      return static_cast<raw>(val);
+    } else {
+      return static_cast<raw>(static_cast<uint64_t>(val));
+    }
+  }
+
+  template <typename W>
+  static bool is_negative(const W &val) {
+    if constexpr (std::is_same_v<W, numbers_internal::int256>) {
+      return val.is_negative();
+    } else {
+      return val < 0;
+    }
+  }
+};
+
+}  // namespace expr_internal
+
+template <typename Derived>
+class expression : public expression_tag {
+ public:
+  // checked()
+  //
+  // Evaluates the expression, returning `std::nullopt` if the result does not
+  // fit into the result type.
+  template <typename D = Derived>
+  std::optional<typename D::value_type> checked() const {
+    using Eval = expr_internal::evaluation<D>;
+    using V = typename Eval::value_type;
+    if constexpr (Eval::needs_checked) {
+      numbers_internal::int256 val;
+      if (self().eval_checked(val) || !Eval::fits(val)) {
+        return {};
+      }
+      return V(Eval::truncate(val));
+    } else {
+      const auto val = self().template eval<typename Eval::domain>();
+      if (!Eval::fits(val)) {
+        return {};
+      }
+      return V(Eval::truncate(val));
+    }
+  }
+
+  // overflowing()
+  //
+  // Returns a tuple of the wrapped result and a boolean indicating whether the
+  // result does not fit into the result type.
+  template <typename D = Derived>
+  std::tuple<typename D::value_type, bool> overflowing() const {
+    using Eval = expr_internal::evaluation<D>;
+    using V = typename Eval::value_type;
+    if constexpr (Eval::needs_checked) {
+      numbers_internal::int256 val;
+      const bool overflow = self().eval_checked(val);
+      return {V(Eval::truncate(val)), overflow || !Eval::fits(val)};
+    } else {
+      const auto val = self().template eval<typename Eval::domain>();
+      return {V(Eval::truncate(val)), !Eval::fits(val)};
+    }
+  }
+
+  // saturating()
+  //
+  // Returns the result clamped to the bounds of the result type. Only
+  // available when the expression is evaluated exactly.
+  template <typename D = Derived>
+  typename D::value_type saturating() const {
+    using Eval = expr_internal::evaluation<D>;
+    using V = typename Eval::value_type;
+    static_assert(!Eval::needs_checked, "expression too wide to saturate, split it into smaller expressions");
+    const auto val = self().template eval<typename Eval::domain>();
+    if (Eval::fits(val)) {
+      return V(Eval::truncate(val));
+    }
+    return Eval::is_negative(val) ? V::MIN : V::MAX;
+  }
+
+  // wrapping()
+  //
+  // Returns the result wrapped around at the boundary of the result type.
+  template <typename D = Derived>
+  typename D::value_type wrapping() const {
+    return std::get<0>(overflowing());
+  }
+
+  // value()
+  //
+  // Returns the result, throwing if it does not fit into the result type.
+  template <typename D = Derived>
+  typename D::value_type value() const noexcept(false) {
+    auto ret = checked();
+    if (!ret) {
+      return expr_internal::evaluate_stepwise(self());
+    }
+    return *ret;
+  }
+
+  template <typename V, typename D = Derived, typename = std::enable_if_t<std::is_same_v<V, typename D::value_type>>>
+  operator V() const noexcept(false) {
+    return value();
+  }
+
+ private:
+  const Derived &self() const noexcept { return static_cast<const Derived &>(*this); }
+};
+
+// An operand of an expression: a numbers integer or a built-in integer.
+template <typename T>
+class expr_leaf : public expression<expr_leaf<T>> {
+ public:
+  using value_type = std::conditional_t<expr_internal::is_numbers_type<T>::value, T, void>;
+  static constexpr double bound = expr_internal::magnitude_bound<T>();
+
+  constexpr explicit expr_leaf(T value) noexcept : value_{value} {}
+
+  template <typename W>
+  W eval() const {
+    return expr_internal::widen<W>(static_cast<expr_internal::raw_type_t<T>>(value_));
+  }
+
+  bool eval_checked(numbers_internal::int256 &ret) const {
+    ret = eval<numbers_internal::int256>();
+    return false;
+  }
+
+  template <typename V>
+  V step() const {
+    using raw = expr_internal::raw_type_t<V>;
+    if constexpr (!expr_internal::is_numbers_type<T>::value) {
+      if (!numbers_internal::in_range<raw>(value_)) {
+        overflow_internal::report_unary("cast", value_);
+      }
+    }
+    return V(static_cast<raw>(value_));
+  }
+
+ private:
+  T value_;
+};
+
+template <typename Op, typename L, typename R>
+class expr_binary : public expression<expr_binary<Op, L, R>> {
+ public:
+  using value_type = typename expr_internal::common_value<typename L::value_type, typename R::value_type>::type;
+  static constexpr double bound = Op::bound(L::bound, R::bound);
+
+  constexpr expr_binary(const L &lhs, const R &rhs) noexcept : lhs_{lhs}, rhs_{rhs} {}
+
+  template <typename W>
+  W eval() const {
+    return Op::apply(lhs_.template eval<W>(), rhs_.template eval<W>());
+  }
+
+  bool eval_checked(numbers_internal::int256 &ret) const {
+    numbers_internal::int256 lhs;
+    numbers_internal::int256 rhs;
+    const bool overflow = lhs_.eval_checked(lhs) | rhs_.eval_checked(rhs);
+    return Op::apply_checked(lhs, rhs, ret) || overflow;
+  }
+
+  template <typename V>
+  V step() const {
+    return Op::apply(lhs_.template step<V>(), rhs_.template step<V>());
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <typename E>
+class expr_neg : public expression<expr_neg<E>> {
+ public:
+  using value_type = typename E::value_type;
+  static constexpr double bound = E::bound;
+
+  constexpr explicit expr_neg(const E &operand) noexcept : operand_{operand} {}
+
+  template <typename W>
+  W eval() const {
+    return -operand_.template eval<W>();
+  }
+
+  bool eval_checked(numbers_internal::int256 &ret) const {
+    numbers_internal::int256 val;
+    const bool overflow = operand_.eval_checked(val);
+    return numbers_internal::int256::overflowing_sub(numbers_internal::int256{}, val, ret) || overflow;
+  }
+
+  template <typename V>
+  V step() const {
+    return -operand_.template step<V>();
+  }
+
+ private:
+  E operand_;
+};
+
+namespace expr_internal {
+
+template <typename T>
+constexpr bool is_operand_v =
+    is_expression_v<T> || is_numbers_type<T>::value || (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+template <typename L, typename R>
+constexpr bool is_expr_operands_v = (is_expression_v<L> || is_expression_v<R>) && is_operand_v<L> && is_operand_v<R>;
+
+template <typename T>
+constexpr auto as_expr(const T &operand) {
+  if constexpr (is_expression_v<T>) {
+    return operand;
+  } else {
+    return expr_leaf<T>(operand);
+  }
+}
+
+template <typename Op, typename L, typename R>
+constexpr auto make_binary(const L &lhs, const R &rhs) {
+  using LE = decltype(as_expr(lhs));
+  using RE = decltype(as_expr(rhs));
+  return expr_binary<Op, LE, RE>(as_expr(lhs), as_expr(rhs));
+}
+
+}  // namespace expr_internal
+
+// expr()
+//
+// Starts a lazy checked expression from a numbers integer.
+template <typename T>
+constexpr expr_leaf<Integer<T>> expr(Integer<T> value) noexcept {
+  return expr_leaf<Integer<T>>(value);
+}
+
+template <typename T>
+constexpr expr_leaf<Uinteger<T>> expr(Uinteger<T> value) noexcept {
+  return expr_leaf<Uinteger<T>>(value);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<expr_internal::is_expr_operands_v<L, R>>>
+constexpr auto operator+(const L &lhs, const R &rhs) {
+  return expr_internal::make_binary<expr_internal::add_op>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<expr_internal::is_expr_operands_v<L, R>>>
+constexpr auto operator-(const L &lhs, const R &rhs) {
+  return expr_internal::make_binary<expr_internal::sub_op>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<expr_internal::is_expr_operands_v<L, R>>>
+constexpr auto operator*(const L &lhs, const R &rhs) {
+  return expr_internal::make_binary<expr_internal::mul_op>(lhs, rhs);
+}
+
+template <typename E, typename = std::enable_if_t<is_expression_v<E>>>
+constexpr auto operator-(const E &operand) {
+  return expr_neg<E>(operand);
+}
+
+}  // namespace numbers
+
+#endif
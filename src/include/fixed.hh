@@ -0,0 +1,311 @@
+#ifndef NUMBERS_FIXED_HH
+#define NUMBERS_FIXED_HH
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/floating.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+
+namespace numbers {
+
+// Binary fixed point
+//
+// `fixed<IntT, FracBits>` is an i16, i32 or i64 whose low FracBits bits are
+// the fraction, so it stands for raw / 2^FracBits. The Q formats of DSP code
+// are aliases covering [-1, 1): q15 = fixed<i16, 15>, q31 = fixed<i32, 31> and
+// q63 = fixed<i64, 63>.
+//
+// Addition and subtraction come in the flavours of the integers. A product is
+// formed in twice the width and rounded to the nearest with ties toward
+// +infinity, (a * b + 2^(FracBits - 1)) >> FracBits, which for q15 is what
+// pmulhrsw computes. In q15, q31 and q63 the only product out of range is
+// -1 * -1.
+//
+//   from_raw(r), raw()       the underlying integer
+//   from_float(v)            v * 2^FracBits rounded to the nearest, ties to even,
+//                            clamped to MIN or MAX, and NaN to 0
+//   to_double(), to_float()  the value, rounded if the raw integer is wider
+//                            than the mantissa
+//   saturating_mac(a, b)     saturating_add(a.saturating_mul(b)), the usual
+//                            multiply-accumulate step of a filter
+//
+// The batch variants work on `count` values. For the i16 and i32 formats they
+// use SSE2, SSSE3 or AVX2 kernels (paddsw, pmulhrsw, cvtps2dq and packssdw),
+// picked once at run time by what the CPU supports, and give the same results
+// as the scalar members.
+//
+//   saturating_add(a, b, count, dst)   dst[i] = a[i].saturating_add(b[i])
+//   saturating_mul(a, b, count, dst)   dst[i] = a[i].saturating_mul(b[i]), SIMD for q15
+//   saturating_mac(acc, a, b, count)   acc[i] = acc[i].saturating_mac(a[i], b[i]), SIMD for q15
+//   from_float(src, count, dst)        dst[i] = from_float(src[i]) for float `src`
+//
+// Example:
+//
+//   numbers::q15 gain = numbers::q15::from_float(0.5f);
+//   numbers::q15 y = numbers::q15::from_float(0.75f).saturating_mul(gain);  // 0.375
+//   numbers::saturating_mul(samples, gains, count, out);
+
+namespace fixed_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename T>
+struct wide;
+template <>
+struct wide<int16_t> {
+  using type = int32_t;
+};
+template <>
+struct wide<int32_t> {
+  using type = int64_t;
+};
+template <>
+struct wide<int64_t> {
+  using type = int128;
+};
+
+template <typename T>
+using wide_t = typename wide<T>::type;
+
+// a * b / 2^FracBits, rounded to the nearest with ties up, in twice the width of T.
+template <typename T, int FracBits>
+constexpr wide_t<T> multiply(T a, T b) noexcept {
+  using W = wide_t<T>;
+  const W product = W(a) * W(b);
+  if constexpr (FracBits == 0) {
+    return product;
+  } else {
+    return (product + (W(1) << (FracBits - 1))) >> FracBits;
+  }
+}
+
+template <typename T>
+constexpr bool fits(wide_t<T> v) noexcept {
+  return v >= wide_t<T>(std::numeric_limits<T>::min()) && v <= wide_t<T>(std::numeric_limits<T>::max());
+}
+
+// SIMD kernels, defined in fixed.cc, which choose their instruction set on the first call.
+void saturating_add_i16(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept;
+void saturating_add_i32(const int32_t *a, const int32_t *b, size_t count, int32_t *dst) noexcept;
+void saturating_mul_q15(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept;
+void saturating_mac_q15(int16_t *acc, const int16_t *a, const int16_t *b, size_t count) noexcept;
+// dst[i] = src[i] * scale, rounded and saturated
+void from_f32_to_i16(const float *src, size_t count, float scale, int16_t *dst) noexcept;
+void from_f32_to_i32(const float *src, size_t count, float scale, int32_t *dst) noexcept;
+
+}  // namespace fixed_internal
+
+template <typename IntT, int FracBits>
+class fixed {
+  static_assert(std::is_same_v<IntT, i16> || std::is_same_v<IntT, i32> || std::is_same_v<IntT, i64>,
+                "fixed storage is i16, i32 or i64");
+
+  using raw_type = numbers_internal::raw_type_t<IntT>;
+
+  static_assert(FracBits >= 0 && FracBits < static_cast<int>(sizeof(raw_type) * 8), "fixed FracBits out of range");
+
+ public:
+  static constexpr int frac_bits = FracBits;
+
+  constexpr fixed() noexcept : raw_(0) {}
+
+  static constexpr fixed from_raw(IntT raw) noexcept { return fixed(static_cast<raw_type>(raw)); }
+
+  template <typename F, typename = std::enable_if_t<std::is_floating_point_v<F>>>
+  static fixed from_float(F v) noexcept {
+    return fixed(numbers_internal::saturating_from_float<raw_type>(std::nearbyint(std::ldexp(v, FracBits))));
+  }
+
+  inline static const fixed MIN = fixed(std::numeric_limits<raw_type>::min());
+  inline static const fixed MAX = fixed(std::numeric_limits<raw_type>::max());
+
+  constexpr IntT raw() const noexcept { return IntT(raw_); }
+
+  double to_double() const noexcept { return std::ldexp(static_cast<double>(raw_), -FracBits); }
+  float to_float() const noexcept { return std::ldexp(static_cast<float>(raw_), -FracBits); }
+
+  fixed operator+(const fixed &other) const noexcept(false) {
+    return fixed(static_cast<raw_type>(IntT(raw_) + IntT(other.raw_)));
+  }
+  std::optional<fixed> checked_add(const fixed &other) const noexcept {
+    return from_checked(IntT(raw_).checked_add(IntT(other.raw_)));
+  }
+  std::tuple<fixed, bool> overflowing_add(const fixed &other) const noexcept {
+    return from_overflowing(IntT(raw_).overflowing_add(IntT(other.raw_)));
+  }
+  fixed saturating_add(const fixed &other) const noexcept {
+    return fixed(static_cast<raw_type>(IntT(raw_).saturating_add(IntT(other.raw_))));
+  }
+  fixed wrapping_add(const fixed &other) const noexcept {
+    return fixed(static_cast<raw_type>(IntT(raw_).wrapping_add(IntT(other.raw_))));
+  }
+
+  fixed operator-(const fixed &other) const noexcept(false) {
+    return fixed(static_cast<raw_type>(IntT(raw_) - IntT(other.raw_)));
+  }
+  std::optional<fixed> checked_sub(const fixed &other) const noexcept {
+    return from_checked(IntT(raw_).checked_sub(IntT(other.raw_)));
+  }
+  std::tuple<fixed, bool> overflowing_sub(const fixed &other) const noexcept {
+    return from_overflowing(IntT(raw_).overflowing_sub(IntT(other.raw_)));
+  }
+  fixed saturating_sub(const fixed &other) const noexcept {
+    return fixed(static_cast<raw_type>(IntT(raw_).saturating_sub(IntT(other.raw_))));
+  }
+  fixed wrapping_sub(const fixed &other) const noexcept {
+    return fixed(static_cast<raw_type>(IntT(raw_).wrapping_sub(IntT(other.raw_))));
+  }
+
+  fixed operator-() const noexcept(false) { return fixed(static_cast<raw_type>(-IntT(raw_))); }
+
+  fixed operator*(const fixed &other) const noexcept(false) {
+    const auto [ret, overflow] = overflowing_mul(other);
+    if (overflow) {
+      overflow_internal::report("mul", raw_, other.raw_);
+    }
+    return ret;
+  }
+  std::optional<fixed> checked_mul(const fixed &other) const noexcept {
+    const auto [ret, overflow] = overflowing_mul(other);
+    if (overflow) {
+      return {};
+    }
+    return ret;
+  }
+  std::tuple<fixed, bool> overflowing_mul(const fixed &other) const noexcept {
+    const auto product = fixed_internal::multiply<raw_type, FracBits>(raw_, other.raw_);
+    return {fixed(static_cast<raw_type>(product)), !fixed_internal::fits<raw_type>(product)};
+  }
+  fixed saturating_mul(const fixed &other) const noexcept {
+    const auto product = fixed_internal::multiply<raw_type, FracBits>(raw_, other.raw_);
+    if (fixed_internal::fits<raw_type>(product)) {
+      return fixed(static_cast<raw_type>(product));
+    }
+    return product < 0 ? MIN : MAX;
+  }
+  fixed wrapping_mul(const fixed &other) const noexcept {
+    return fixed(static_cast<raw_type>(fixed_internal::multiply<raw_type, FracBits>(raw_, other.raw_)));
+  }
+
+  fixed saturating_mac(const fixed &a, const fixed &b) const noexcept {
+    return saturating_add(a.saturating_mul(b));
+  }
+
+  friend bool operator==(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ == rhs.raw_; }
+  friend bool operator!=(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ != rhs.raw_; }
+  friend bool operator<(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ < rhs.raw_; }
+  friend bool operator<=(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ <= rhs.raw_; }
+  friend bool operator>(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ > rhs.raw_; }
+  friend bool operator>=(const fixed &lhs, const fixed &rhs) noexcept { return lhs.raw_ >= rhs.raw_; }
+
+ private:
+  constexpr explicit fixed(raw_type raw) noexcept : raw_(raw) {}
+
+  static std::optional<fixed> from_checked(const std::optional<IntT> &v) noexcept {
+    if (!v) {
+      return {};
+    }
+    return fixed(static_cast<raw_type>(*v));
+  }
+  static std::tuple<fixed, bool> from_overflowing(const std::tuple<IntT, bool> &v) noexcept {
+    return {fixed(static_cast<raw_type>(std::get<0>(v))), std::get<1>(v)};
+  }
+
+  raw_type raw_;
+};
+
+using q15 = fixed<i16, 15>;
+using q31 = fixed<i32, 31>;
+using q63 = fixed<i64, 63>;
+
+namespace fixed_internal {
+
+// The fixed types are laid out exactly like their raw integers.
+template <typename IntT, int FracBits>
+constexpr bool is_raw_v = sizeof(fixed<IntT, FracBits>) == sizeof(raw_type_t<IntT>);
+
+template <typename IntT, int FracBits>
+const raw_type_t<IntT> *raw(const fixed<IntT, FracBits> *p) noexcept {
+  static_assert(is_raw_v<IntT, FracBits>, "fixed must be laid out like its raw integer");
+  return reinterpret_cast<const raw_type_t<IntT> *>(p);
+}
+
+template <typename IntT, int FracBits>
+raw_type_t<IntT> *raw(fixed<IntT, FracBits> *p) noexcept {
+  static_assert(is_raw_v<IntT, FracBits>, "fixed must be laid out like its raw integer");
+  return reinterpret_cast<raw_type_t<IntT> *>(p);
+}
+
+}  // namespace fixed_internal
+
+template <typename IntT, int FracBits>
+void saturating_add(const fixed<IntT, FracBits> *a, const fixed<IntT, FracBits> *b, size_t count,
+                    fixed<IntT, FracBits> *dst) noexcept {
+  using fixed_internal::raw;
+  if constexpr (std::is_same_v<IntT, i16>) {
+    fixed_internal::saturating_add_i16(raw(a), raw(b), count, raw(dst));
+  } else if constexpr (std::is_same_v<IntT, i32>) {
+    fixed_internal::saturating_add_i32(raw(a), raw(b), count, raw(dst));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = a[i].saturating_add(b[i]);
+    }
+  }
+}
+
+template <typename IntT, int FracBits>
+void saturating_mul(const fixed<IntT, FracBits> *a, const fixed<IntT, FracBits> *b, size_t count,
+                    fixed<IntT, FracBits> *dst) noexcept {
+  using fixed_internal::raw;
+  if constexpr (std::is_same_v<fixed<IntT, FracBits>, q15>) {
+    fixed_internal::saturating_mul_q15(raw(a), raw(b), count, raw(dst));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = a[i].saturating_mul(b[i]);
+    }
+  }
+}
+
+template <typename IntT, int FracBits>
+void saturating_mac(fixed<IntT, FracBits> *acc, const fixed<IntT, FracBits> *a, const fixed<IntT, FracBits> *b,
+                    size_t count) noexcept {
+  using fixed_internal::raw;
+  if constexpr (std::is_same_v<fixed<IntT, FracBits>, q15>) {
+    fixed_internal::saturating_mac_q15(raw(acc), raw(a), raw(b), count);
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      acc[i] = acc[i].saturating_mac(a[i], b[i]);
+    }
+  }
+}
+
+template <typename IntT, int FracBits>
+void from_float(const float *src, size_t count, fixed<IntT, FracBits> *dst) noexcept {
+  using fixed_internal::raw;
+  if constexpr (std::is_same_v<IntT, i16>) {
+    fixed_internal::from_f32_to_i16(src, count, std::ldexp(1.0f, FracBits), raw(dst));
+  } else if constexpr (std::is_same_v<IntT, i32>) {
+    fixed_internal::from_f32_to_i32(src, count, std::ldexp(1.0f, FracBits), raw(dst));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = fixed<IntT, FracBits>::from_float(src[i]);
+    }
+  }
+}
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/fixed_impl.hh"
+#endif
+
+#endif
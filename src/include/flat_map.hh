@@ -0,0 +1,467 @@
+#ifndef NUMBERS_FLAT_MAP_HH
+#define NUMBERS_FLAT_MAP_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hash.hh"
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NUMBERS_FLAT_SSE2 1
+#endif
+
+namespace numbers {
+
+// Open addressing hash containers for integer keys
+//
+// `flat_map<K, V>` and `flat_set<K>` keep their keys in one flat array, next
+// to an array of one control byte per slot, instead of allocating a node per
+// entry like std::unordered_map. `K` is any of the aliases, int128, uint128
+// or a built-in integer.
+//
+// The slots are probed a group of 16 at a time, Swiss table style: the
+// control byte of a full slot holds 7 bits of the hash, and one SSE2
+// comparison finds the slots of a group whose byte matches, so the keys
+// themselves are only compared for those, usually one. A lookup stops at the
+// first group with an empty slot.
+//
+//   flat_map<u128, int> ids;
+//   ids[u128(42)] = 1;
+//   ids.insert(u128(7), 2);       // false if the key was already there
+//   if (const int *v = ids.find(u128(42))) { ... }
+//   ids.erase(u128(7));
+//   ids.for_each([](u128 key, int value) { ... });
+//
+// The bulk operations hash a block of keys first and prefetch their groups,
+// so that the cache misses of the block overlap:
+//
+//   ids.insert(keys, values, count)           returns how many keys were new
+//   ids.find(keys, count, dst, fallback)      stores the value of each key, or `fallback`,
+//                                             and returns how many keys were found
+//   set.contains(keys, count, found)          stores whether each key is there, and
+//                                             returns how many are
+//
+// `V` must be default constructible. Inserting may move the entries, so
+// pointers returned by find() are only valid until the next insertion.
+
+namespace flat_internal {
+
+template <typename K>
+constexpr bool is_key_v = numbers_internal::is_numbers_type_v<K> || numbers_internal::is_integer_v<K>;
+
+constexpr size_t kGroupSize = 16;
+
+// Control bytes: a full slot holds the low 7 bits of the hash of its key.
+constexpr int8_t kEmpty = -128;
+constexpr int8_t kDeleted = -2;
+
+// Bit i is set if byte i of the group equals `value`.
+inline uint32_t match(const int8_t *group, int8_t value) noexcept {
+#if defined(NUMBERS_FLAT_SSE2)
+  const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupSize; ++i) {
+    mask |= static_cast<uint32_t>(group[i] == value) << i;
+  }
+  return mask;
+#endif
+}
+
+// Bit i is set if slot i of the group is empty or deleted, i.e. its sign bit is set.
+inline uint32_t match_available(const int8_t *group) noexcept {
+#if defined(NUMBERS_FLAT_SSE2)
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group))));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kGroupSize; ++i) {
+    mask |= static_cast<uint32_t>(group[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+inline int lowest_bit(uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctz(mask);
+#else
+  int i = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    ++i;
+  }
+  return i;
+#endif
+}
+
+inline void prefetch(const void *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p);
+#elif defined(NUMBERS_FLAT_SSE2)
+  _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+struct no_value {};
+
+// numbers::hash for every key type, since std::hash of the built-in integers is usually the identity.
+template <typename K>
+struct default_hash {
+  size_t operator()(const K &key) const noexcept { return static_cast<size_t>(numbers::hash(key)); }
+};
+
+// The table behind flat_map and flat_set; a set stores no values.
+template <typename K, typename V, typename Hash>
+class table {
+  static_assert(is_key_v<K>, "flat containers need an integer key type");
+
+  static constexpr bool kHasValues = !std::is_same_v<V, no_value>;
+  static constexpr size_t kBlock = 16;
+
+ public:
+  table() = default;
+  explicit table(size_t capacity, const Hash &hash = Hash()) : hash_(hash) { reserve(capacity); }
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_t capacity() const noexcept { return ctrl_.size(); }
+
+  void clear() noexcept {
+    ctrl_.assign(ctrl_.size(), kEmpty);
+    if constexpr (kHasValues) {
+      values_.assign(values_.size(), V());
+    }
+    size_ = 0;
+    deleted_ = 0;
+  }
+
+  // Makes room for `count` entries without rehashing.
+  void reserve(size_t count) {
+    if (count > max_load(capacity())) {
+      rehash(count);
+    }
+  }
+
+  // Returns the slot of `key`, or npos.
+  size_t find(const K &key) const noexcept { return find(key, hash_(key)); }
+
+  // Returns the slot of `key` and whether it was inserted.
+  std::pair<size_t, bool> insert(const K &key) { return insert(key, hash_(key)); }
+
+  bool erase(const K &key) noexcept {
+    const size_t slot = find(key);
+    if (slot == npos) {
+      return false;
+    }
+    // No probe sequence ever passed a group that still has an empty slot, so
+    // the slot can become empty again instead of a tombstone.
+    const size_t group = slot & ~(kGroupSize - 1);
+    if (match(&ctrl_[group], kEmpty)) {
+      ctrl_[slot] = kEmpty;
+    } else {
+      ctrl_[slot] = kDeleted;
+      ++deleted_;
+    }
+    if constexpr (kHasValues) {
+      values_[slot] = V();
+    }
+    --size_;
+    return true;
+  }
+
+  template <typename F>
+  void for_each(F &&fn) const {
+    for (size_t i = 0; i < ctrl_.size(); ++i) {
+      if (ctrl_[i] >= 0) {
+        if constexpr (kHasValues) {
+          fn(keys_[i], values_[i]);
+        } else {
+          fn(keys_[i]);
+        }
+      }
+    }
+  }
+
+  // Calls `fn(i, slot)` for each of the `count` keys, with the keys hashed and
+  // their groups prefetched a block at a time.
+  template <typename F>
+  void find_each(const K *keys, size_t count, F &&fn) const {
+    size_t hashes[kBlock];
+    for (size_t begin = 0; begin < count; begin += kBlock) {
+      const size_t n = count - begin < kBlock ? count - begin : kBlock;
+      for (size_t i = 0; i < n; ++i) {
+        hashes[i] = hash_(keys[begin + i]);
+        if (!ctrl_.empty()) {
+          const size_t group = first_group(hashes[i]);
+          prefetch(&ctrl_[group]);
+          prefetch(&keys_[group]);
+        }
+      }
+      for (size_t i = 0; i < n; ++i) {
+        fn(begin + i, find(keys[begin + i], hashes[i]));
+      }
+    }
+  }
+
+  // Calls `fn(i, slot, inserted)` for each of the `count` keys.
+  template <typename F>
+  void insert_each(const K *keys, size_t count, F &&fn) {
+    reserve(size_ + count);
+    size_t hashes[kBlock];
+    for (size_t begin = 0; begin < count; begin += kBlock) {
+      const size_t n = count - begin < kBlock ? count - begin : kBlock;
+      for (size_t i = 0; i < n; ++i) {
+        hashes[i] = hash_(keys[begin + i]);
+        const size_t group = first_group(hashes[i]);
+        prefetch(&ctrl_[group]);
+        prefetch(&keys_[group]);
+      }
+      for (size_t i = 0; i < n; ++i) {
+        const auto [slot, inserted] = insert(keys[begin + i], hashes[i]);
+        fn(begin + i, slot, inserted);
+      }
+    }
+  }
+
+  const K &key(size_t slot) const noexcept { return keys_[slot]; }
+  V &value(size_t slot) noexcept { return values_[slot]; }
+  const V &value(size_t slot) const noexcept { return values_[slot]; }
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+ private:
+  static constexpr size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+  static int8_t h2(size_t hash) noexcept { return static_cast<int8_t>(hash & 0x7f); }
+
+  size_t first_group(size_t hash) const noexcept { return ((hash >> 7) * kGroupSize) & (ctrl_.size() - 1); }
+
+  size_t find(const K &key, size_t hash) const noexcept {
+    if (ctrl_.empty()) {
+      return npos;
+    }
+    const size_t mask = ctrl_.size() - 1;
+    size_t group = first_group(hash);
+    // Triangular steps over the groups visit each of them once, since the number of groups is a power of two.
+    for (size_t step = kGroupSize;; step += kGroupSize) {
+      const int8_t *ctrl = &ctrl_[group];
+      for (uint32_t bits = match(ctrl, h2(hash)); bits; bits &= bits - 1) {
+        const size_t slot = group + lowest_bit(bits);
+        if (keys_[slot] == key) {
+          return slot;
+        }
+      }
+      if (match(ctrl, kEmpty)) {
+        return npos;
+      }
+      group = (group + step) & mask;
+    }
+  }
+
+  // The first empty or deleted slot on the probe sequence of `hash`.
+  size_t find_available(size_t hash) const noexcept {
+    const size_t mask = ctrl_.size() - 1;
+    size_t group = first_group(hash);
+    for (size_t step = kGroupSize;; step += kGroupSize) {
+      if (const uint32_t bits = match_available(&ctrl_[group])) {
+        return group + lowest_bit(bits);
+      }
+      group = (group + step) & mask;
+    }
+  }
+
+  std::pair<size_t, bool> insert(const K &key, size_t hash) {
+    const size_t found = find(key, hash);
+    if (found != npos) {
+      return {found, false};
+    }
+    if (size_ + deleted_ + 1 > max_load(capacity())) {
+      // grow by doubling, or only drop the tombstones if they take most of the room
+      rehash(size_ * 2 + 1);
+    }
+    const size_t slot = find_available(hash);
+    if (ctrl_[slot] == kDeleted) {
+      --deleted_;
+    }
+    ctrl_[slot] = h2(hash);
+    keys_[slot] = key;
+    ++size_;
+    return {slot, true};
+  }
+
+  // Rebuilds the table with room for at least `count` entries, which drops the tombstones.
+  void rehash(size_t count) {
+    size_t capacity = kGroupSize;
+    while (max_load(capacity) < count) {
+      capacity *= 2;
+    }
+    std::vector<int8_t> ctrl(capacity, kEmpty);
+    std::vector<K> keys(capacity);
+    std::vector<V> values;
+    if constexpr (kHasValues) {
+      values.resize(capacity);
+    }
+    ctrl.swap(ctrl_);
+    keys.swap(keys_);
+    values.swap(values_);
+    deleted_ = 0;
+    for (size_t i = 0; i < ctrl.size(); ++i) {
+      if (ctrl[i] >= 0) {
+        const size_t hash = hash_(keys[i]);
+        const size_t slot = find_available(hash);
+        ctrl_[slot] = h2(hash);
+        keys_[slot] = keys[i];
+        if constexpr (kHasValues) {
+          values_[slot] = std::move(values[i]);
+        }
+      }
+    }
+  }
+
+  std::vector<int8_t> ctrl_;
+  std::vector<K> keys_;
+  std::vector<V> values_;
+  size_t size_ = 0;
+  size_t deleted_ = 0;
+  Hash hash_;
+};
+
+}  // namespace flat_internal
+
+template <typename K, typename V, typename Hash = flat_internal::default_hash<K>>
+class flat_map {
+  using table_type = flat_internal::table<K, V, Hash>;
+
+ public:
+  flat_map() = default;
+  explicit flat_map(size_t capacity, const Hash &hash = Hash()) : table_(capacity, hash) {}
+
+  size_t size() const noexcept { return table_.size(); }
+  bool empty() const noexcept { return table_.empty(); }
+  size_t capacity() const noexcept { return table_.capacity(); }
+  void clear() noexcept { table_.clear(); }
+  void reserve(size_t count) { table_.reserve(count); }
+
+  // Inserts `value` unless `key` is already there; returns true if it was inserted.
+  bool insert(const K &key, V value) {
+    const auto [slot, inserted] = table_.insert(key);
+    if (inserted) {
+      table_.value(slot) = std::move(value);
+    }
+    return inserted;
+  }
+
+  // Inserts or overwrites.
+  void insert_or_assign(const K &key, V value) { table_.value(table_.insert(key).first) = std::move(value); }
+
+  V &operator[](const K &key) { return table_.value(table_.insert(key).first); }
+
+  V *find(const K &key) noexcept {
+    const size_t slot = table_.find(key);
+    return slot == table_type::npos ? nullptr : &table_.value(slot);
+  }
+
+  const V *find(const K &key) const noexcept {
+    const size_t slot = table_.find(key);
+    return slot == table_type::npos ? nullptr : &table_.value(slot);
+  }
+
+  bool contains(const K &key) const noexcept { return table_.find(key) != table_type::npos; }
+  size_t count(const K &key) const noexcept { return contains(key) ? 1 : 0; }
+  bool erase(const K &key) noexcept { return table_.erase(key); }
+
+  // Calls `fn(key, value)` for every entry, in no particular order.
+  template <typename F>
+  void for_each(F &&fn) const {
+    table_.for_each(std::forward<F>(fn));
+  }
+
+  size_t insert(const K *keys, const V *values, size_t count) {
+    size_t inserted = 0;
+    table_.insert_each(keys, count, [&](size_t i, size_t slot, bool is_new) {
+      if (is_new) {
+        table_.value(slot) = values[i];
+        ++inserted;
+      }
+    });
+    return inserted;
+  }
+
+  size_t find(const K *keys, size_t count, V *dst, const V &fallback) const {
+    size_t found = 0;
+    table_.find_each(keys, count, [&](size_t i, size_t slot) {
+      if (slot == table_type::npos) {
+        dst[i] = fallback;
+      } else {
+        dst[i] = table_.value(slot);
+        ++found;
+      }
+    });
+    return found;
+  }
+
+ private:
+  table_type table_;
+};
+
+template <typename K, typename Hash = flat_internal::default_hash<K>>
+class flat_set {
+  using table_type = flat_internal::table<K, flat_internal::no_value, Hash>;
+
+ public:
+  flat_set() = default;
+  explicit flat_set(size_t capacity, const Hash &hash = Hash()) : table_(capacity, hash) {}
+
+  size_t size() const noexcept { return table_.size(); }
+  bool empty() const noexcept { return table_.empty(); }
+  size_t capacity() const noexcept { return table_.capacity(); }
+  void clear() noexcept { table_.clear(); }
+  void reserve(size_t count) { table_.reserve(count); }
+
+  // Returns true if `key` was not there yet.
+  bool insert(const K &key) { return table_.insert(key).second; }
+  bool contains(const K &key) const noexcept { return table_.find(key) != table_type::npos; }
+  size_t count(const K &key) const noexcept { return contains(key) ? 1 : 0; }
+  bool erase(const K &key) noexcept { return table_.erase(key); }
+
+  // Calls `fn(key)` for every key, in no particular order.
+  template <typename F>
+  void for_each(F &&fn) const {
+    table_.for_each(std::forward<F>(fn));
+  }
+
+  size_t insert(const K *keys, size_t count) {
+    size_t inserted = 0;
+    table_.insert_each(keys, count, [&](size_t, size_t, bool is_new) { inserted += is_new; });
+    return inserted;
+  }
+
+  size_t contains(const K *keys, size_t count, bool *found) const {
+    size_t ret = 0;
+    table_.find_each(keys, count, [&](size_t i, size_t slot) {
+      found[i] = slot != table_type::npos;
+      ret += found[i];
+    });
+    return ret;
+  }
+
+ private:
+  table_type table_;
+};
+
+}  // namespace numbers
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef NUMBERS_FLOATING_HH
+#define NUMBERS_FLOATING_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/floating.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Floating point conversions
+//
+//   checked_from_float<N>(v)     truncates `v` toward zero, or returns std::nullopt if
+//                                `v` is NaN or the result does not fit `N`
+//   saturating_from_float<N>(v)  truncates `v` toward zero, clamps out of range values to
+//                                N::MIN or N::MAX and turns NaN into 0, like the Rust `as`
+//   to_double(n), to_float(n)    rounds `n` to the nearest value, ties to even
+//
+// `N` is any of the aliases, int128, uint128 or a built-in integer, and `v` is
+// a float, double or long double. The 128-bit conversions work on the bits of
+// the values directly.
+//
+// Example:
+//
+//   std::optional<numbers::i32> a = numbers::checked_from_float<numbers::i32>(3e9);  // std::nullopt
+//   numbers::u8 b = numbers::saturating_from_float<numbers::u8>(-1.5);              // 0
+//   double c = numbers::to_double(numbers::u128::MAX);                              // 2^128
+//
+// The batch variants convert `count` values from `src` into `dst`, using SIMD
+// conversion instructions between 32-bit integers and floats or doubles where
+// available.
+//
+//   saturating_from_float(src, count, dst)
+//   to_double(src, count, dst)
+//   to_float(src, count, dst)
+
+namespace floating_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename N>
+constexpr bool is_integer_v = numbers_internal::is_numbers_type_v<N> || numbers_internal::is_integer_v<N>;
+
+template <typename N, typename F>
+using enable_if_from_float_t = std::enable_if_t<is_integer_v<N> && std::is_floating_point_v<F>>;
+
+template <typename N>
+using enable_if_integer_t = std::enable_if_t<is_integer_v<N>>;
+
+// SIMD kernels, defined in floating.cc.
+void saturate_f32_to_i32(const float *src, size_t count, int32_t *dst) noexcept;
+void saturate_f64_to_i32(const double *src, size_t count, int32_t *dst) noexcept;
+void convert_i32_to_f32(const int32_t *src, size_t count, float *dst) noexcept;
+void convert_i32_to_f64(const int32_t *src, size_t count, double *dst) noexcept;
+
+// The i32 alias is laid out exactly like int32_t.
+template <typename N>
+constexpr bool is_i32_v = std::is_same_v<raw_type_t<N>, int32_t> && sizeof(N) == sizeof(int32_t);
+
+template <typename F, typename N>
+F to_floating(N v) noexcept {
+  return static_cast<F>(static_cast<raw_type_t<N>>(v));
+}
+
+}  // namespace floating_internal
+
+template <typename N, typename F, typename = floating_internal::enable_if_from_float_t<N, F>>
+std::optional<N> checked_from_float(F v) noexcept {
+  using T = numbers_internal::raw_type_t<N>;
+  if (!numbers_internal::float_fits<T>(v)) {
+    return {};
+  }
+  return N(static_cast<T>(v));
+}
+
+template <typename N, typename F, typename = floating_internal::enable_if_from_float_t<N, F>>
+N saturating_from_float(F v) noexcept {
+  return N(numbers_internal::saturating_from_float<numbers_internal::raw_type_t<N>>(v));
+}
+
+template <typename N, typename = floating_internal::enable_if_integer_t<N>>
+double to_double(N v) noexcept {
+  return floating_internal::to_floating<double>(v);
+}
+
+template <typename N, typename = floating_internal::enable_if_integer_t<N>>
+float to_float(N v) noexcept {
+  return floating_internal::to_floating<float>(v);
+}
+
+template <typename N, typename F, typename = floating_internal::enable_if_from_float_t<N, F>>
+void saturating_from_float(const F *src, size_t count, N *dst) noexcept {
+  if constexpr (floating_internal::is_i32_v<N> && std::is_same_v<F, float>) {
+    floating_internal::saturate_f32_to_i32(src, count, reinterpret_cast<int32_t *>(dst));
+  } else if constexpr (floating_internal::is_i32_v<N> && std::is_same_v<F, double>) {
+    floating_internal::saturate_f64_to_i32(src, count, reinterpret_cast<int32_t *>(dst));
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = saturating_from_float<N>(src[i]);
+    }
+  }
+}
+
+template <typename N, typename = floating_internal::enable_if_integer_t<N>>
+void to_double(const N *src, size_t count, double *dst) noexcept {
+  if constexpr (floating_internal::is_i32_v<N>) {
+    floating_internal::convert_i32_to_f64(reinterpret_cast<const int32_t *>(src), count, dst);
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = to_double(src[i]);
+    }
+  }
+}
+
+template <typename N, typename = floating_internal::enable_if_integer_t<N>>
+void to_float(const N *src, size_t count, float *dst) noexcept {
+  if constexpr (floating_internal::is_i32_v<N>) {
+    floating_internal::convert_i32_to_f32(reinterpret_cast<const int32_t *>(src), count, dst);
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = to_float(src[i]);
+    }
+  }
+}
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/floating_impl.hh"
+#endif
+
+#endif
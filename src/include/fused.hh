@@ -0,0 +1,374 @@
+#ifndef NUMBERS_FUSED_HH
+#define NUMBERS_FUSED_HH
+
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/config.h"
+#include "internal/traits.hh"
+#include "internal/wide.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Fused multi-operand operations
+//
+//   mul_add(a, b, c)  = a * b + c
+//   mul_sub(a, b, c)  = a * b - c
+//   dot2(a, b, c, d)  = a * b + c * d
+//   sum3(a, b, c)     = a + b + c
+//
+// The operands are widened to a type twice as wide (int64_t for up to 32-bit
+// operands, int128 for 64-bit operands and a 256-bit integer for 128-bit
+// operands), the whole operation is computed exactly there and the result is
+// range checked once, instead of checking each intermediate operation. As a
+// consequence an intermediate overflow that the final result recovers from is
+// not reported.
+//
+// Like the member operations, each one comes in five flavours: the plain one
+// throws numbers::overflow_error on overflow, naming the first step that
+// overflows when the operators are applied one at a time, e.g. the product of
+// mul_add or its sum with c, and the checked_, overflowing_, saturating_ and
+// wrapping_ ones behave like their member counterparts.
+//
+// Example:
+//
+//   numbers::i64 acc = 0;
+//   acc = numbers::mul_add(price, qty, acc);  // acc + price * qty, one check
+//   std::optional<numbers::i64> ret = numbers::checked_dot2(a, b, c, d);
+
+namespace fused_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename T>
+constexpr bool is_128_v = std::is_same_v<T, int128> || std::is_same_v<T, uint128>;
+
+// The type holding the exact product of two `T` values.
+template <typename T>
+using wide_t = std::conditional_t<
+    is_128_v<T>, numbers_internal::wide256<std::is_signed_v<T>>,
+    std::conditional_t<sizeof(T) == sizeof(uint64_t), std::conditional_t<std::is_signed_v<T>, int128, uint128>,
+                       std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>>;
+
+template <typename T>
+wide_t<T> widen(T v) {
+  if constexpr (is_128_v<T>) {
+    return wide_t<T>::from(v);
+  } else {
+    return static_cast<wide_t<T>>(v);
+  }
+}
+
+template <typename T>
+wide_t<T> widen(Integer<T> v) {
+  return widen(static_cast<T>(v));
+}
+
+template <typename T>
+wide_t<T> widen(Uinteger<T> v) {
+  return widen(static_cast<T>(v));
+}
+
+template <typename W>
+W wrapping_add(const W &lhs, const W &rhs) {
+  if constexpr (std::is_same_v<W, int64_t>) {
+    return static_cast<int64_t>(static_cast<uint64_t>(lhs) + static_cast<uint64_t>(rhs));
+  } else if constexpr (std::is_same_v<W, int128>) {
+    return int128(uint128(lhs) + uint128(rhs));
+  } else {
+    return lhs + rhs;
+  }
+}
+
+template <typename W>
+bool is_negative(const W &val) {
+  if constexpr (std::is_same_v<W, numbers_internal::int256> || std::is_same_v<W, numbers_internal::uint256>) {
+    return val.is_negative();
+  } else if constexpr (std::is_signed_v<W>) {
+    return val < 0;
+  } else {
+    return false;
+  }
+}
+
+// The exact result of a fused operation in the wide type.
+template <typename T>
+struct result {
+  wide_t<T> value;
+  // The wide computation itself wrapped around; `value` is still correct
+  // modulo its width.
+  bool overflow;
+  // The sign of the exact result.
+  bool negative;
+
+  bool fits() const {
+    if (overflow) {
+      return false;
+    }
+    if constexpr (is_128_v<T>) {
+      return value.template fits<T>();
+    } else {
+      return !(value < widen(std::numeric_limits<T>::min())) && !(widen(std::numeric_limits<T>::max()) < value);
+    }
+  }
+
+  T truncate() const {
+    if constexpr (is_128_v<T>) {
+      return value.template truncate<T>();
+    } else {
+      return static_cast<T>(value);
+    }
+  }
+};
+
+template <typename T>
+result<T> exact(const wide_t<T> &value) {
+  return {value, false, is_negative(value)};
+}
+
+template <typename N>
+result<raw_type_t<N>> mul_add(N a, N b, N c) {
+  return exact<raw_type_t<N>>(widen(a) * widen(b) + widen(c));
+}
+
+template <typename N>
+result<raw_type_t<N>> mul_sub(N a, N b, N c) {
+  using T = raw_type_t<N>;
+  const wide_t<T> product = widen(a) * widen(b);
+  const wide_t<T> subtrahend = widen(c);
+  if constexpr (std::is_signed_v<T>) {
+    return exact<T>(product - subtrahend);
+  } else {
+    const bool borrow = product < subtrahend;
+    return {product - subtrahend, borrow, borrow};
+  }
+}
+
+template <typename N>
+result<raw_type_t<N>> dot2(N a, N b, N c, N d) {
+  using T = raw_type_t<N>;
+  const wide_t<T> lhs = widen(a) * widen(b);
+  const wide_t<T> rhs = widen(c) * widen(d);
+  const wide_t<T> sum = wrapping_add(lhs, rhs);
+  if constexpr (std::is_signed_v<T>) {
+    // Only MIN * MIN + MIN * MIN leaves the wide type.
+    const bool overflow = is_negative(lhs) == is_negative(rhs) && is_negative(sum) != is_negative(lhs);
+    return {sum, overflow, overflow ? is_negative(lhs) : is_negative(sum)};
+  } else {
+    return {sum, sum < lhs, false};
+  }
+}
+
+template <typename N>
+result<raw_type_t<N>> sum3(N a, N b, N c) {
+  return exact<raw_type_t<N>>(widen(a) + widen(b) + widen(c));
+}
+
+// Throw the overflow of the whole result as the first step that overflows when
+// the operators are applied one at a time; as the result does not fit, one of
+// them does not either.
+template <typename N>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_mul_then(N a, N b, const char *op, N c) {
+  using T = raw_type_t<N>;
+  const std::optional<N> product = a.checked_mul(b);
+  if (!product) {
+    overflow_internal::report("mul", static_cast<T>(a), static_cast<T>(b));
+  }
+  overflow_internal::report(op, static_cast<T>(*product), static_cast<T>(c));
+}
+
+template <typename N>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_dot2(N a, N b, N c, N d) {
+  using T = raw_type_t<N>;
+  const std::optional<N> product = c.checked_mul(d);
+  if (!product) {
+    overflow_internal::report("mul", static_cast<T>(c), static_cast<T>(d));
+  }
+  report_mul_then(a, b, "add", *product);
+}
+
+template <typename N>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_sum3(N a, N b, N c) {
+  using T = raw_type_t<N>;
+  const std::optional<N> sum = a.checked_add(b);
+  if (!sum) {
+    overflow_internal::report("add", static_cast<T>(a), static_cast<T>(b));
+  }
+  overflow_internal::report("add", static_cast<T>(*sum), static_cast<T>(c));
+}
+
+template <typename N>
+std::optional<N> checked(const result<raw_type_t<N>> &ret) noexcept {
+  if (!ret.fits()) {
+    return {};
+  }
+  return N(ret.truncate());
+}
+
+template <typename N>
+std::tuple<N, bool> overflowing(const result<raw_type_t<N>> &ret) noexcept {
+  return {N(ret.truncate()), !ret.fits()};
+}
+
+template <typename N>
+N saturating(const result<raw_type_t<N>> &ret) noexcept {
+  if (!ret.fits()) {
+    return ret.negative ? N::MIN : N::MAX;
+  }
+  return N(ret.truncate());
+}
+
+template <typename N>
+N wrapping(const result<raw_type_t<N>> &ret) noexcept {
+  return N(ret.truncate());
+}
+
+template <typename N>
+using enable_if_numbers_t = std::enable_if_t<numbers_internal::is_numbers_type_v<N>>;
+
+template <typename N>
+using operand_t = numbers_internal::type_identity_t<N>;
+
+}  // namespace fused_internal
+
+// mul_add()
+//
+// Returns a * b + c, throwing if the result overflows.
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N mul_add(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept(false) {
+  const auto ret = fused_internal::mul_add(a, b, c);
+  if (!ret.fits()) {
+    fused_internal::report_mul_then<N>(a, b, "add", c);
+  }
+  return N(ret.truncate());
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::optional<N> checked_mul_add(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::checked<N>(fused_internal::mul_add(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::tuple<N, bool> overflowing_mul_add(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::overflowing<N>(fused_internal::mul_add(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N saturating_mul_add(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::saturating<N>(fused_internal::mul_add(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N wrapping_mul_add(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::wrapping<N>(fused_internal::mul_add(a, b, c));
+}
+
+// mul_sub()
+//
+// Returns a * b - c, throwing if the result overflows.
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N mul_sub(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept(false) {
+  const auto ret = fused_internal::mul_sub(a, b, c);
+  if (!ret.fits()) {
+    fused_internal::report_mul_then<N>(a, b, "sub", c);
+  }
+  return N(ret.truncate());
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::optional<N> checked_mul_sub(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::checked<N>(fused_internal::mul_sub(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::tuple<N, bool> overflowing_mul_sub(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::overflowing<N>(fused_internal::mul_sub(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N saturating_mul_sub(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::saturating<N>(fused_internal::mul_sub(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N wrapping_mul_sub(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::wrapping<N>(fused_internal::mul_sub(a, b, c));
+}
+
+// dot2()
+//
+// Returns a * b + c * d, throwing if the result overflows.
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N dot2(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c,
+       fused_internal::operand_t<N> d) noexcept(false) {
+  const auto ret = fused_internal::dot2(a, b, c, d);
+  if (!ret.fits()) {
+    fused_internal::report_dot2<N>(a, b, c, d);
+  }
+  return N(ret.truncate());
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::optional<N> checked_dot2(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c,
+                              fused_internal::operand_t<N> d) noexcept {
+  return fused_internal::checked<N>(fused_internal::dot2(a, b, c, d));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::tuple<N, bool> overflowing_dot2(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c,
+                                     fused_internal::operand_t<N> d) noexcept {
+  return fused_internal::overflowing<N>(fused_internal::dot2(a, b, c, d));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N saturating_dot2(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c,
+                  fused_internal::operand_t<N> d) noexcept {
+  return fused_internal::saturating<N>(fused_internal::dot2(a, b, c, d));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N wrapping_dot2(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c,
+                fused_internal::operand_t<N> d) noexcept {
+  return fused_internal::wrapping<N>(fused_internal::dot2(a, b, c, d));
+}
+
+// sum3()
+//
+// Returns a + b + c, throwing if the result overflows.
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N sum3(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept(false) {
+  const auto ret = fused_internal::sum3(a, b, c);
+  if (!ret.fits()) {
+    fused_internal::report_sum3<N>(a, b, c);
+  }
+  return N(ret.truncate());
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::optional<N> checked_sum3(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::checked<N>(fused_internal::sum3(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+std::tuple<N, bool> overflowing_sum3(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::overflowing<N>(fused_internal::sum3(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N saturating_sum3(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::saturating<N>(fused_internal::sum3(a, b, c));
+}
+
+template <typename N, typename = fused_internal::enable_if_numbers_t<N>>
+N wrapping_sum3(N a, fused_internal::operand_t<N> b, fused_internal::operand_t<N> c) noexcept {
+  return fused_internal::wrapping<N>(fused_internal::sum3(a, b, c));
+}
+
+}  // namespace numbers
+
+#endif
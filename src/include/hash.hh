@@ -0,0 +1,110 @@
+#ifndef NUMBERS_HASH_HH
+#define NUMBERS_HASH_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/hash.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Hashing
+//
+// std::hash of every alias, int128 and uint128 is a multiply-fold mixer built
+// on a 64x64->128 bit multiplication, so structured keys such as sequential
+// ids or 128-bit keys with related halves spread over the whole table. The
+// same mixer is available directly, with an optional seed:
+//
+//   hash(v)          the value std::hash returns, as a 64-bit integer
+//   hash(v, seed)    a hash that also depends on `seed`
+//   seeded_hash<N>   a hasher for the unordered containers, which mixes the
+//                    seed once when it is constructed
+//
+// The batch variants hash `count` values from `src` into `dst` with the seed
+// prepared once, and the iterations independent of each other so that the
+// multiplications of consecutive keys overlap.
+//
+//   hash(src, count, dst)
+//   hash(src, count, dst, seed)
+//
+// Example:
+//
+//   std::unordered_map<numbers::u128, int, numbers::seeded_hash<numbers::u128>> table(
+//       16, numbers::seeded_hash<numbers::u128>(random_seed));
+//   uint64_t h = numbers::hash(numbers::u128(42), 7);
+
+namespace hash_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename N>
+constexpr bool is_hashable_v = numbers_internal::is_numbers_type_v<N> || numbers_internal::is_integer_v<N>;
+
+template <typename N>
+using enable_if_hashable_t = std::enable_if_t<is_hashable_v<N>>;
+
+// `seed` has already been through numbers_internal::hash_seed.
+template <typename N>
+uint64_t hash_one(N v, uint64_t seed) noexcept {
+  using T = raw_type_t<N>;
+  const T raw = static_cast<T>(v);
+  if constexpr (std::is_same_v<T, uint128>) {
+    return numbers_internal::hash_words(uint128_low64(raw), uint128_high64(raw), sizeof(T), seed);
+  } else if constexpr (std::is_same_v<T, int128>) {
+    return numbers_internal::hash_words(int128_low64(raw), static_cast<uint64_t>(int128_high64(raw)), sizeof(T), seed);
+  } else {
+    return numbers_internal::hash_integral(raw, seed);
+  }
+}
+
+template <typename N>
+void hash_batch(const N *src, size_t count, uint64_t *dst, uint64_t seed) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = hash_one(src[i], seed);
+  }
+}
+
+}  // namespace hash_internal
+
+template <typename N, typename = hash_internal::enable_if_hashable_t<N>>
+uint64_t hash(N v) noexcept {
+  return hash_internal::hash_one(v, numbers_internal::kHashDefaultSeed);
+}
+
+template <typename N, typename = hash_internal::enable_if_hashable_t<N>>
+uint64_t hash(N v, uint64_t seed) noexcept {
+  return hash_internal::hash_one(v, numbers_internal::hash_seed(seed));
+}
+
+template <typename N, typename = hash_internal::enable_if_hashable_t<N>>
+void hash(const N *src, size_t count, uint64_t *dst) noexcept {
+  hash_internal::hash_batch(src, count, dst, numbers_internal::kHashDefaultSeed);
+}
+
+template <typename N, typename = hash_internal::enable_if_hashable_t<N>>
+void hash(const N *src, size_t count, uint64_t *dst, uint64_t seed) noexcept {
+  hash_internal::hash_batch(src, count, dst, numbers_internal::hash_seed(seed));
+}
+
+template <typename N>
+class seeded_hash {
+  static_assert(hash_internal::is_hashable_v<N>, "seeded_hash needs an integer type");
+
+ public:
+  explicit seeded_hash(uint64_t seed = 0) noexcept : seed_(numbers_internal::hash_seed(seed)) {}
+
+  size_t operator()(const N &v) const noexcept { return static_cast<size_t>(hash_internal::hash_one(v, seed_)); }
+
+ private:
+  uint64_t seed_;
+};
+
+}  // namespace numbers
+
+#endif
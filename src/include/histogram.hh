@@ -0,0 +1,184 @@
+#ifndef NUMBERS_HISTOGRAM_HH
+#define NUMBERS_HISTOGRAM_HH
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bits.hh"
+#include "integer.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Histograms
+//
+// `histogram` counts u64 values, such as latencies in nanoseconds, in a fixed
+// set of buckets whose width grows with the value, in the manner of
+// HdrHistogram. `precision` bits of every value are kept: the values below
+// 2^(precision + 1) each get a bucket of their own, and above that every power
+// of two is split into 2^precision linear sub-buckets, so a bucket is never
+// wider than 1/2^precision of the values in it. The bucket of a value is found
+// with one countl_zero and a shift, and all of u64 takes
+// (65 - precision) * 2^precision buckets, 7424 for the default precision of 7.
+//
+// Bucket counts are u64 and saturate rather than wrap. The total count and the
+// sum of the values are kept exactly in i128.
+//
+//   record(v), record(v, n)   counts `v` once, or `n` times
+//   merge(other)              adds the counts of a histogram of the same precision
+//   count(), sum(), mean()    the totals
+//   min(), max()              the exact extremes, 0 when empty
+//   percentile(p)             the highest value of the bucket holding the p-th
+//                             percentile, 0 <= p <= 100, clamped to max()
+//   serialize(), deserialize  a compact byte form: the non-empty buckets as
+//                             LEB128 varints of the gap to the previous one and
+//                             the count
+//
+// A histogram has one writer: record, reset and merging into it take no lock
+// and are not safe to call from two threads at once, so concurrent recorders
+// each keep their own histogram. Any thread may read a histogram while its
+// writer records, though, to query, serialize or merge it into another: the
+// fields are atomics that the writer updates with plain loads and stores, and
+// a sequence count lets a reader retry until it has the totals of one record.
+// The buckets it reads next may already hold a few later records.
+//
+//   thread_local numbers::histogram mine;  // registered with the reader once
+//   mine.record(numbers::u64(elapsed_ns));
+//   ...
+//   numbers::histogram all;  // on the reader
+//   for (const numbers::histogram *h : registered) all.merge(*h);
+//
+// Example:
+//
+//   numbers::histogram latencies;
+//   latencies.record(numbers::u64(elapsed_ns));
+//   numbers::u64 p99 = latencies.percentile(99.0);
+
+namespace histogram_internal {
+
+// An i128 stored by one thread and loaded by others, as two relaxed words;
+// the sequence count of the histogram tells whether a load saw one store.
+class relaxed_i128 {
+ public:
+  i128 load() const noexcept {
+    return i128(int128(make_uint128(hi_.load(std::memory_order_relaxed), lo_.load(std::memory_order_relaxed))));
+  }
+  void store(i128 v) noexcept {
+    const uint128 bits(static_cast<int128>(v));
+    lo_.store(uint128_low64(bits), std::memory_order_relaxed);
+    hi_.store(uint128_high64(bits), std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> lo_{0};
+  std::atomic<uint64_t> hi_{0};
+};
+
+}  // namespace histogram_internal
+
+class histogram {
+ public:
+  static constexpr int kDefaultPrecision = 7;
+  static constexpr int kMaxPrecision = 16;
+
+  // Throws std::runtime_error unless 1 <= precision <= kMaxPrecision.
+  explicit histogram(int precision = kDefaultPrecision) noexcept(false);
+  // Copying reads `other` as a reader does.
+  histogram(const histogram &other);
+  histogram &operator=(const histogram &other) = delete;
+
+  int precision() const noexcept { return precision_; }
+  size_t buckets() const noexcept { return counts_.size(); }
+
+  void record(u64 value) noexcept { record(value, u64(1)); }
+  void record(u64 value, u64 n) noexcept {
+    const uint64_t v = static_cast<uint64_t>(value);
+    std::atomic<uint64_t> &bucket = counts_[index(v)];
+    const uint64_t seq = begin_write();
+    bucket.store(static_cast<uint64_t>(u64(bucket.load(std::memory_order_relaxed)).saturating_add(n)),
+                 std::memory_order_relaxed);
+    count_.store(count_.load().saturating_add(i128(static_cast<uint64_t>(n))));
+    // a product of two u64 fits uint128, and only needs clamping to i128
+    const uint128 product = uint128(v) * static_cast<uint64_t>(n);
+    const i128 weighted(product > uint128(int128_max()) ? int128_max() : int128(product));
+    sum_.store(sum_.load().saturating_add(weighted));
+    if (n != u64(0)) {
+      if (v < min_.load(std::memory_order_relaxed)) {
+        min_.store(v, std::memory_order_relaxed);
+      }
+      if (v > max_.load(std::memory_order_relaxed)) {
+        max_.store(v, std::memory_order_relaxed);
+      }
+    }
+    end_write(seq);
+  }
+
+  // Throws std::runtime_error if the precisions differ.
+  void merge(const histogram &other) noexcept(false);
+  void reset() noexcept;
+
+  i128 count() const noexcept { return load_totals().count; }
+  i128 sum() const noexcept { return load_totals().sum; }
+  double mean() const noexcept;
+  u64 min() const noexcept;
+  u64 max() const noexcept { return u64(load_totals().max); }
+  u64 percentile(double p) const noexcept;
+
+  // The count of bucket `i` and the values it covers.
+  u64 bucket_count(size_t i) const noexcept { return u64(counts_[i].load(std::memory_order_relaxed)); }
+  u64 bucket_lowest(size_t i) const noexcept { return u64(lowest(i)); }
+  u64 bucket_highest(size_t i) const noexcept { return u64(highest(i)); }
+
+  std::vector<uint8_t> serialize() const;
+  // Throws std::runtime_error if `data` is not a serialized histogram.
+  static histogram deserialize(const uint8_t *data, size_t size) noexcept(false);
+
+ private:
+  // The values below 2^(precision + 1) index themselves; above that the value
+  // is shifted down to precision + 1 bits, whose top bit is always set, and the
+  // shift picks the run of 2^precision buckets.
+  size_t index(uint64_t v) const noexcept {
+    const int top = 63 - countl_zero(v | 1);
+    const int shift = top > precision_ ? top - precision_ : 0;
+    return (static_cast<size_t>(shift) << precision_) + static_cast<size_t>(v >> shift);
+  }
+
+  uint64_t lowest(size_t i) const noexcept;
+  uint64_t highest(size_t i) const noexcept;
+
+  // The sequence count is odd while the writer updates the fields.
+  uint64_t begin_write() noexcept {
+    const uint64_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+  }
+  void end_write(uint64_t seq) noexcept { seq_.store(seq + 2, std::memory_order_release); }
+
+  struct totals {
+    i128 count;
+    i128 sum;
+    uint64_t min;
+    uint64_t max;
+  };
+  // The totals after one record, retried while the writer is in the middle of one.
+  totals load_totals() const noexcept;
+
+  int precision_;
+  std::vector<std::atomic<uint64_t>> counts_;
+  std::atomic<uint64_t> seq_{0};
+  histogram_internal::relaxed_i128 count_;
+  histogram_internal::relaxed_i128 sum_;
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/histogram_impl.hh"
+#endif
+
+#endif
@@ -20,10 +20,13 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <string>
 
+#include "internal/bits.hh"
 #include "internal/config.h"
+#include "internal/hash.hh"
 
 #if defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
 #include <intrin.h>
@@ -49,9 +52,9 @@ class uint128 {
   constexpr uint128(unsigned __int128 v);
 #endif
 
-  explicit uint128(float v);
-  explicit uint128(double v);
-  explicit uint128(long double v);
+  constexpr explicit uint128(float v);
+  constexpr explicit uint128(double v);
+  constexpr explicit uint128(long double v);
 
   // Assignment operators from arithmetic types
   uint128 &operator=(int v);
@@ -83,9 +86,9 @@ class uint128 {
   constexpr explicit operator unsigned __int128() const;
 #endif
 
-  explicit operator float() const;
-  explicit operator double() const;
-  explicit operator long double() const;
+  constexpr explicit operator float() const;
+  constexpr explicit operator double() const;
+  constexpr explicit operator long double() const;
 
   // Trivial copy constructor, assignment operator and destructor.
 
@@ -142,8 +145,6 @@ class uint128 {
   uint64_t hi_;
 };
 
-std::ostream &operator<<(std::ostream &os, uint128 v);
-
 constexpr uint128 uint128_max() {
   return uint128((std::numeric_limits<uint64_t>::max)(), (std::numeric_limits<uint64_t>::max)());
 }
@@ -154,7 +155,8 @@ namespace std {
 template <>
 struct hash<numbers::uint128> {
   size_t operator()(const numbers::uint128 &obj) const {
-    return (std::hash<uint64_t>()(uint128_high64(obj)) << 1) ^ std::hash<uint64_t>()(uint128_low64(obj));
+    return static_cast<size_t>(numbers_internal::hash_words(uint128_low64(obj), uint128_high64(obj), sizeof(obj),
+                                                            numbers_internal::kHashDefaultSeed));
   }
 };
 
@@ -220,9 +222,9 @@ class int128 {
   constexpr explicit int128(unsigned __int128 v);
 #endif
 
-  explicit int128(float v);
-  explicit int128(double v);
-  explicit int128(long double v);
+  constexpr explicit int128(float v);
+  constexpr explicit int128(double v);
+  constexpr explicit int128(long double v);
 
   // Assignment operators from arithmetic types
   int128 &operator=(int v);
@@ -259,9 +261,9 @@ class int128 {
   constexpr explicit operator unsigned __int128() const;
 #endif
 
-  explicit operator float() const;
-  explicit operator double() const;
-  explicit operator long double() const;
+  constexpr explicit operator float() const;
+  constexpr explicit operator double() const;
+  constexpr explicit operator long double() const;
 
   // Trivial copy constructor, assignment operator and destructor.
 
@@ -334,8 +336,6 @@ class int128 {
 #endif
 };
 
-std::ostream &operator<<(std::ostream &os, int128 v);
-
 constexpr int128 int128_max() {
   return int128((std::numeric_limits<int64_t>::max)(), (std::numeric_limits<uint64_t>::max)());
 }
@@ -355,7 +355,8 @@ struct is_signed<numbers::int128> : std::true_type {};
 template <>
 struct hash<numbers::int128> {
   size_t operator()(const numbers::int128 &obj) const {
-    return std::hash<int64_t>()(int128_high64(obj) << 1) ^ std::hash<uint64_t>()(int128_low64(obj));
+    return static_cast<size_t>(numbers_internal::hash_words(int128_low64(obj), static_cast<uint64_t>(int128_high64(obj)),
+                                                            sizeof(obj), numbers_internal::kHashDefaultSeed));
   }
 };
 
@@ -427,9 +428,9 @@ constexpr uint128 operator<<(uint128 lhs, int amount);
 constexpr uint128 operator>>(uint128 lhs, int amount);
 constexpr uint128 operator+(uint128 lhs, uint128 rhs);
 constexpr uint128 operator-(uint128 lhs, uint128 rhs);
-uint128 operator*(uint128 lhs, uint128 rhs);
-uint128 operator/(uint128 lhs, uint128 rhs);
-uint128 operator%(uint128 lhs, uint128 rhs);
+constexpr uint128 operator*(uint128 lhs, uint128 rhs);
+constexpr uint128 operator/(uint128 lhs, uint128 rhs);
+constexpr uint128 operator%(uint128 lhs, uint128 rhs);
 
 inline uint128 &uint128::operator<<=(int amount) {
   *this = *this << amount;
@@ -536,16 +537,6 @@ constexpr uint128::operator __int128() const { return (static_cast<__int128>(hi_
 constexpr uint128::operator unsigned __int128() const { return (static_cast<unsigned __int128>(hi_) << 64) + lo_; }
 #endif
 
-// Conversion operators to floating point types.
-
-inline uint128::operator float() const { return static_cast<float>(lo_) + std::ldexp(static_cast<float>(hi_), 64); }
-
-inline uint128::operator double() const { return static_cast<double>(lo_) + std::ldexp(static_cast<double>(hi_), 64); }
-
-inline uint128::operator long double() const {
-  return static_cast<long double>(lo_) + std::ldexp(static_cast<long double>(hi_), 64);
-}
-
 // comparison operators
 
 constexpr bool operator==(uint128 lhs, uint128 rhs) {
@@ -703,26 +694,229 @@ constexpr uint128 operator-(uint128 lhs, uint128 rhs) {
 }
 
 // Ref https://en.wikipedia.org/wiki/Karatsuba_algorithm
-inline uint128 operator*(uint128 lhs, uint128 rhs) {
+constexpr uint128 operator*(uint128 lhs, uint128 rhs) {
 #ifdef NUMBERS_HAVE_INTRINSTIC_INT128
   return static_cast<unsigned __int128>(lhs) * static_cast<unsigned __int128>(rhs);
-#elif defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
-  uint64_t carry;
-  uint64_t low = _umul128(uint128_low64(lhs), uint128_low64(rhs), &carry);
-  return make_uint128(uint128_low64(lhs) * uint128_high64(rhs) + uint128_high64(lhs) * uint128_low64(rhs) + carry, low);
 #else
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC) && defined(NUMBERS_IS_CONSTANT_EVALUATED)
+  if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+    uint64_t carry = 0;
+    uint64_t low = _umul128(uint128_low64(lhs), uint128_low64(rhs), &carry);
+    return make_uint128(uint128_low64(lhs) * uint128_high64(rhs) + uint128_high64(lhs) * uint128_low64(rhs) + carry,
+                        low);
+  }
+#endif
   uint64_t a32 = uint128_low64(lhs) >> 32;
   uint64_t a00 = uint128_low64(lhs) & 0xffffffff;
   uint64_t b32 = uint128_low64(rhs) >> 32;
   uint64_t b00 = uint128_low64(rhs) & 0xffffffff;
   uint128 result = make_uint128(
       uint128_high64(lhs) * uint128_low64(rhs) + uint128_low64(lhs) * uint128_high64(rhs) + a32 * b32, a00 * b00);
-  result += uint128(a32 * b00) << 32;
-  result += uint128(a00 * b32) << 32;
+  result = result + (uint128(a32 * b00) << 32);
+  result = result + (uint128(a00 * b32) << 32);
   return result;
 #endif
 }
 
+namespace int128_internal {
+
+// The index of the most significant set bit of n, which must not be zero.
+constexpr int Fls128(uint128 n) {
+  if (uint64_t hi = uint128_high64(n)) {
+    return 127 - numbers_internal::constexpr_count_leading_zeroes64(hi);
+  }
+  const uint64_t low = uint128_low64(n);
+  assert(low != 0);
+  return 63 - numbers_internal::constexpr_count_leading_zeroes64(low);
+}
+
+// Long division/modulo for uint128
+constexpr void DivModImpl(uint128 dividend, uint128 divisor, uint128 *quotient_ret, uint128 *remainder_ret) {
+  assert(divisor != 0);
+
+#ifdef NUMBERS_HAVE_INTRINSTIC_INT128
+  // The compiler divides by 64-bit words, and turns a divisor known at the call
+  // site into a multiplication.
+  const auto native_dividend = static_cast<unsigned __int128>(dividend);
+  const auto native_divisor = static_cast<unsigned __int128>(divisor);
+  *quotient_ret = uint128(native_dividend / native_divisor);
+  *remainder_ret = uint128(native_dividend % native_divisor);
+#else
+  if (divisor > dividend) {
+    *quotient_ret = 0;
+    *remainder_ret = dividend;
+    return;
+  }
+
+  // Left aligns the MSB of the denominator and the dividend.
+  const int shift = Fls128(dividend) - Fls128(divisor);
+  uint128 denominator = divisor << shift;
+  uint128 quotient = 0;
+
+  for (int i = 0; i <= shift; ++i) {
+    quotient = quotient << 1;
+    if (dividend >= denominator) {
+      dividend = dividend - denominator;
+      quotient = quotient | 1;
+    }
+    denominator = denominator >> 1;
+  }
+
+  *quotient_ret = quotient;
+  *remainder_ret = dividend;
+#endif
+}
+
+// 2^64 as a floating point number; scaling by it is exact.
+template <typename T>
+inline constexpr T kTwo64 = static_cast<T>(18446744073709551616.0L);
+
+template <typename T>
+constexpr uint128 make_uint128_from_float(T v) {
+  static_assert(std::is_floating_point<T>::value, "");
+  // Undefined behavior if v is NaN or cannot fit into uint128
+  assert(v - v == 0 && v > -1 && (std::numeric_limits<T>::max_exponent <= 128 || v < kTwo64<T> * kTwo64<T>));
+
+#ifdef NUMBERS_IS_CONSTANT_EVALUATED
+  if constexpr (std::numeric_limits<T>::is_iec559 && (sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t))) {
+    if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+      // Reads the exponent and the significand straight from the bits and
+      // shifts the significand into place.
+      using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+      constexpr int kSignificandBits = std::numeric_limits<T>::digits - 1;
+      constexpr int kExponentBias = std::numeric_limits<T>::max_exponent - 1;
+      constexpr Bits kExponentMask = (Bits{1} << (sizeof(T) * 8 - 1 - kSignificandBits)) - 1;
+      Bits bits = 0;
+      std::memcpy(&bits, &v, sizeof(v));
+      const int exponent = static_cast<int>((bits >> kSignificandBits) & kExponentMask) - kExponentBias;
+      if (exponent < 0) {
+        // |v| < 1
+        return 0;
+      }
+      const uint128 significand =
+          uint128((bits & ((Bits{1} << kSignificandBits) - 1)) | (Bits{1} << kSignificandBits));
+      return exponent >= kSignificandBits ? significand << (exponent - kSignificandBits)
+                                          : significand >> (kSignificandBits - exponent);
+    }
+  }
+#endif
+  if (v >= kTwo64<T>) {
+    uint64_t hi = static_cast<uint64_t>(v / kTwo64<T>);
+    uint64_t lo = static_cast<uint64_t>(v - static_cast<T>(hi) * kTwo64<T>);
+    return make_uint128(hi, lo);
+  }
+  return make_uint128(0, static_cast<uint64_t>(v));
+}
+
+// Correctly rounded (to nearest, ties to even) conversion to a floating point type.
+template <typename T>
+constexpr T uint128_to_float(uint128 v) {
+  const uint64_t hi = uint128_high64(v);
+  const uint64_t lo = uint128_low64(v);
+  if (hi == 0) {
+    return static_cast<T>(lo);
+  }
+  if constexpr (std::numeric_limits<T>::digits < 64) {
+    // Keeps the top 64 bits and folds the rest into a sticky bit, which leaves
+    // the rounding decision of the 64-bit to T conversion unchanged, then
+    // scales by a power of two, which is exact.
+    const int shift = 64 - numbers_internal::constexpr_count_leading_zeroes64(hi);
+    const uint64_t top = shift == 64 ? hi : (hi << (64 - shift)) | (lo >> shift);
+    const uint64_t sticky = (shift == 64 ? lo : lo << (64 - shift)) != 0;
+    return static_cast<T>(top | sticky) * (static_cast<T>(uint64_t{1} << (shift - 1)) * 2);
+  } else {
+    // Both terms are exact, so the sum is rounded only once.
+    return static_cast<T>(lo) + static_cast<T>(hi) * kTwo64<T>;
+  }
+}
+
+// Writes the digits of value in base, least significant first, and returns
+// their number. Whole 64-bit chunks are peeled off with one 128-bit division
+// each, so the per-digit divisions are 64-bit ones.
+constexpr int reversed_digits(uint128 value, uint32_t base, char *digits) {
+  constexpr char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  uint64_t chunk = base;
+  int chunk_digits = 1;
+  while (chunk <= (std::numeric_limits<uint64_t>::max)() / base) {
+    chunk *= base;
+    ++chunk_digits;
+  }
+  int n = 0;
+  while (uint128_high64(value) != 0) {
+    uint128 quotient = 0;
+    uint128 remainder = 0;
+    DivModImpl(value, chunk, &quotient, &remainder);
+    uint64_t low = uint128_low64(remainder);
+    for (int k = 0; k < chunk_digits; ++k) {
+      digits[n++] = kDigits[low % base];
+      low /= base;
+    }
+    value = quotient;
+  }
+  uint64_t low = uint128_low64(value);
+  do {
+    digits[n++] = kDigits[low % base];
+    low /= base;
+  } while (low != 0);
+  return n;
+}
+
+// Copies the reversed digits behind the sign, or returns nullptr if they do not fit.
+constexpr char *write_chars(char *first, char *last, bool negative, const char *digits, int n) {
+  if (last - first < n + negative) {
+    return nullptr;
+  }
+  if (negative) {
+    *first++ = '-';
+  }
+  while (n > 0) {
+    *first++ = digits[--n];
+  }
+  return first;
+}
+
+}  // namespace int128_internal
+
+constexpr uint128 operator/(uint128 lhs, uint128 rhs) {
+  uint128 quotient = 0;
+  uint128 remainder = 0;
+  int128_internal::DivModImpl(lhs, rhs, &quotient, &remainder);
+  return quotient;
+}
+
+constexpr uint128 operator%(uint128 lhs, uint128 rhs) {
+  uint128 quotient = 0;
+  uint128 remainder = 0;
+  int128_internal::DivModImpl(lhs, rhs, &quotient, &remainder);
+  return remainder;
+}
+
+constexpr uint128::uint128(float v) : uint128(int128_internal::make_uint128_from_float(v)) {}
+constexpr uint128::uint128(double v) : uint128(int128_internal::make_uint128_from_float(v)) {}
+constexpr uint128::uint128(long double v) : uint128(int128_internal::make_uint128_from_float(v)) {}
+
+constexpr uint128::operator float() const { return int128_internal::uint128_to_float<float>(*this); }
+constexpr uint128::operator double() const { return int128_internal::uint128_to_float<double>(*this); }
+constexpr uint128::operator long double() const { return int128_internal::uint128_to_float<long double>(*this); }
+
+// to_chars()
+//
+// Writes the value in the given base, 2 to 36 with lowercase letters, to
+// [first, last) and returns the end of the text, or nullptr if it does not
+// fit, like std::to_chars. 40 characters hold any value in base 10, 130 in
+// base 2. It is constexpr, so tables of text can be made at compile time.
+//
+// Example:
+//
+//   char buf[40];
+//   char *end = numbers::to_chars(buf, buf + sizeof(buf), numbers::uint128_max());
+constexpr char *to_chars(char *first, char *last, uint128 value, int base = 10) {
+  assert(base >= 2 && base <= 36);
+  char digits[128] = {};
+  const int n = int128_internal::reversed_digits(value, static_cast<uint32_t>(base), digits);
+  return int128_internal::write_chars(first, last, false, digits, n);
+}
+
 // Increment/decrement operators
 inline uint128 uint128::operator++(int) {
   uint128 tmp(*this);
@@ -765,9 +959,9 @@ inline int128 &int128::operator=(unsigned long long v) { return *this = int128(v
 constexpr int128 operator-(int128 v);
 constexpr int128 operator+(int128 lhs, int128 rhs);
 constexpr int128 operator-(int128 lhs, int128 rhs);
-int128 operator*(int128 lhs, int128 rhs);
-int128 operator/(int128 lhs, int128 rhs);
-int128 operator%(int128 lhs, int128 rhs);
+constexpr int128 operator*(int128 lhs, int128 rhs);
+constexpr int128 operator/(int128 lhs, int128 rhs);
+constexpr int128 operator%(int128 lhs, int128 rhs);
 constexpr int128 operator|(int128 lhs, int128 rhs);
 constexpr int128 operator&(int128 lhs, int128 rhs);
 constexpr int128 operator^(int128 lhs, int128 rhs);
@@ -834,12 +1028,28 @@ constexpr int64_t BitCastToSigned(uint64_t v) {
 }
 }  // namespace int128_internal
 
+namespace int128_internal {
+constexpr uint128 UnsignedAbsoluteValue(int128 v) { return int128_high64(v) < 0 ? -uint128(v) : uint128(v); }
+}  // namespace int128_internal
+
 #ifdef NUMBERS_HAVE_INTRINSTIC_INT128
 #include "int128_have_intrinstic.inc"
 #else
 #include "int128_no_intrinstic.inc"
 #endif
 
+constexpr char *to_chars(char *first, char *last, int128 value, int base = 10) {
+  assert(base >= 2 && base <= 36);
+  char digits[128] = {};
+  const int n = int128_internal::reversed_digits(int128_internal::UnsignedAbsoluteValue(value),
+                                                 static_cast<uint32_t>(base), digits);
+  return int128_internal::write_chars(first, last, value < 0, digits, n);
+}
+
 }  // namespace numbers
 
-#endif
\ No newline at end of file
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/int128_impl.hh"
+#endif
+
+#endif
@@ -1,12 +1,15 @@
 #ifndef NUMBERS_INTEGER_HH
 #define NUMBERS_INTEGER_HH
 
-#include <iostream>
 #include <limits>
 #include <optional>
 #include <type_traits>
 #include "int128.hh"
 #include "internal/config.h"
+#include "internal/floating.hh"
+#include "internal/hash.hh"
+#include "internal/mixed.hh"
+#include "overflow.hh"
 
 namespace numbers {
 
@@ -28,15 +31,16 @@ class Integer {
   constexpr Integer() noexcept : num_{} {}
 
   template <typename U, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
-  Integer(U num) : num_{static_cast<T>(num)} {}
+  constexpr Integer(U num) : num_{static_cast<T>(num)} {}
 
-  Integer(float num) noexcept : num_{static_cast<T>(num)} {}
-  Integer(double num) noexcept : num_{static_cast<T>(num)} {}
-  Integer(long double num) noexcept : num_{static_cast<T>(num)} {}
+  // Truncates toward zero; NaN becomes 0 and out of range values saturate.
+  Integer(float num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
+  Integer(double num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
+  Integer(long double num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
 
   constexpr Integer operator+(Integer<T> other) const noexcept(false) {
     if (add_overflow(num_, other.num_)) {
-      throw std::runtime_error("add overflow");
+      report_add(other.num_);
     }
     return Integer(num_ + other.num_);
   }
@@ -64,7 +68,7 @@ class Integer {
 
   constexpr Integer operator-(const Integer<T> &other) const noexcept(false) {
     if (sub_overflow(num_, other.num_)) {
-      throw std::runtime_error("sub overflow");
+      report_sub(other.num_);
     }
     return Integer(num_ - other.num_);
   }
@@ -92,7 +96,7 @@ class Integer {
 
   constexpr Integer operator/(const Integer<T> &other) const noexcept(false) {
     if (div_overflow(num_, other.num_)) {
-      throw std::runtime_error("div overflow");
+      overflow_internal::report("div", num_, other.num_);
     }
     return Integer(num_ / other.num_);
   }
@@ -119,7 +123,7 @@ class Integer {
 
   constexpr Integer operator*(const Integer<T> &other) const noexcept(false) {
     if (mul_overflow(num_, other.num_)) {
-      throw std::runtime_error("mul overflow");
+      overflow_internal::report("mul", num_, other.num_);
     }
     return Integer(num_ * other.num_);
   }
@@ -148,7 +152,7 @@ class Integer {
 
   constexpr Integer abs() const noexcept(false) {
     if (num_ == min_) {
-      throw std::runtime_error("abs overflow");
+      overflow_internal::report_unary("abs", num_);
     }
     return Integer(is_positive(num_) ? num_ : -num_);
   }
@@ -183,7 +187,7 @@ class Integer {
 
   constexpr Integer operator-() const noexcept(false) {
     if (num_ == min_) {
-      throw std::runtime_error("neg overflow");
+      overflow_internal::report_unary("neg", num_);
     }
     return Integer(-num_);
   }
@@ -314,26 +318,53 @@ class Integer {
   }
 
   template <typename U, typename = std::enable_if<std::is_convertible_v<U, T>>>
-  explicit operator U() const noexcept {
+  constexpr explicit operator U() const noexcept {
     return static_cast<U>(num_);
   }
 
-  friend std::ostream &operator<<(std::ostream &os, const Integer<T> &num) {
-    if constexpr (std::is_same<T, int8_t>::value) {
-      os << static_cast<int16_t>(num.num_);
-    } else {
-      os << num.num_;
+ private:
+  // The builtins compile to the operation and a jump on the overflow flag.
+  constexpr bool add_overflow(T a, T b) const noexcept {
+#if NUMBERS_HAVE_BUILTIN(__builtin_add_overflow) || (defined(__GNUC__) && !defined(__clang__))
+    if constexpr (!std::is_same_v<T, int128>) {
+      T res{};
+      return __builtin_add_overflow(a, b, &res);
     }
-    return os;
+#endif
+    return has_same_signal(a, b) && !has_same_signal(a, a + b);
   }
 
- private:
-  constexpr bool add_overflow(T a, T b) const noexcept { return has_same_signal(a, b) && !has_same_signal(a, a + b); }
-
   constexpr bool sub_overflow(T minuend, T subtrahend) const noexcept {
+#if NUMBERS_HAVE_BUILTIN(__builtin_sub_overflow) || (defined(__GNUC__) && !defined(__clang__))
+    if constexpr (!std::is_same_v<T, int128>) {
+      T res{};
+      return __builtin_sub_overflow(minuend, subtrahend, &res);
+    }
+#endif
     return !has_same_signal(minuend, subtrahend) && !has_same_signal(minuend, minuend - subtrahend);
   }
 
+  // Report the overflow of `num_ + rhs` and `num_ - rhs` from the result
+  // wrapped around in the unsigned type, which the compiler takes from the add
+  // or sub it has just done, so that num_ need not be kept for the report.
+  [[noreturn]] void report_add(T rhs) const {
+    if constexpr (std::is_same_v<T, int128>) {
+      overflow_internal::report("add", num_, rhs);
+    } else {
+      using U = std::make_unsigned_t<T>;
+      overflow_internal::report_add(static_cast<T>(static_cast<U>(num_) + static_cast<U>(rhs)), rhs);
+    }
+  }
+
+  [[noreturn]] void report_sub(T rhs) const {
+    if constexpr (std::is_same_v<T, int128>) {
+      overflow_internal::report("sub", num_, rhs);
+    } else {
+      using U = std::make_unsigned_t<T>;
+      overflow_internal::report_sub(static_cast<T>(static_cast<U>(num_) - static_cast<U>(rhs)), rhs);
+    }
+  }
+
   constexpr bool div_overflow(T a, T b) const noexcept { return a == min_ && b == -1; }
 
   constexpr bool mul_overflow_helper(T a, T b) const {
@@ -378,7 +409,12 @@ constexpr Integer<T> &operator+=(Integer<T> lhs, Integer<T> rhs) noexcept(false)
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr Integer<T> operator+(U lhs, Integer<T> rhs) noexcept(false) {
-  return Integer<T>(lhs) + rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Integer<T>(numbers_internal::value_or_report(numbers_internal::mixed_add<T>(lhs, static_cast<T>(rhs)),
+                                                        "add", lhs, static_cast<T>(rhs)));
+  } else {
+    return Integer<T>(lhs) + rhs;
+  }
 }
 
 template <typename T>
@@ -389,7 +425,12 @@ constexpr Integer<T> &operator-=(Integer<T> lhs, Integer<T> rhs) noexcept(false)
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr Integer<T> operator-(U lhs, Integer<T> rhs) noexcept(false) {
-  return Integer<T>(lhs) - rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Integer<T>(numbers_internal::value_or_report(numbers_internal::mixed_sub<T>(lhs, static_cast<T>(rhs)),
+                                                        "sub", lhs, static_cast<T>(rhs)));
+  } else {
+    return Integer<T>(lhs) - rhs;
+  }
 }
 
 template <typename T>
@@ -400,7 +441,12 @@ constexpr Integer<T> &operator/=(Integer<T> lhs, Integer<T> rhs) noexcept(false)
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr Integer<T> operator/(U lhs, Integer<T> rhs) noexcept(false) {
-  return Integer<T>(lhs) / rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Integer<T>(numbers_internal::value_or_report(numbers_internal::mixed_div<T>(lhs, static_cast<T>(rhs)),
+                                                        "div", lhs, static_cast<T>(rhs)));
+  } else {
+    return Integer<T>(lhs) / rhs;
+  }
 }
 
 template <typename T>
@@ -411,7 +457,12 @@ constexpr Integer<T> &operator*=(Integer<T> lhs, Integer<T> rhs) noexcept(false)
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr Integer<T> operator*(U lhs, Integer<T> rhs) noexcept(false) {
-  return Integer<T>(lhs) * rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Integer<T>(numbers_internal::value_or_report(numbers_internal::mixed_mul<T>(lhs, static_cast<T>(rhs)),
+                                                        "mul", lhs, static_cast<T>(rhs)));
+  } else {
+    return Integer<T>(lhs) * rhs;
+  }
 }
 
 template <typename T>
@@ -422,7 +473,12 @@ constexpr Integer<T> &operator%=(Integer<T> lhs, Integer<T> rhs) noexcept(false)
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr Integer<T> operator%(U lhs, Integer<T> rhs) noexcept(false) {
-  return Integer<T>(lhs) % rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Integer<T>(numbers_internal::value_or_report(numbers_internal::mixed_rem<T>(lhs, static_cast<T>(rhs)),
+                                                        "rem", lhs, static_cast<T>(rhs)));
+  } else {
+    return Integer<T>(lhs) % rhs;
+  }
 }
 
 template <typename T>
@@ -437,27 +493,47 @@ constexpr bool operator!=(Integer<T> lhs, Integer<T> rhs) {
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr bool operator==(U lhs, Integer<T> rhs) noexcept {
-  return Integer<T>(lhs) == rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_equal(lhs, static_cast<T>(rhs));
+  } else {
+    return Integer<T>(lhs) == rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr bool operator>(U lhs, Integer<T> rhs) noexcept {
-  return Integer<T>(lhs) > rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_less(static_cast<T>(rhs), lhs);
+  } else {
+    return Integer<T>(lhs) > rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr bool operator>=(U lhs, Integer<T> rhs) noexcept {
-  return Integer<T>(lhs) >= rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return !numbers_internal::cmp_less(lhs, static_cast<T>(rhs));
+  } else {
+    return Integer<T>(lhs) >= rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr bool operator<(U lhs, Integer<T> rhs) noexcept {
-  return Integer<T>(lhs) < rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_less(lhs, static_cast<T>(rhs));
+  } else {
+    return Integer<T>(lhs) < rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
 constexpr bool operator<=(U lhs, Integer<T> rhs) noexcept {
-  return Integer<T>(lhs) <= rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return !numbers_internal::cmp_less(static_cast<T>(rhs), lhs);
+  } else {
+    return Integer<T>(lhs) <= rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
@@ -486,25 +562,36 @@ using i128 = Integer<int128>;
 namespace std {
 template <>
 struct hash<numbers::i8> {
-  size_t operator()(const numbers::i8 &obj) const { return std::hash<int8_t>()(static_cast<int8_t>(obj)); }
+  size_t operator()(const numbers::i8 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<int8_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::i16> {
-  size_t operator()(const numbers::i16 &obj) const { return std::hash<int16_t>()(static_cast<int16_t>(obj)); }
+  size_t operator()(const numbers::i16 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<int16_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::i32> {
-  size_t operator()(const numbers::i32 &obj) const { return std::hash<int32_t>()(static_cast<int32_t>(obj)); }
+  size_t operator()(const numbers::i32 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<int32_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::i64> {
-  size_t operator()(const numbers::i64 &obj) const { return std::hash<int64_t>()(static_cast<int64_t>(obj)); }
+  size_t operator()(const numbers::i64 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<int64_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
-// TODO hash collision
 template <>
 struct hash<numbers::i128> {
   size_t operator()(const numbers::i128 &obj) const {
@@ -514,4 +601,8 @@ struct hash<numbers::i128> {
 
 }  // namespace std
 
-#endif
\ No newline at end of file
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/integer_impl.hh"
+#endif
+
+#endif
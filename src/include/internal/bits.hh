@@ -100,6 +100,28 @@ inline int count_leading_zeroes64(uint64_t x) {
 #endif
 }
 
+// count_leading_zeroes64() for constant expressions, which takes the intrinsic
+// at run time wherever the compiler allows.
+constexpr int constexpr_count_leading_zeroes64(uint64_t x) {
+#if NUMBERS_INTERNAL_HAVE_BUILTIN_OR_GCC(__builtin_clzll)
+  return x == 0 ? 64 : __builtin_clzll(x);
+#else
+#ifdef NUMBERS_IS_CONSTANT_EVALUATED
+  if (!NUMBERS_IS_CONSTANT_EVALUATED()) {
+    return count_leading_zeroes64(x);
+  }
+#endif
+  int zeroes = 0;
+  for (int shift = 32; shift > 0; shift >>= 1) {
+    if ((x >> (64 - shift)) == 0) {
+      zeroes += shift;
+      x <<= shift;
+    }
+  }
+  return zeroes + (x == 0);
+#endif
+}
+
 template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
 inline int count_leading_zeroes(T x) {
   static_assert(is_power_of_two(std::numeric_limits<T>::digits), "T must be a power of two");
@@ -0,0 +1,147 @@
+#ifndef NUMBERS_INTERNAL_CAST_IMPL_HH
+#define NUMBERS_INTERNAL_CAST_IMPL_HH
+
+// The out-of-line definitions of cast.hh, compiled into the library by
+// src/numbers/cast.cc, or included by cast.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NUMBERS_CAST_SSE2 1
+#endif
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace numbers::cast_internal {
+
+template <typename To, typename From>
+bool saturate_scalar(const From *src, size_t count, To *dst) noexcept {
+  bool all = true;
+  for (size_t i = 0; i < count; ++i) {
+    const From v = src[i];
+    if (v < std::numeric_limits<To>::min()) {
+      dst[i] = std::numeric_limits<To>::min();
+      all = false;
+    } else if (v > std::numeric_limits<To>::max()) {
+      dst[i] = std::numeric_limits<To>::max();
+      all = false;
+    } else {
+      dst[i] = static_cast<To>(v);
+    }
+  }
+  return all;
+}
+
+#if defined(NUMBERS_CAST_SSE2)
+
+// Each iteration narrows two registers into one with a single pack
+// instruction, and collects the out of range lanes in `bad`: a lane is in
+// range exactly when widening its saturated value gives it back. The tail is
+// handled by the scalar loop.
+
+NUMBERS_IMPL_INLINE bool saturate_i32_to_i16(const int32_t *src, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+  __m128i bad = _mm_setzero_si128();
+  for (; i + 8 <= count; i += 8) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 4));
+    // packssdw
+    const __m128i packed = _mm_packs_epi32(lo, hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    const __m128i sign = _mm_srai_epi16(packed, 15);
+    bad = _mm_or_si128(bad, _mm_xor_si128(lo, _mm_unpacklo_epi16(packed, sign)));
+    bad = _mm_or_si128(bad, _mm_xor_si128(hi, _mm_unpackhi_epi16(packed, sign)));
+  }
+  const bool all = _mm_movemask_epi8(_mm_cmpeq_epi32(bad, _mm_setzero_si128())) == 0xFFFF;
+  return saturate_scalar(src + i, count - i, dst + i) && all;
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i32_to_u16(const int32_t *src, size_t count, uint16_t *dst) noexcept {
+  size_t i = 0;
+  __m128i bad = _mm_setzero_si128();
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= count; i += 8) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 4));
+#if defined(__SSE4_1__)
+    // packusdw
+    const __m128i packed = _mm_packus_epi32(lo, hi);
+#else
+    // SSE2 has no unsigned 32-bit pack: clamp below at 0, then shift the
+    // range down by 2^15 so that packssdw saturates at 65535, and shift back.
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16(static_cast<int16_t>(0x8000));
+    const __m128i lo_clamped = _mm_and_si128(lo, _mm_cmpgt_epi32(lo, zero));
+    const __m128i hi_clamped = _mm_and_si128(hi, _mm_cmpgt_epi32(hi, zero));
+    const __m128i packed =
+        _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(lo_clamped, bias32), _mm_sub_epi32(hi_clamped, bias32)), bias16);
+#endif
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    bad = _mm_or_si128(bad, _mm_xor_si128(lo, _mm_unpacklo_epi16(packed, zero)));
+    bad = _mm_or_si128(bad, _mm_xor_si128(hi, _mm_unpackhi_epi16(packed, zero)));
+  }
+  const bool all = _mm_movemask_epi8(_mm_cmpeq_epi32(bad, zero)) == 0xFFFF;
+  return saturate_scalar(src + i, count - i, dst + i) && all;
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i16_to_i8(const int16_t *src, size_t count, int8_t *dst) noexcept {
+  size_t i = 0;
+  __m128i bad = _mm_setzero_si128();
+  for (; i + 16 <= count; i += 16) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+    // packsswb
+    const __m128i packed = _mm_packs_epi16(lo, hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    const __m128i sign = _mm_cmpgt_epi8(_mm_setzero_si128(), packed);
+    bad = _mm_or_si128(bad, _mm_xor_si128(lo, _mm_unpacklo_epi8(packed, sign)));
+    bad = _mm_or_si128(bad, _mm_xor_si128(hi, _mm_unpackhi_epi8(packed, sign)));
+  }
+  const bool all = _mm_movemask_epi8(_mm_cmpeq_epi16(bad, _mm_setzero_si128())) == 0xFFFF;
+  return saturate_scalar(src + i, count - i, dst + i) && all;
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i16_to_u8(const int16_t *src, size_t count, uint8_t *dst) noexcept {
+  size_t i = 0;
+  __m128i bad = _mm_setzero_si128();
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= count; i += 16) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 8));
+    // packuswb
+    const __m128i packed = _mm_packus_epi16(lo, hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), packed);
+    bad = _mm_or_si128(bad, _mm_xor_si128(lo, _mm_unpacklo_epi8(packed, zero)));
+    bad = _mm_or_si128(bad, _mm_xor_si128(hi, _mm_unpackhi_epi8(packed, zero)));
+  }
+  const bool all = _mm_movemask_epi8(_mm_cmpeq_epi16(bad, zero)) == 0xFFFF;
+  return saturate_scalar(src + i, count - i, dst + i) && all;
+}
+
+#else
+
+NUMBERS_IMPL_INLINE bool saturate_i32_to_i16(const int32_t *src, size_t count, int16_t *dst) noexcept {
+  return saturate_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i32_to_u16(const int32_t *src, size_t count, uint16_t *dst) noexcept {
+  return saturate_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i16_to_i8(const int16_t *src, size_t count, int8_t *dst) noexcept {
+  return saturate_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE bool saturate_i16_to_u8(const int16_t *src, size_t count, uint8_t *dst) noexcept {
+  return saturate_scalar(src, count, dst);
+}
+
+#endif
+
+}  // namespace numbers::cast_internal
+
+#endif  // NUMBERS_INTERNAL_CAST_IMPL_HH
@@ -9,6 +9,39 @@
 #define NUMBERS_HAVE_BUILTIN(x) 0
 #endif  // __has_builtin
 
+// With NUMBERS_HEADER_ONLY the definitions that normally live in the library
+// are included by the public headers and marked inline, so that division,
+// formatting and the float conversions can be inlined at the call site.
+#ifdef NUMBERS_HEADER_ONLY
+#define NUMBERS_IMPL_INLINE inline
+#else
+#define NUMBERS_IMPL_INLINE
+#endif
+
+// NUMBERS_IS_CONSTANT_EVALUATED() tells a constexpr function whether it runs at
+// compile time, so that it can use intrinsics only at run time. It is left
+// undefined where the compiler can not tell.
+#if NUMBERS_INTERNAL_CPLUSPLUS_LANG >= 202002L
+#include <type_traits>
+#define NUMBERS_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif NUMBERS_HAVE_BUILTIN(__builtin_is_constant_evaluated) || (defined(__GNUC__) && __GNUC__ >= 9) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1928)
+#define NUMBERS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+// Marks the error reporting functions, so that the compiler moves them, and
+// the branches calling them, away from the hot code.
+#if defined(__GNUC__) || defined(__clang__)
+#define NUMBERS_COLD __attribute__((cold))
+#define NUMBERS_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define NUMBERS_COLD
+#define NUMBERS_NOINLINE __declspec(noinline)
+#else
+#define NUMBERS_COLD
+#define NUMBERS_NOINLINE
+#endif
+
 #ifdef NUMBERS_HAVE_INTRINSTIC_INT128
 #error NUMBERS_HAVE_INTRINSTIC_INT128 cannot be directly set
 #elif defined(__SIZEOF_INT128__)
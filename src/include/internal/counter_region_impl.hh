@@ -0,0 +1,230 @@
+#ifndef NUMBERS_INTERNAL_COUNTER_REGION_IMPL_HH
+#define NUMBERS_INTERNAL_COUNTER_REGION_IMPL_HH
+
+// The out-of-line definitions of counter_region.hh, compiled into the library by
+// src/numbers/counter_region.cc, or included by counter_region.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NUMBERS_COUNTER_REGION_MMAP 1
+#endif
+
+namespace numbers {
+
+namespace counter_region_internal {
+
+inline constexpr uint64_t kMagic = 0x6e756d6265727363ull;  // "numbersc"
+inline constexpr uint32_t kVersion = 1;
+inline constexpr size_t kCacheLine = 64;
+
+// The magic is stored last, so a region is only attached to once it is fully initialised.
+struct header {
+  std::atomic<uint64_t> magic;
+  uint32_t version;
+  uint32_t u128_slot_size;
+  uint64_t u64_slots;
+  uint64_t u128_slots;
+};
+
+static_assert(sizeof(header) <= kCacheLine, "the header must fit one cache line");
+static_assert(sizeof(atomic<u64>) == sizeof(uint64_t), "u64 slots must be 8 bytes");
+
+inline size_t align_up(size_t n, size_t alignment) noexcept { return (n + alignment - 1) / alignment * alignment; }
+
+inline size_t u128_offset(size_t u64_slots) noexcept {
+  return align_up(kCacheLine + u64_slots * sizeof(atomic<u64>), kCacheLine);
+}
+
+#if defined(NUMBERS_COUNTER_REGION_MMAP)
+
+inline size_t region_size(size_t u64_slots, size_t u128_slots) noexcept {
+  return u128_offset(u64_slots) + u128_slots * sizeof(atomic<u128>);
+}
+
+[[noreturn]] inline void fail(const char *what, const std::string &path) noexcept(false) {
+  const int err = errno;
+  throw std::runtime_error(std::string("counter_region ") + what + " " + path + ": " + std::strerror(err));
+}
+
+[[noreturn]] inline void bad_layout(const std::string &path) noexcept(false) {
+  throw std::runtime_error("counter_region layout mismatch: " + path);
+}
+
+inline void initialise(void *base, size_t u64_slots, size_t u128_slots) noexcept {
+  auto *head = new (base) header;
+  head->version = kVersion;
+  head->u128_slot_size = sizeof(atomic<u128>);
+  head->u64_slots = u64_slots;
+  head->u128_slots = u128_slots;
+  char *bytes = static_cast<char *>(base);
+  for (size_t i = 0; i < u64_slots; ++i) {
+    new (bytes + kCacheLine + i * sizeof(atomic<u64>)) atomic<u64>();
+  }
+  for (size_t i = 0; i < u128_slots; ++i) {
+    new (bytes + u128_offset(u64_slots) + i * sizeof(atomic<u128>)) atomic<u128>();
+  }
+  head->magic.store(kMagic, std::memory_order_release);
+}
+
+inline bool valid(const void *base, size_t size) noexcept {
+  if (size < kCacheLine) {
+    return false;
+  }
+  const auto *head = static_cast<const header *>(base);
+  return head->magic.load(std::memory_order_acquire) == kMagic && head->version == kVersion &&
+         head->u128_slot_size == sizeof(atomic<u128>) && head->u64_slots <= size && head->u128_slots <= size &&
+         region_size(head->u64_slots, head->u128_slots) <= size;
+}
+
+// Maps `size` bytes of `fd`, or of an anonymous segment for -1.
+inline void *map(int fd, size_t size) noexcept(false) {
+  const int flags = fd < 0 ? MAP_SHARED | MAP_ANONYMOUS : MAP_SHARED;
+  void *base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+  if (base == MAP_FAILED) {
+    fail("mmap", "");
+  }
+  return base;
+}
+
+class file {
+ public:
+  file(const std::string &path, int flags) noexcept(false) : fd_(::open(path.c_str(), flags, 0644)) {
+    if (fd_ < 0) {
+      fail("open", path);
+    }
+  }
+  file(const file &) = delete;
+  file &operator=(const file &) = delete;
+  ~file() { ::close(fd_); }
+
+  int fd() const noexcept { return fd_; }
+
+  size_t size() const noexcept(false) {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+      fail("fstat", "");
+    }
+    return static_cast<size_t>(st.st_size);
+  }
+
+ private:
+  int fd_;
+};
+
+#endif
+
+}  // namespace counter_region_internal
+
+NUMBERS_IMPL_INLINE counter_region::counter_region(void *base, size_t size, size_t u64_slots,
+                                                   size_t u128_slots) noexcept
+    : base_(base),
+      size_(size),
+      u64_slots_(u64_slots),
+      u128_slots_(u128_slots),
+      u64_(reinterpret_cast<atomic<u64> *>(static_cast<char *>(base) + counter_region_internal::kCacheLine)),
+      u128_(reinterpret_cast<atomic<u128> *>(static_cast<char *>(base) +
+                                             counter_region_internal::u128_offset(u64_slots))) {}
+
+NUMBERS_IMPL_INLINE counter_region::counter_region(counter_region &&other) noexcept
+    : base_(std::exchange(other.base_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      u64_slots_(std::exchange(other.u64_slots_, 0)),
+      u128_slots_(std::exchange(other.u128_slots_, 0)),
+      u64_(std::exchange(other.u64_, nullptr)),
+      u128_(std::exchange(other.u128_, nullptr)) {}
+
+NUMBERS_IMPL_INLINE counter_region &counter_region::operator=(counter_region &&other) noexcept {
+  counter_region tmp(std::move(other));
+  std::swap(base_, tmp.base_);
+  std::swap(size_, tmp.size_);
+  std::swap(u64_slots_, tmp.u64_slots_);
+  std::swap(u128_slots_, tmp.u128_slots_);
+  std::swap(u64_, tmp.u64_);
+  std::swap(u128_, tmp.u128_);
+  return *this;
+}
+
+#if defined(NUMBERS_COUNTER_REGION_MMAP)
+
+NUMBERS_IMPL_INLINE counter_region::~counter_region() {
+  if (base_ != nullptr) {
+    ::munmap(base_, size_);
+  }
+}
+
+NUMBERS_IMPL_INLINE counter_region counter_region::create(const std::string &path, size_t u64_slots,
+                                                          size_t u128_slots) noexcept(false) {
+  const counter_region_internal::file f(path, O_RDWR | O_CREAT);
+  const size_t size = counter_region_internal::region_size(u64_slots, u128_slots);
+  const size_t existing = f.size();
+  if (existing == 0) {
+    if (::ftruncate(f.fd(), static_cast<off_t>(size)) != 0) {
+      counter_region_internal::fail("ftruncate", path);
+    }
+    void *base = counter_region_internal::map(f.fd(), size);
+    counter_region_internal::initialise(base, u64_slots, u128_slots);
+    return counter_region(base, size, u64_slots, u128_slots);
+  }
+  counter_region ret = open(path);
+  if (ret.u64_slots() != u64_slots || ret.u128_slots() != u128_slots) {
+    counter_region_internal::bad_layout(path);
+  }
+  return ret;
+}
+
+NUMBERS_IMPL_INLINE counter_region counter_region::open(const std::string &path) noexcept(false) {
+  const counter_region_internal::file f(path, O_RDWR);
+  const size_t size = f.size();
+  if (size < counter_region_internal::kCacheLine) {
+    counter_region_internal::bad_layout(path);
+  }
+  void *base = counter_region_internal::map(f.fd(), size);
+  if (!counter_region_internal::valid(base, size)) {
+    ::munmap(base, size);
+    counter_region_internal::bad_layout(path);
+  }
+  const auto *head = static_cast<const counter_region_internal::header *>(base);
+  return counter_region(base, size, head->u64_slots, head->u128_slots);
+}
+
+NUMBERS_IMPL_INLINE counter_region counter_region::anonymous(size_t u64_slots, size_t u128_slots) noexcept(false) {
+  const size_t size = counter_region_internal::region_size(u64_slots, u128_slots);
+  void *base = counter_region_internal::map(-1, size);
+  counter_region_internal::initialise(base, u64_slots, u128_slots);
+  return counter_region(base, size, u64_slots, u128_slots);
+}
+
+#else
+
+NUMBERS_IMPL_INLINE counter_region::~counter_region() = default;
+
+NUMBERS_IMPL_INLINE counter_region counter_region::create(const std::string &, size_t, size_t) noexcept(false) {
+  throw std::runtime_error("counter_region is not supported on this platform");
+}
+
+NUMBERS_IMPL_INLINE counter_region counter_region::open(const std::string &) noexcept(false) {
+  throw std::runtime_error("counter_region is not supported on this platform");
+}
+
+NUMBERS_IMPL_INLINE counter_region counter_region::anonymous(size_t, size_t) noexcept(false) {
+  throw std::runtime_error("counter_region is not supported on this platform");
+}
+
+#endif
+
+}  // namespace numbers
+
+#endif  // NUMBERS_INTERNAL_COUNTER_REGION_IMPL_HH
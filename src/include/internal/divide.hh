@@ -0,0 +1,151 @@
+#ifndef NUMBERS_INTERNAL_DIVIDE_HH
+#define NUMBERS_INTERNAL_DIVIDE_HH
+
+#include <cstdint>
+
+#include "int128.hh"
+#include "internal/bits.hh"
+#include "internal/wide.hh"
+
+namespace numbers_internal {
+
+// Division of unsigned integers of up to 256 bits by divisors of up to 128
+// bits, on 64-bit words. The library's uint128 division works a bit at a
+// time; these take one multiplication per word for divisors below 2^64, and
+// Knuth's algorithm D above that.
+
+// An unsigned magnitude of up to 256 bits, least significant word first.
+struct magnitude256 {
+  uint64_t w[4];
+};
+
+// Divides u1:u0 by `d`, whose top bit is set, for u1 < d, given
+// v = (2^128 - 1) / d - 2^64. One multiplication and at most two corrections,
+// as in Moller and Granlund, "Improved division by invariant integers".
+inline uint64_t divide_2by1(uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t &r) noexcept {
+  const numbers::uint128 q = numbers::uint128(v) * u1 + numbers::make_uint128(u1 + 1, u0);
+  uint64_t q1 = numbers::uint128_high64(q);
+  r = u0 - q1 * d;
+  if (r > numbers::uint128_low64(q)) {
+    --q1;
+    r += d;
+  }
+  if (r >= d) {
+    ++q1;
+    r -= d;
+  }
+  return q1;
+}
+
+// Divides `m` in place by `d` < 2^64 given its normalising shift and
+// reciprocal, and returns the remainder. The dividend is shifted along with
+// the divisor word by word.
+inline uint64_t divide_words(magnitude256 &m, uint64_t d, int shift, uint64_t v) noexcept {
+  const uint64_t dn = d << shift;
+  int top = 3;
+  while (top > 0 && m.w[top] == 0) {
+    --top;
+  }
+  uint64_t r = shift == 0 ? 0 : m.w[top] >> (64 - shift);
+  for (int i = top; i >= 0; --i) {
+    const uint64_t u0 = shift == 0 ? m.w[i] : (m.w[i] << shift) | (i > 0 ? m.w[i - 1] >> (64 - shift) : 0);
+    m.w[i] = divide_2by1(r, u0, dn, v, r);
+  }
+  return r >> shift;
+}
+
+// (u1:u0) / d for u1 < d, with the hardware division where there is one; only
+// used to set up the reciprocals of divisors known at run time.
+inline uint64_t divide_2by1_slow(uint64_t u1, uint64_t u0, uint64_t d, uint64_t &r) noexcept {
+#ifdef NUMBERS_HAVE_INTRINSTIC_INT128
+  const uint64_t q = static_cast<uint64_t>(((static_cast<unsigned __int128>(u1) << 64) | u0) / d);
+#else
+  const uint64_t q = numbers::uint128_low64(numbers::make_uint128(u1, u0) / d);
+#endif
+  r = u0 - q * d;
+  return q;
+}
+
+// (2^128 - 1) / d - 2^64 for `d` with its top bit set, which is (~d:~0) / d.
+inline uint64_t reciprocal(uint64_t d) noexcept {
+  uint64_t r;
+  return divide_2by1_slow(~d, ~uint64_t{0}, d, r);
+}
+
+// Divides `m` in place by any non-zero `d` and returns the remainder. A
+// divisor of two words is Knuth's algorithm D, with the quotient digits
+// estimated from the top divisor word.
+inline numbers::uint128 divide(magnitude256 &m, numbers::uint128 d) noexcept {
+  const uint64_t d1 = numbers::uint128_high64(d);
+  if (d1 == 0) {
+    const uint64_t d0 = numbers::uint128_low64(d);
+    const int shift = count_leading_zeroes(d0);
+    return divide_words(m, d0, shift, reciprocal(d0 << shift));
+  }
+
+  const int shift = count_leading_zeroes(d1);
+  const numbers::uint128 dn = d << shift;
+  const uint64_t v1 = numbers::uint128_high64(dn);
+  const uint64_t v0 = numbers::uint128_low64(dn);
+  const uint64_t inverse = reciprocal(v1);
+  uint64_t u[5];
+  u[4] = shift == 0 ? 0 : m.w[3] >> (64 - shift);
+  for (int i = 3; i >= 0; --i) {
+    u[i] = shift == 0 ? m.w[i] : (m.w[i] << shift) | (i > 0 ? m.w[i - 1] >> (64 - shift) : 0);
+  }
+
+  magnitude256 q{{0, 0, 0, 0}};
+  for (int j = 2; j >= 0; --j) {
+    // qhat is at most two too large
+    uint64_t qhat;
+    uint64_t rhat;
+    bool rhat_overflow = false;
+    if (u[j + 2] >= v1) {
+      qhat = ~uint64_t{0};
+      rhat = u[j + 1] + v1;
+      rhat_overflow = rhat < v1;
+    } else {
+      qhat = divide_2by1(u[j + 2], u[j + 1], v1, inverse, rhat);
+    }
+    while (!rhat_overflow && numbers::uint128(qhat) * v0 > numbers::make_uint128(rhat, u[j])) {
+      --qhat;
+      rhat += v1;
+      rhat_overflow = rhat < v1;
+    }
+
+    // u[j..j+2] -= qhat * dn, adding dn back once if that went below zero
+    const numbers::uint128 p0 = numbers::uint128(qhat) * v0;
+    const numbers::uint128 p1 = numbers::uint128(qhat) * v1 + numbers::uint128_high64(p0);
+    uint64_t borrow = u[j] < numbers::uint128_low64(p0);
+    u[j] -= numbers::uint128_low64(p0);
+    const uint64_t mid = u[j + 1] - numbers::uint128_low64(p1);
+    const uint64_t mid_borrow = (u[j + 1] < numbers::uint128_low64(p1)) | (mid < borrow);
+    u[j + 1] = mid - borrow;
+    borrow = mid_borrow;
+    const uint64_t top = u[j + 2] - numbers::uint128_high64(p1);
+    const bool negative = (u[j + 2] < numbers::uint128_high64(p1)) | (top < borrow);
+    u[j + 2] = top - borrow;
+    if (negative) {
+      --qhat;
+      const numbers::uint128 low = numbers::make_uint128(u[j + 1], u[j]) + dn;
+      u[j + 2] += low < dn;
+      u[j] = numbers::uint128_low64(low);
+      u[j + 1] = numbers::uint128_high64(low);
+    }
+    q.w[j] = qhat;
+  }
+  m = q;
+  return numbers::make_uint128(u[1], u[0]) >> shift;
+}
+
+// The full product of the low 128 bits of `a` and `b`.
+inline magnitude256 multiply(const magnitude256 &a, const magnitude256 &b) noexcept {
+  using wide = wide256<false>;
+  const wide p =
+      wide::from(numbers::make_uint128(a.w[1], a.w[0])) * wide::from(numbers::make_uint128(b.w[1], b.w[0]));
+  return {{p.word(0), p.word(1), p.word(2), p.word(3)}};
+}
+
+}  // namespace numbers_internal
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef NUMBERS_INTERNAL_FIXED_IMPL_HH
+#define NUMBERS_INTERNAL_FIXED_IMPL_HH
+
+// The out-of-line definitions of fixed.hh, compiled into the library by
+// src/numbers/fixed.cc, or included by fixed.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NUMBERS_FIXED_SSE2 1
+#endif
+
+// The SSSE3 and AVX2 kernels are compiled for their instruction sets with
+// target attributes, and only called when the CPU reports them.
+#if defined(NUMBERS_FIXED_SSE2) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NUMBERS_FIXED_DISPATCH 1
+#endif
+
+namespace numbers::fixed_internal {
+
+enum class level { scalar, sse2, ssse3, avx2 };
+
+inline level detect() noexcept {
+#if defined(NUMBERS_FIXED_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return level::avx2;
+  }
+  if (__builtin_cpu_supports("ssse3")) {
+    return level::ssse3;
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  return level::sse2;
+#else
+  return level::scalar;
+#endif
+}
+
+inline level cpu() noexcept {
+  static const level ret = detect();
+  return ret;
+}
+
+// The scalar kernels, which also handle the tails of the SIMD loops.
+
+template <typename T>
+T saturate(int64_t v) noexcept {
+  return static_cast<T>(v < std::numeric_limits<T>::min()   ? std::numeric_limits<T>::min()
+                        : v > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max()
+                                                            : v);
+}
+
+template <typename T>
+void add_scalar(const T *a, const T *b, size_t count, T *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = saturate<T>(int64_t{a[i]} + b[i]);
+  }
+}
+
+inline int16_t mul_q15(int16_t a, int16_t b) noexcept {
+  return saturate<int16_t>((int32_t{a} * b + 0x4000) >> 15);
+}
+
+inline void mul_scalar(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = mul_q15(a[i], b[i]);
+  }
+}
+
+inline void mac_scalar(int16_t *acc, const int16_t *a, const int16_t *b, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    acc[i] = saturate<int16_t>(int32_t{acc[i]} + mul_q15(a[i], b[i]));
+  }
+}
+
+template <typename T>
+void from_float_scalar(const float *src, size_t count, float scale, T *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = numbers_internal::saturating_from_float<T>(std::nearbyint(src[i] * scale));
+  }
+}
+
+#if defined(NUMBERS_FIXED_SSE2)
+
+// Each kernel handles whole registers and leaves the tail to the scalar loop.
+
+inline __m128i load(const void *p) noexcept { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+inline void store(void *p, __m128i v) noexcept { _mm_storeu_si128(static_cast<__m128i *>(p), v); }
+
+inline size_t add_i16_sse2(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    // paddsw
+    store(dst + i, _mm_adds_epi16(load(a + i), load(b + i)));
+  }
+  return i;
+}
+
+// There is no saturating 32-bit add: a lane overflowed if the sum's sign
+// differs from both operands' signs, and then it takes MAX, or MIN when `a`
+// is negative.
+inline __m128i adds_epi32(__m128i a, __m128i b) noexcept {
+  const __m128i sum = _mm_add_epi32(a, b);
+  const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(sum, a), _mm_xor_si128(sum, b)), 31);
+  const __m128i limit = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(INT32_MAX));
+  return _mm_or_si128(_mm_andnot_si128(overflow, sum), _mm_and_si128(overflow, limit));
+}
+
+inline size_t add_i32_sse2(const int32_t *a, const int32_t *b, size_t count, int32_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    store(dst + i, adds_epi32(load(a + i), load(b + i)));
+  }
+  return i;
+}
+
+// -1 * -1 is the only product out of range, and comes out as -1; flipping all
+// of its bits gives MAX.
+inline __m128i fix_q15(__m128i product, __m128i a, __m128i b) noexcept {
+  const __m128i min = _mm_set1_epi16(INT16_MIN);
+  return _mm_xor_si128(product, _mm_and_si128(_mm_cmpeq_epi16(a, min), _mm_cmpeq_epi16(b, min)));
+}
+
+// pmulhrsw from SSE2: bits 15 to 30 of the 32-bit product, plus bit 14 to round.
+inline __m128i mulhrs_sse2(__m128i a, __m128i b) noexcept {
+  const __m128i hi = _mm_mulhi_epi16(a, b);
+  const __m128i lo = _mm_mullo_epi16(a, b);
+  const __m128i round = _mm_and_si128(_mm_srli_epi16(lo, 14), _mm_set1_epi16(1));
+  return _mm_add_epi16(_mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15)), round);
+}
+
+inline size_t mul_q15_sse2(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i x = load(a + i);
+    const __m128i y = load(b + i);
+    store(dst + i, fix_q15(mulhrs_sse2(x, y), x, y));
+  }
+  return i;
+}
+
+inline size_t mac_q15_sse2(int16_t *acc, const int16_t *a, const int16_t *b, size_t count) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i x = load(a + i);
+    const __m128i y = load(b + i);
+    store(acc + i, _mm_adds_epi16(load(acc + i), fix_q15(mulhrs_sse2(x, y), x, y)));
+  }
+  return i;
+}
+
+// Scales, turns NaN into 0, and converts with cvtps2dq, which rounds to the
+// nearest, ties to even.
+inline __m128 scale_ps(const float *src, __m128 scale) noexcept {
+  const __m128 v = _mm_mul_ps(_mm_loadu_ps(src), scale);
+  return _mm_and_ps(v, _mm_cmpord_ps(v, v));
+}
+
+inline size_t from_f32_to_i16_sse2(const float *src, size_t count, float scale, int16_t *dst) noexcept {
+  const __m128 factor = _mm_set1_ps(scale);
+  const __m128 lo = _mm_set1_ps(-32768.0f);
+  const __m128 hi = _mm_set1_ps(32767.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i first = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scale_ps(src + i, factor), lo), hi));
+    const __m128i second = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scale_ps(src + i + 4, factor), lo), hi));
+    // packssdw
+    store(dst + i, _mm_packs_epi32(first, second));
+  }
+  return i;
+}
+
+// cvtps2dq gives INT32_MIN for values from 2^31 up, which flipping all bits turns into INT32_MAX.
+inline __m128i cvtps_epi32_saturated(__m128 v) noexcept {
+  const __m128 too_big = _mm_cmpge_ps(v, _mm_set1_ps(2147483648.0f));
+  return _mm_xor_si128(_mm_cvtps_epi32(v), _mm_castps_si128(too_big));
+}
+
+inline size_t from_f32_to_i32_sse2(const float *src, size_t count, float scale, int32_t *dst) noexcept {
+  const __m128 factor = _mm_set1_ps(scale);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    store(dst + i, cvtps_epi32_saturated(scale_ps(src + i, factor)));
+  }
+  return i;
+}
+
+#endif
+
+#if defined(NUMBERS_FIXED_DISPATCH)
+
+#define NUMBERS_FIXED_SSSE3 __attribute__((target("ssse3")))
+#define NUMBERS_FIXED_AVX2 __attribute__((target("avx2")))
+
+inline NUMBERS_FIXED_SSSE3 size_t mul_q15_ssse3(const int16_t *a, const int16_t *b, size_t count,
+                                                int16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i x = load(a + i);
+    const __m128i y = load(b + i);
+    // pmulhrsw
+    store(dst + i, fix_q15(_mm_mulhrs_epi16(x, y), x, y));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_SSSE3 size_t mac_q15_ssse3(int16_t *acc, const int16_t *a, const int16_t *b,
+                                                size_t count) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m128i x = load(a + i);
+    const __m128i y = load(b + i);
+    store(acc + i, _mm_adds_epi16(load(acc + i), fix_q15(_mm_mulhrs_epi16(x, y), x, y)));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 __m256i load256(const void *p) noexcept {
+  return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+inline NUMBERS_FIXED_AVX2 void store256(void *p, __m256i v) noexcept {
+  _mm256_storeu_si256(static_cast<__m256i *>(p), v);
+}
+
+inline NUMBERS_FIXED_AVX2 __m256i fix_q15_avx2(__m256i product, __m256i a, __m256i b) noexcept {
+  const __m256i min = _mm256_set1_epi16(INT16_MIN);
+  return _mm256_xor_si256(product, _mm256_and_si256(_mm256_cmpeq_epi16(a, min), _mm256_cmpeq_epi16(b, min)));
+}
+
+inline NUMBERS_FIXED_AVX2 size_t add_i16_avx2(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    store256(dst + i, _mm256_adds_epi16(load256(a + i), load256(b + i)));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 size_t add_i32_avx2(const int32_t *a, const int32_t *b, size_t count, int32_t *dst) noexcept {
+  const __m256i max = _mm256_set1_epi32(INT32_MAX);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i x = load256(a + i);
+    const __m256i y = load256(b + i);
+    const __m256i sum = _mm256_add_epi32(x, y);
+    const __m256i overflow = _mm256_and_si256(_mm256_xor_si256(sum, x), _mm256_xor_si256(sum, y));
+    const __m256i limit = _mm256_xor_si256(_mm256_srai_epi32(x, 31), max);
+    // vblendvps picks by the sign bit of `overflow`
+    store256(dst + i, _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sum), _mm256_castsi256_ps(limit),
+                                                           _mm256_castsi256_ps(overflow))));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 size_t mul_q15_avx2(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i x = load256(a + i);
+    const __m256i y = load256(b + i);
+    store256(dst + i, fix_q15_avx2(_mm256_mulhrs_epi16(x, y), x, y));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 size_t mac_q15_avx2(int16_t *acc, const int16_t *a, const int16_t *b, size_t count) noexcept {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i x = load256(a + i);
+    const __m256i y = load256(b + i);
+    store256(acc + i, _mm256_adds_epi16(load256(acc + i), fix_q15_avx2(_mm256_mulhrs_epi16(x, y), x, y)));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 __m256 scale_ps_avx2(const float *src, __m256 scale) noexcept {
+  const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src), scale);
+  return _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+}
+
+inline NUMBERS_FIXED_AVX2 size_t from_f32_to_i16_avx2(const float *src, size_t count, float scale,
+                                                      int16_t *dst) noexcept {
+  const __m256 factor = _mm256_set1_ps(scale);
+  const __m256 lo = _mm256_set1_ps(-32768.0f);
+  const __m256 hi = _mm256_set1_ps(32767.0f);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256i first = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(scale_ps_avx2(src + i, factor), lo), hi));
+    const __m256i second =
+        _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(scale_ps_avx2(src + i + 8, factor), lo), hi));
+    // vpackssdw packs within each 128-bit half, so the quarters are put back in order
+    store256(dst + i, _mm256_permute4x64_epi64(_mm256_packs_epi32(first, second), 0xd8));
+  }
+  return i;
+}
+
+inline NUMBERS_FIXED_AVX2 size_t from_f32_to_i32_avx2(const float *src, size_t count, float scale,
+                                                      int32_t *dst) noexcept {
+  const __m256 factor = _mm256_set1_ps(scale);
+  const __m256 limit = _mm256_set1_ps(2147483648.0f);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 v = scale_ps_avx2(src + i, factor);
+    const __m256 too_big = _mm256_cmp_ps(v, limit, _CMP_GE_OQ);
+    store256(dst + i, _mm256_xor_si256(_mm256_cvtps_epi32(v), _mm256_castps_si256(too_big)));
+  }
+  return i;
+}
+
+#endif
+
+NUMBERS_IMPL_INLINE void saturating_add_i16(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = add_i16_avx2(a, b, count, dst);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += add_i16_sse2(a + i, b + i, count - i, dst + i);
+#endif
+  add_scalar(a + i, b + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void saturating_add_i32(const int32_t *a, const int32_t *b, size_t count, int32_t *dst) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = add_i32_avx2(a, b, count, dst);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += add_i32_sse2(a + i, b + i, count - i, dst + i);
+#endif
+  add_scalar(a + i, b + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void saturating_mul_q15(const int16_t *a, const int16_t *b, size_t count, int16_t *dst) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = mul_q15_avx2(a, b, count, dst);
+  }
+  if (cpu() >= level::ssse3) {
+    i += mul_q15_ssse3(a + i, b + i, count - i, dst + i);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += mul_q15_sse2(a + i, b + i, count - i, dst + i);
+#endif
+  mul_scalar(a + i, b + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void saturating_mac_q15(int16_t *acc, const int16_t *a, const int16_t *b, size_t count) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = mac_q15_avx2(acc, a, b, count);
+  }
+  if (cpu() >= level::ssse3) {
+    i += mac_q15_ssse3(acc + i, a + i, b + i, count - i);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += mac_q15_sse2(acc + i, a + i, b + i, count - i);
+#endif
+  mac_scalar(acc + i, a + i, b + i, count - i);
+}
+
+NUMBERS_IMPL_INLINE void from_f32_to_i16(const float *src, size_t count, float scale, int16_t *dst) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = from_f32_to_i16_avx2(src, count, scale, dst);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += from_f32_to_i16_sse2(src + i, count - i, scale, dst + i);
+#endif
+  from_float_scalar(src + i, count - i, scale, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void from_f32_to_i32(const float *src, size_t count, float scale, int32_t *dst) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_FIXED_DISPATCH)
+  if (cpu() == level::avx2) {
+    i = from_f32_to_i32_avx2(src, count, scale, dst);
+  }
+#endif
+#if defined(NUMBERS_FIXED_SSE2)
+  i += from_f32_to_i32_sse2(src + i, count - i, scale, dst + i);
+#endif
+  from_float_scalar(src + i, count - i, scale, dst + i);
+}
+
+}  // namespace numbers::fixed_internal
+
+#endif  // NUMBERS_INTERNAL_FIXED_IMPL_HH
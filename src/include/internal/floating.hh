@@ -0,0 +1,73 @@
+#ifndef NUMBERS_INTERNAL_FLOATING_HH
+#define NUMBERS_INTERNAL_FLOATING_HH
+
+#include <limits>
+#include <type_traits>
+
+#include "int128.hh"
+
+// Range checks for floating point to integer conversions, which truncate
+// toward zero like static_cast. All the bounds are powers of two (or one less
+// than a power of two) computed at compile time, so a check is two
+// comparisons.
+namespace numbers_internal {
+
+// 2^exp, or infinity if it is out of the range of `F`.
+template <typename F>
+constexpr F float_power_of_two(int exp) noexcept {
+  if (exp >= std::numeric_limits<F>::max_exponent) {
+    return std::numeric_limits<F>::infinity();
+  }
+  F ret = 1;
+  for (int i = 0; i < exp; ++i) {
+    ret *= 2;
+  }
+  return ret;
+}
+
+// `v` truncates to a value at or above the minimum of `T`.
+template <typename T, typename F>
+constexpr bool float_above_min(F v) noexcept {
+  if constexpr (!std::numeric_limits<T>::is_signed) {
+    return v > F(-1);
+  } else if constexpr (std::numeric_limits<T>::digits < std::numeric_limits<F>::digits) {
+    // MIN - 1 is exact
+    constexpr F below_min = -float_power_of_two<F>(std::numeric_limits<T>::digits) - 1;
+    return v > below_min;
+  } else {
+    // every float around MIN is an integer
+    constexpr F min = -float_power_of_two<F>(std::numeric_limits<T>::digits);
+    return v >= min;
+  }
+}
+
+// `v` truncates to a value at or below the maximum of `T`.
+template <typename T, typename F>
+constexpr bool float_below_max(F v) noexcept {
+  constexpr F above_max = float_power_of_two<F>(std::numeric_limits<T>::digits);
+  return v < above_max;
+}
+
+// Returns true if `v` is not NaN and truncates to a value representable by `T`.
+template <typename T, typename F>
+constexpr bool float_fits(F v) noexcept {
+  return float_above_min<T>(v) && float_below_max<T>(v);
+}
+
+// Truncates `v` toward zero, clamping out of range values to the bounds of
+// `T` and NaN to 0, like the Rust `as` operator.
+template <typename T, typename F>
+T saturating_from_float(F v) noexcept {
+  if (!float_below_max<T>(v)) {
+    // NaN compares false as well
+    return v != v ? T(0) : std::numeric_limits<T>::max();
+  }
+  if (!float_above_min<T>(v)) {
+    return v != v ? T(0) : std::numeric_limits<T>::min();
+  }
+  return static_cast<T>(v);
+}
+
+}  // namespace numbers_internal
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef NUMBERS_INTERNAL_FLOATING_IMPL_HH
+#define NUMBERS_INTERNAL_FLOATING_IMPL_HH
+
+// The out-of-line definitions of floating.hh, compiled into the library by
+// src/numbers/floating.cc, or included by floating.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NUMBERS_FLOATING_SSE2 1
+#endif
+
+namespace numbers::floating_internal {
+
+template <typename F>
+void saturate_scalar(const F *src, size_t count, int32_t *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = numbers_internal::saturating_from_float<int32_t>(src[i]);
+  }
+}
+
+template <typename F>
+void convert_scalar(const int32_t *src, size_t count, F *dst) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = static_cast<F>(src[i]);
+  }
+}
+
+#if defined(NUMBERS_FLOATING_SSE2)
+
+// cvttps2dq and cvttpd2dq return 0x80000000 for NaN and out of range lanes,
+// which is already right for large negative values. Lanes at or above 2^31
+// are flipped to 0x7FFFFFFF and NaN lanes are cleared afterwards.
+
+NUMBERS_IMPL_INLINE void saturate_f32_to_i32(const float *src, size_t count, int32_t *dst) noexcept {
+  size_t i = 0;
+  const __m128 limit = _mm_set1_ps(2147483648.0f);
+  for (; i + 4 <= count; i += 4) {
+    const __m128 v = _mm_loadu_ps(src + i);
+    __m128i ret = _mm_cvttps_epi32(v);
+    ret = _mm_xor_si128(ret, _mm_castps_si128(_mm_cmpge_ps(v, limit)));
+    ret = _mm_andnot_si128(_mm_castps_si128(_mm_cmpunord_ps(v, v)), ret);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), ret);
+  }
+  saturate_scalar(src + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void saturate_f64_to_i32(const double *src, size_t count, int32_t *dst) noexcept {
+  size_t i = 0;
+  const __m128d limit = _mm_set1_pd(2147483648.0);
+  for (; i + 4 <= count; i += 4) {
+    const __m128d lo = _mm_loadu_pd(src + i);
+    const __m128d hi = _mm_loadu_pd(src + i + 2);
+    __m128i ret = _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+    // the comparison masks are 64 bits wide, keep one 32-bit half of each
+    const __m128i over = _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castpd_ps(_mm_cmpge_pd(lo, limit)), _mm_castpd_ps(_mm_cmpge_pd(hi, limit)), 0x88));
+    const __m128i nan = _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castpd_ps(_mm_cmpunord_pd(lo, lo)), _mm_castpd_ps(_mm_cmpunord_pd(hi, hi)), 0x88));
+    ret = _mm_andnot_si128(nan, _mm_xor_si128(ret, over));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), ret);
+  }
+  saturate_scalar(src + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void convert_i32_to_f32(const int32_t *src, size_t count, float *dst) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    // cvtdq2ps rounds to nearest, ties to even, under the default rounding mode
+    _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))));
+  }
+  convert_scalar(src + i, count - i, dst + i);
+}
+
+NUMBERS_IMPL_INLINE void convert_i32_to_f64(const int32_t *src, size_t count, double *dst) noexcept {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    // cvtdq2pd is exact
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_pd(dst + i, _mm_cvtepi32_pd(v));
+    _mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v)));
+  }
+  convert_scalar(src + i, count - i, dst + i);
+}
+
+#else
+
+NUMBERS_IMPL_INLINE void saturate_f32_to_i32(const float *src, size_t count, int32_t *dst) noexcept {
+  saturate_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE void saturate_f64_to_i32(const double *src, size_t count, int32_t *dst) noexcept {
+  saturate_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE void convert_i32_to_f32(const int32_t *src, size_t count, float *dst) noexcept {
+  convert_scalar(src, count, dst);
+}
+
+NUMBERS_IMPL_INLINE void convert_i32_to_f64(const int32_t *src, size_t count, double *dst) noexcept {
+  convert_scalar(src, count, dst);
+}
+
+#endif
+
+}  // namespace numbers::floating_internal
+
+#endif  // NUMBERS_INTERNAL_FLOATING_IMPL_HH
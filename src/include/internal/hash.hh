@@ -0,0 +1,69 @@
+#ifndef NUMBERS_INTERNAL_HASH_HH
+#define NUMBERS_INTERNAL_HASH_HH
+
+#include <cstdint>
+
+#include "config.h"
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
+#include <intrin.h>
+#pragma intrinsic(_umul128)
+#endif
+
+// A multiply-fold hash in the style of wyhash: the key is xored with secret
+// constants, the two 64-bit halves are multiplied into a 128-bit product and
+// the halves of the product are folded together. Two rounds of that give every
+// input bit a chance to reach every output bit, which is what open addressing
+// tables need, and cost two 64x64->128 multiplications.
+namespace numbers_internal {
+
+constexpr uint64_t kHashSecret0 = 0x2d358dccaa6c78a5ull;
+constexpr uint64_t kHashSecret1 = 0x8bb84b93962eacc9ull;
+constexpr uint64_t kHashSecret2 = 0x4b33a62ed433d4a3ull;
+
+// Seed used by std::hash.
+constexpr uint64_t kHashDefaultSeed = kHashSecret2;
+
+// Replaces `a` and `b` by the low and high halves of their full product.
+inline void hash_mum(uint64_t &a, uint64_t &b) noexcept {
+#ifdef NUMBERS_HAVE_INTRINSTIC_INT128
+  const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC)
+  a = _umul128(a, b, &b);
+#else
+  const uint64_t a32 = a >> 32, a00 = a & 0xffffffff;
+  const uint64_t b32 = b >> 32, b00 = b & 0xffffffff;
+  const uint64_t hh = a32 * b32, hl = a32 * b00, lh = a00 * b32, ll = a00 * b00;
+  const uint64_t mid = (ll >> 32) + (hl & 0xffffffff) + (lh & 0xffffffff);
+  a = (mid << 32) | (ll & 0xffffffff);
+  b = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+#endif
+}
+
+inline uint64_t hash_mix(uint64_t a, uint64_t b) noexcept {
+  hash_mum(a, b);
+  return a ^ b;
+}
+
+// Spreads a user supplied seed, which is often small, over all the bits.
+inline uint64_t hash_seed(uint64_t seed) noexcept { return seed ^ hash_mix(seed ^ kHashSecret0, kHashSecret1); }
+
+// Hashes a key of `size` bytes given as its low and high 64-bit words.
+inline uint64_t hash_words(uint64_t lo, uint64_t hi, uint64_t size, uint64_t seed) noexcept {
+  uint64_t a = lo ^ kHashSecret1;
+  uint64_t b = hi ^ seed;
+  hash_mum(a, b);
+  return hash_mix(a ^ kHashSecret0 ^ size, b ^ kHashSecret1);
+}
+
+// Integers up to 64 bits wide are sign or zero extended to 64 bits.
+template <typename T>
+uint64_t hash_integral(T v, uint64_t seed) noexcept {
+  return hash_words(static_cast<uint64_t>(v), 0, sizeof(T), seed);
+}
+
+}  // namespace numbers_internal
+
+#endif
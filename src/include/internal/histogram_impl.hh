@@ -0,0 +1,221 @@
+#ifndef NUMBERS_INTERNAL_HISTOGRAM_IMPL_HH
+#define NUMBERS_INTERNAL_HISTOGRAM_IMPL_HH
+
+// The out-of-line definitions of histogram.hh, compiled into the library by
+// src/numbers/histogram.cc, or included by histogram.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "int128.hh"
+
+namespace numbers {
+
+namespace histogram_internal {
+
+inline constexpr uint8_t kFormatVersion = 1;
+
+inline void put_varint(std::vector<uint8_t> &out, uint128 v) {
+  while (v >= 0x80) {
+    out.push_back(static_cast<uint8_t>(uint128_low64(v) | 0x80));
+    v >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(uint128_low64(v)));
+}
+
+// Reads a varint of at most `bits` bits, advancing `p`; false if it is truncated or too long.
+inline bool get_varint(const uint8_t *&p, const uint8_t *end, int bits, uint128 &v) noexcept {
+  v = 0;
+  for (int shift = 0; shift < bits; shift += 7) {
+    if (p == end) {
+      return false;
+    }
+    const uint8_t byte = *p++;
+    const uint128 chunk = byte & 0x7f;
+    if (bits - shift < 7 && (chunk >> (bits - shift)) != 0) {
+      return false;
+    }
+    v |= chunk << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+[[noreturn]] inline void bad_encoding() noexcept(false) { throw std::runtime_error("histogram bad encoding"); }
+
+inline size_t bucket_count(int precision) noexcept(false) {
+  if (precision < 1 || precision > histogram::kMaxPrecision) {
+    throw std::runtime_error("histogram precision out of range");
+  }
+  return static_cast<size_t>(65 - precision) << precision;
+}
+
+}  // namespace histogram_internal
+
+NUMBERS_IMPL_INLINE histogram::histogram(int precision) noexcept(false)
+    : precision_(precision), counts_(histogram_internal::bucket_count(precision)) {}
+
+NUMBERS_IMPL_INLINE histogram::histogram(const histogram &other) : histogram(other.precision_) { merge(other); }
+
+NUMBERS_IMPL_INLINE histogram::totals histogram::load_totals() const noexcept {
+  for (;;) {
+    const uint64_t seq = seq_.load(std::memory_order_acquire);
+    const totals ret{count_.load(), sum_.load(), min_.load(std::memory_order_relaxed),
+                     max_.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((seq & 1) == 0 && seq_.load(std::memory_order_relaxed) == seq) {
+      return ret;
+    }
+  }
+}
+
+NUMBERS_IMPL_INLINE uint64_t histogram::lowest(size_t i) const noexcept {
+  const size_t run = i >> precision_;
+  if (run <= 1) {
+    return i;
+  }
+  const int shift = static_cast<int>(run) - 1;
+  return static_cast<uint64_t>(i - (static_cast<size_t>(shift) << precision_)) << shift;
+}
+
+NUMBERS_IMPL_INLINE uint64_t histogram::highest(size_t i) const noexcept {
+  const size_t run = i >> precision_;
+  if (run <= 1) {
+    return i;
+  }
+  const int shift = static_cast<int>(run) - 1;
+  // wraps to 0 for the last bucket, whose highest value is then UINT64_MAX
+  return (static_cast<uint64_t>(i - (static_cast<size_t>(shift) << precision_) + 1) << shift) - 1;
+}
+
+NUMBERS_IMPL_INLINE void histogram::merge(const histogram &other) noexcept(false) {
+  if (other.precision_ != precision_) {
+    throw std::runtime_error("histogram precision mismatch");
+  }
+  const totals theirs = other.load_totals();
+  const uint64_t seq = begin_write();
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    const u64 sum = u64(counts_[i].load(std::memory_order_relaxed)).saturating_add(other.bucket_count(i));
+    counts_[i].store(static_cast<uint64_t>(sum), std::memory_order_relaxed);
+  }
+  count_.store(count_.load().saturating_add(theirs.count));
+  sum_.store(sum_.load().saturating_add(theirs.sum));
+  if (theirs.min < min_.load(std::memory_order_relaxed)) {
+    min_.store(theirs.min, std::memory_order_relaxed);
+  }
+  if (theirs.max > max_.load(std::memory_order_relaxed)) {
+    max_.store(theirs.max, std::memory_order_relaxed);
+  }
+  end_write(seq);
+}
+
+NUMBERS_IMPL_INLINE void histogram::reset() noexcept {
+  const uint64_t seq = begin_write();
+  for (std::atomic<uint64_t> &bucket : counts_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(i128(0));
+  sum_.store(i128(0));
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+  end_write(seq);
+}
+
+NUMBERS_IMPL_INLINE double histogram::mean() const noexcept {
+  const totals t = load_totals();
+  if (t.count == i128(0)) {
+    return 0;
+  }
+  return static_cast<double>(static_cast<int128>(t.sum)) / static_cast<double>(static_cast<int128>(t.count));
+}
+
+NUMBERS_IMPL_INLINE u64 histogram::min() const noexcept {
+  const totals t = load_totals();
+  return u64(t.count == i128(0) ? 0 : t.min);
+}
+
+NUMBERS_IMPL_INLINE u64 histogram::percentile(double p) const noexcept {
+  const totals t = load_totals();
+  if (t.count == i128(0)) {
+    return u64(0);
+  }
+  p = std::isnan(p) ? 0 : std::fmin(std::fmax(p, 0.0), 100.0);
+  i128 target(std::ceil(p / 100 * static_cast<double>(static_cast<int128>(t.count))));
+  target = target < i128(1) ? i128(1) : target;
+
+  i128 seen(0);
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen = seen.saturating_add(i128(counts_[i].load(std::memory_order_relaxed)));
+    if (seen >= target) {
+      const uint64_t v = highest(i);
+      return u64(v < t.min ? t.min : v > t.max ? t.max : v);
+    }
+  }
+  // only reached if a bucket saturated
+  return u64(t.max);
+}
+
+NUMBERS_IMPL_INLINE std::vector<uint8_t> histogram::serialize() const {
+  std::vector<uint8_t> out;
+  out.push_back(histogram_internal::kFormatVersion);
+  out.push_back(static_cast<uint8_t>(precision_));
+  const totals t = load_totals();
+  histogram_internal::put_varint(out, static_cast<uint128>(static_cast<int128>(t.count)));
+  histogram_internal::put_varint(out, static_cast<uint128>(static_cast<int128>(t.sum)));
+  histogram_internal::put_varint(out, t.min);
+  histogram_internal::put_varint(out, t.max);
+  size_t next = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    const uint64_t n = counts_[i].load(std::memory_order_relaxed);
+    if (n != 0) {
+      histogram_internal::put_varint(out, i - next);
+      histogram_internal::put_varint(out, n);
+      next = i + 1;
+    }
+  }
+  return out;
+}
+
+NUMBERS_IMPL_INLINE histogram histogram::deserialize(const uint8_t *data, size_t size) noexcept(false) {
+  const uint8_t *p = data;
+  const uint8_t *end = data + size;
+  if (size < 2 || p[0] != histogram_internal::kFormatVersion || p[1] < 1 || p[1] > kMaxPrecision) {
+    histogram_internal::bad_encoding();
+  }
+  histogram ret(p[1]);
+  p += 2;
+
+  uint128 count, sum, min, max;
+  if (!histogram_internal::get_varint(p, end, 127, count) || !histogram_internal::get_varint(p, end, 127, sum) ||
+      !histogram_internal::get_varint(p, end, 64, min) || !histogram_internal::get_varint(p, end, 64, max)) {
+    histogram_internal::bad_encoding();
+  }
+  ret.count_.store(i128(static_cast<int128>(count)));
+  ret.sum_.store(i128(static_cast<int128>(sum)));
+  ret.min_.store(uint128_low64(min), std::memory_order_relaxed);
+  ret.max_.store(uint128_low64(max), std::memory_order_relaxed);
+
+  uint128 next = 0;
+  while (p != end) {
+    uint128 gap, n;
+    if (!histogram_internal::get_varint(p, end, 64, gap) || !histogram_internal::get_varint(p, end, 64, n)) {
+      histogram_internal::bad_encoding();
+    }
+    const uint128 i = next + gap;
+    if (i >= ret.counts_.size()) {
+      histogram_internal::bad_encoding();
+    }
+    ret.counts_[uint128_low64(i)].store(uint128_low64(n), std::memory_order_relaxed);
+    next = i + 1;
+  }
+  return ret;
+}
+
+}  // namespace numbers
+
+#endif  // NUMBERS_INTERNAL_HISTOGRAM_IMPL_HH
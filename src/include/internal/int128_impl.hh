@@ -0,0 +1,41 @@
+// Copyright 2017 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Modified from abseil-app guuzaa
+
+#ifndef NUMBERS_INTERNAL_INT128_IMPL_HH
+#define NUMBERS_INTERNAL_INT128_IMPL_HH
+
+// The out-of-line definitions of int128.hh, compiled into the library by
+// src/numbers/int128.cc, or included by int128.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#include <string>
+
+namespace numbers {
+
+NUMBERS_IMPL_INLINE std::string uint128::to_string() const {
+  char buf[40];
+  return std::string(buf, to_chars(buf, buf + sizeof(buf), *this));
+}
+
+NUMBERS_IMPL_INLINE std::string int128::to_string() const {
+  char buf[41];
+  return std::string(buf, to_chars(buf, buf + sizeof(buf), *this));
+}
+
+}  // namespace numbers
+
+#endif  // NUMBERS_INTERNAL_INT128_IMPL_HH
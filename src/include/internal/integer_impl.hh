@@ -0,0 +1,39 @@
+#ifndef NUMBERS_INTERNAL_INTEGER_IMPL_HH
+#define NUMBERS_INTERNAL_INTEGER_IMPL_HH
+
+// The out-of-line definitions of integer.hh, compiled into the library by
+// src/numbers/integer.cc, or included by integer.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#if defined(_MSC_VER)
+namespace numbers {
+template <>
+NUMBERS_IMPL_INLINE i8 i8::MAX = i8(max_);
+template <>
+NUMBERS_IMPL_INLINE i8 i8::MIN = i8(min_);
+
+template <>
+NUMBERS_IMPL_INLINE i16 i16::MAX = i16(max_);
+template <>
+NUMBERS_IMPL_INLINE i16 i16::MIN = i16(min_);
+
+template <>
+NUMBERS_IMPL_INLINE i32 i32::MAX = i32(max_);
+template <>
+NUMBERS_IMPL_INLINE i32 i32::MIN = i32(min_);
+
+template <>
+NUMBERS_IMPL_INLINE i64 i64::MAX = i64(max_);
+template <>
+NUMBERS_IMPL_INLINE i64 i64::MIN = i64(min_);
+
+template <>
+NUMBERS_IMPL_INLINE i128 i128::MAX = i128(max_);
+template <>
+NUMBERS_IMPL_INLINE i128 i128::MIN = i128(min_);
+}  // namespace numbers
+#endif
+
+#endif  // NUMBERS_INTERNAL_INTEGER_IMPL_HH
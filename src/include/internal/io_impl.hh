@@ -0,0 +1,192 @@
+// Copyright 2017 The Abseil Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Modified from abseil-app guuzaa
+
+#ifndef NUMBERS_INTERNAL_IO_IMPL_HH
+#define NUMBERS_INTERNAL_IO_IMPL_HH
+
+// The out-of-line definitions of the int128 and uint128 stream operators of
+// io.hh, compiled into the library by src/numbers/io.cc, or included by io.hh
+// itself as inline functions when NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace numbers {
+
+namespace int128_internal {
+inline std::string uint128_to_formatted_string(uint128 v, std::ios_base::fmtflags flags) {
+  int base = 10;
+  switch (flags & std::ios::basefield) {
+    case std::ios::hex:
+      base = 16;
+      break;
+    case std::ios::oct:
+      base = 8;
+      break;
+    default:  // std::ios::dec
+      break;
+  }
+
+  // a base prefix and the 43 octal digits of uint128_max()
+  char buf[48];
+  char *first = buf;
+  if ((flags & std::ios::showbase) && v != 0 && base != 10) {
+    *first++ = '0';
+    if (base == 16) {
+      *first++ = (flags & std::ios::uppercase) ? 'X' : 'x';
+    }
+  }
+  char *last = to_chars(first, buf + sizeof(buf), v, base);
+  if (base == 16 && (flags & std::ios::uppercase)) {
+    for (char *p = first; p != last; ++p) {
+      if (*p >= 'a') {
+        *p = static_cast<char>(*p - 'a' + 'A');
+      }
+    }
+  }
+  return std::string(buf, last);
+}
+}  // namespace int128_internal
+
+NUMBERS_IMPL_INLINE std::ostream &operator<<(std::ostream &os, uint128 v) {
+  std::ios_base::fmtflags flags = os.flags();
+  std::string rep = int128_internal::uint128_to_formatted_string(v, flags);
+
+  // Add the requisite padding
+  std::streamsize width = os.width(0);
+  if (static_cast<size_t>(width) > rep.size()) {
+    const size_t count = static_cast<size_t>(width) - rep.size();
+    std::ios::fmtflags adjustfield = flags & std::ios::adjustfield;
+    switch (adjustfield) {
+      case std::ios::left:
+        rep.append(count, os.fill());
+        break;
+      case std::ios::internal:
+        if ((flags & std::ios::basefield) == std::ios::hex && (flags & std::ios::showbase) && v != 0) {
+          rep.insert(size_t{2}, count, os.fill());
+        } else {
+          rep.insert(size_t{0}, count, os.fill());
+        }
+        break;
+      default:  // std::ios::right
+        rep.insert(0, count, os.fill());
+        break;
+    }
+  }
+
+  return os << rep;
+}
+
+NUMBERS_IMPL_INLINE std::ostream &operator<<(std::ostream &os, int128 v) {
+  std::ios_base::fmtflags flags = os.flags();
+  std::string rep;
+  // Add the sign if needed
+  bool print_as_decimal =
+      (flags & std::ios::basefield) == std::ios::dec || (flags & std::ios::basefield) == std::ios_base::fmtflags();
+  if (print_as_decimal) {
+    if (int128_high64(v) < 0) {
+      rep = "-";
+    } else if (flags & std::ios::showpos) {
+      rep = "+";
+    }
+  }
+
+  rep.append(int128_internal::uint128_to_formatted_string(
+      (print_as_decimal ? int128_internal::UnsignedAbsoluteValue(v) : uint128(v)), os.flags()));
+
+  // Add the requisite padding
+  std::streamsize width = os.width(0);
+  if (static_cast<size_t>(width) > rep.size()) {
+    const size_t count = static_cast<size_t>(width) - rep.size();
+    switch (flags & std::ios::adjustfield) {
+      case std::ios::left:
+        rep.append(count, os.fill());
+        break;
+      case std::ios::internal:
+        if (print_as_decimal && (rep[0] == '+' || rep[0] == '-')) {
+          rep.insert(size_t{1}, count, os.fill());
+        } else if ((flags & std::ios::basefield) == std::ios::hex && (flags & std::ios::showbase) && v != 0) {
+          rep.insert(size_t{2}, count, os.fill());
+        } else {
+          rep.insert(size_t{0}, count, os.fill());
+        }
+        break;
+      default:  // std::ios::right
+        rep.insert(0, count, os.fill());
+        break;
+    }
+  }
+  return os << rep;
+}
+
+namespace int128_internal {
+// Reads an optional sign and decimal digits. A magnitude above the limit for
+// its sign sets failbit and gives the limit, as the standard extractors do.
+inline uint128 read_decimal(std::istream &is, bool &negative, uint128 positive_limit, uint128 negative_limit) {
+  negative = false;
+  const std::istream::sentry sentry(is);
+  if (!sentry) {
+    return 0;
+  }
+  using traits = std::istream::traits_type;
+  traits::int_type c = is.peek();
+  if (c == '+' || c == '-') {
+    negative = c == '-';
+    is.get();
+    c = is.peek();
+  }
+  const uint128 limit = negative ? negative_limit : positive_limit;
+  uint128 value = 0;
+  bool digits = false;
+  bool overflow = false;
+  while (!traits::eq_int_type(c, traits::eof()) && c >= '0' && c <= '9') {
+    const uint32_t digit = static_cast<uint32_t>(c - '0');
+    if (value > (limit - digit) / 10) {
+      overflow = true;
+    } else {
+      value = value * 10 + digit;
+    }
+    digits = true;
+    is.get();
+    c = is.peek();
+  }
+  if (!digits || overflow) {
+    is.setstate(std::ios::failbit);
+    return digits ? limit : 0;
+  }
+  return value;
+}
+}  // namespace int128_internal
+
+NUMBERS_IMPL_INLINE std::istream &operator>>(std::istream &is, uint128 &v) {
+  bool negative = false;
+  const uint128 value = int128_internal::read_decimal(is, negative, uint128_max(), uint128_max());
+  v = negative ? -value : value;
+  return is;
+}
+
+NUMBERS_IMPL_INLINE std::istream &operator>>(std::istream &is, int128 &v) {
+  bool negative = false;
+  const uint128 value = int128_internal::read_decimal(is, negative, uint128(int128_max()), uint128(int128_max()) + 1);
+  v = int128(negative ? -value : value);
+  return is;
+}
+
+}  // namespace numbers
+
+#endif  // NUMBERS_INTERNAL_IO_IMPL_HH
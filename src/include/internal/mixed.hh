@@ -0,0 +1,237 @@
+#ifndef NUMBERS_INTERNAL_MIXED_HH
+#define NUMBERS_INTERNAL_MIXED_HH
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "int128.hh"
+#include "internal/config.h"
+#include "overflow.hh"
+
+// Exact arithmetic between primitive integers of any signedness and width.
+//
+// Both operands are sign (or zero) extended to an unsigned work type as wide
+// as the widest of the operands and the result, the operation wraps around
+// there, and the carry together with the operand signs tells how far the
+// wrapped value is from the exact one. No type wider than the operands is
+// involved, so a 64-bit operation never goes through a 128-bit path.
+namespace numbers_internal {
+
+template <typename T>
+constexpr bool is_integer_v =
+    std::is_integral_v<T> || std::is_same_v<T, numbers::int128> || std::is_same_v<T, numbers::uint128>;
+
+template <typename T>
+constexpr bool is_signed_integer_v = std::numeric_limits<T>::is_signed;
+
+// The unsigned type the operation wraps around in.
+template <typename... Ts>
+using work_t = std::conditional_t<
+    ((sizeof(Ts) < sizeof(uint64_t)) && ...), uint32_t,
+    std::conditional_t<((sizeof(Ts) <= sizeof(uint64_t)) && ...), uint64_t, numbers::uint128>>;
+
+template <typename W>
+using signed_work_t = std::conditional_t<
+    std::is_same_v<W, uint32_t>, int32_t, std::conditional_t<std::is_same_v<W, uint64_t>, int64_t, numbers::int128>>;
+
+template <typename W>
+constexpr bool top_bit(W v) noexcept {
+  return static_cast<bool>(v >> (std::numeric_limits<W>::digits - 1));
+}
+
+template <typename T>
+constexpr bool is_below_zero(T v) noexcept {
+  if constexpr (is_signed_integer_v<T>) {
+    return v < 0;
+  } else {
+    return false;
+  }
+}
+
+// The outcome of a mixed operation. `value` is the exact result wrapped
+// around to `R`; on overflow `negative` tells on which side the exact result
+// left the range of `R`.
+template <typename R>
+struct mixed_result {
+  R value;
+  bool overflow;
+  bool negative;
+};
+
+// Range checks the wrapped value `w` of the work type against `R`. `k` is the
+// multiple of 2^N (N being the width of W) the exact result differs from `w`
+// by, which is in [-2, 1] for additions and subtractions.
+template <typename R, typename W>
+constexpr mixed_result<R> narrow(W w, int k) noexcept {
+  const bool top = top_bit(w);
+  bool overflow = is_signed_integer_v<R> ? k != -static_cast<int>(top) : k != 0;
+  bool negative = k < 0;
+  if constexpr (sizeof(R) < sizeof(W)) {
+    if (!overflow) {
+      if constexpr (is_signed_integer_v<R>) {
+        using S = signed_work_t<W>;
+        const S v = static_cast<S>(w);
+        overflow =
+            v < static_cast<S>(std::numeric_limits<R>::min()) || v > static_cast<S>(std::numeric_limits<R>::max());
+        negative = v < 0;
+      } else {
+        overflow = w > static_cast<W>(std::numeric_limits<R>::max());
+      }
+    }
+  }
+  return {static_cast<R>(w), overflow, negative};
+}
+
+// Range checks the magnitude `mag` with sign `negative` against `R`; `wide`
+// is set if the magnitude itself does not fit the work type.
+template <typename R, typename W>
+constexpr mixed_result<R> from_magnitude(W mag, bool negative, bool wide) noexcept {
+  const W w = negative ? W(0) - mag : mag;
+  if (wide) {
+    return {static_cast<R>(w), true, negative};
+  }
+  // A non-zero negative result is w - 2^N.
+  return narrow<R>(w, negative && mag != 0 ? -1 : 0);
+}
+
+// The full product of two work type values, returning the low half.
+template <typename W>
+constexpr W multiply(W lhs, W rhs, W &high) noexcept {
+  if constexpr (std::is_same_v<W, uint32_t>) {
+    const uint64_t p = static_cast<uint64_t>(lhs) * rhs;
+    high = static_cast<uint32_t>(p >> 32);
+    return static_cast<uint32_t>(p);
+  } else if constexpr (std::is_same_v<W, uint64_t>) {
+    const numbers::uint128 p = numbers::uint128(lhs) * numbers::uint128(rhs);
+    high = numbers::uint128_high64(p);
+    return numbers::uint128_low64(p);
+  } else {
+    const uint64_t a0 = numbers::uint128_low64(lhs);
+    const uint64_t a1 = numbers::uint128_high64(lhs);
+    const uint64_t b0 = numbers::uint128_low64(rhs);
+    const uint64_t b1 = numbers::uint128_high64(rhs);
+    const numbers::uint128 p00 = numbers::uint128(a0) * b0;
+    const numbers::uint128 p01 = numbers::uint128(a0) * b1;
+    const numbers::uint128 p10 = numbers::uint128(a1) * b0;
+    const numbers::uint128 mid =
+        numbers::uint128(numbers::uint128_high64(p00)) + numbers::uint128_low64(p01) + numbers::uint128_low64(p10);
+    high = numbers::uint128(a1) * b1 + numbers::uint128_high64(p01) + numbers::uint128_high64(p10) +
+           numbers::uint128_high64(mid);
+    return numbers::make_uint128(numbers::uint128_low64(mid), numbers::uint128_low64(p00));
+  }
+}
+
+template <typename W, typename T>
+constexpr W magnitude(T v) noexcept {
+  const W w = static_cast<W>(v);
+  return is_below_zero(v) ? W(0) - w : w;
+}
+
+template <typename R, typename A, typename B>
+constexpr mixed_result<R> mixed_add(A lhs, B rhs) noexcept {
+#if NUMBERS_HAVE_BUILTIN(__builtin_add_overflow)
+  if constexpr (std::is_integral_v<A> && std::is_integral_v<B> && std::is_integral_v<R>) {
+    R ret{};
+    if (!__builtin_add_overflow(lhs, rhs, &ret)) {
+      return {ret, false, false};
+    }
+  }
+#endif
+  using W = work_t<R, A, B>;
+  const W a = static_cast<W>(lhs);
+  const W w = a + static_cast<W>(rhs);
+  const int carry = w < a;
+  return narrow<R>(w, carry - is_below_zero(lhs) - is_below_zero(rhs));
+}
+
+template <typename R, typename A, typename B>
+constexpr mixed_result<R> mixed_sub(A lhs, B rhs) noexcept {
+#if NUMBERS_HAVE_BUILTIN(__builtin_sub_overflow)
+  if constexpr (std::is_integral_v<A> && std::is_integral_v<B> && std::is_integral_v<R>) {
+    R ret{};
+    if (!__builtin_sub_overflow(lhs, rhs, &ret)) {
+      return {ret, false, false};
+    }
+  }
+#endif
+  using W = work_t<R, A, B>;
+  const W a = static_cast<W>(lhs);
+  const W b = static_cast<W>(rhs);
+  const int borrow = a < b;
+  return narrow<R>(a - b, is_below_zero(rhs) - is_below_zero(lhs) - borrow);
+}
+
+template <typename R, typename A, typename B>
+constexpr mixed_result<R> mixed_mul(A lhs, B rhs) noexcept {
+#if NUMBERS_HAVE_BUILTIN(__builtin_mul_overflow)
+  if constexpr (std::is_integral_v<A> && std::is_integral_v<B> && std::is_integral_v<R>) {
+    R ret{};
+    if (!__builtin_mul_overflow(lhs, rhs, &ret)) {
+      return {ret, false, false};
+    }
+  }
+#endif
+  using W = work_t<R, A, B>;
+  W high{};
+  const W mag = multiply(magnitude<W>(lhs), magnitude<W>(rhs), high);
+  return from_magnitude<R>(mag, is_below_zero(lhs) != is_below_zero(rhs), high != 0);
+}
+
+template <typename R, typename A, typename B>
+constexpr mixed_result<R> mixed_div(A lhs, B rhs) noexcept {
+  using W = work_t<R, A, B>;
+  const W mag = magnitude<W>(lhs) / magnitude<W>(rhs);
+  return from_magnitude<R>(mag, is_below_zero(lhs) != is_below_zero(rhs), false);
+}
+
+// The remainder takes the sign of the dividend, like the built-in operator.
+template <typename R, typename A, typename B>
+constexpr mixed_result<R> mixed_rem(A lhs, B rhs) noexcept {
+  using W = work_t<R, A, B>;
+  const W mag = magnitude<W>(lhs) % magnitude<W>(rhs);
+  return from_magnitude<R>(mag, is_below_zero(lhs), false);
+}
+
+// The value, or throws the overflow_error of `lhs op rhs`.
+template <typename R, typename A, typename B>
+constexpr R value_or_report(const mixed_result<R> &ret, const char *op, A lhs, B rhs) noexcept(false) {
+  if (ret.overflow) {
+    numbers::overflow_internal::report(op, lhs, rhs);
+  }
+  return ret.value;
+}
+
+// Compares the values of two integers of any signedness and width, like the
+// C++20 std::cmp_equal and std::cmp_less.
+template <typename A, typename B>
+constexpr bool cmp_equal(A lhs, B rhs) noexcept {
+  using W = work_t<A, B>;
+  return is_below_zero(lhs) == is_below_zero(rhs) && static_cast<W>(lhs) == static_cast<W>(rhs);
+}
+
+template <typename A, typename B>
+constexpr bool cmp_less(A lhs, B rhs) noexcept {
+  using W = work_t<A, B>;
+  if (is_below_zero(lhs) != is_below_zero(rhs)) {
+    return is_below_zero(lhs);
+  }
+  return static_cast<W>(lhs) < static_cast<W>(rhs);
+}
+
+// Returns true if `v` is representable by `T`, like the C++20 std::in_range.
+// Widening conversions need no check at all.
+template <typename T, typename U>
+constexpr bool in_range(U v) noexcept {
+  using to = std::numeric_limits<T>;
+  using from = std::numeric_limits<U>;
+  if constexpr ((from::is_signed == to::is_signed || !from::is_signed) && from::digits <= to::digits) {
+    return true;
+  } else {
+    return !cmp_less(v, to::min()) && !cmp_less(to::max(), v);
+  }
+}
+
+}  // namespace numbers_internal
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef NUMBERS_INTERNAL_TRAITS_HH
+#define NUMBERS_INTERNAL_TRAITS_HH
+
+#include <type_traits>
+
+#include "integer.hh"
+#include "uinteger.hh"
+
+namespace numbers_internal {
+
+// Detects the numbers integer types, i.e. `Integer<T>` and `Uinteger<T>`.
+template <typename T>
+struct is_numbers_type : std::false_type {};
+
+template <typename T>
+struct is_numbers_type<numbers::Integer<T>> : std::true_type {};
+
+template <typename T>
+struct is_numbers_type<numbers::Uinteger<T>> : std::true_type {};
+
+template <typename T>
+constexpr bool is_numbers_type_v = is_numbers_type<T>::value;
+
+// The primitive type wrapped by a numbers integer type; other types map to themselves.
+template <typename T>
+struct raw_type {
+  using type = T;
+};
+
+template <typename T>
+struct raw_type<numbers::Integer<T>> {
+  using type = T;
+};
+
+template <typename T>
+struct raw_type<numbers::Uinteger<T>> {
+  using type = T;
+};
+
+template <typename T>
+using raw_type_t = typename raw_type<T>::type;
+
+template <typename T>
+struct type_identity {
+  using type = T;
+};
+
+// Blocks template argument deduction, so that the other arguments of a call
+// decide the type and this one converts to it.
+template <typename T>
+using type_identity_t = typename type_identity<T>::type;
+
+}  // namespace numbers_internal
+
+#endif
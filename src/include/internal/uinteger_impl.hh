@@ -0,0 +1,39 @@
+#ifndef NUMBERS_INTERNAL_UINTEGER_IMPL_HH
+#define NUMBERS_INTERNAL_UINTEGER_IMPL_HH
+
+// The out-of-line definitions of uinteger.hh, compiled into the library by
+// src/numbers/uinteger.cc, or included by uinteger.hh itself as inline functions when
+// NUMBERS_HEADER_ONLY is defined.
+
+#include "internal/config.h"
+
+#if defined(_MSC_VER)
+namespace numbers {
+template <>
+NUMBERS_IMPL_INLINE u8 u8::MAX = u8(max_);
+template <>
+NUMBERS_IMPL_INLINE u8 u8::MIN = u8(min_);
+
+template <>
+NUMBERS_IMPL_INLINE u16 u16::MAX = u16(max_);
+template <>
+NUMBERS_IMPL_INLINE u16 u16::MIN = u16(min_);
+
+template <>
+NUMBERS_IMPL_INLINE u32 u32::MAX = u32(max_);
+template <>
+NUMBERS_IMPL_INLINE u32 u32::MIN = u32(min_);
+
+template <>
+NUMBERS_IMPL_INLINE u64 u64::MAX = u64(max_);
+template <>
+NUMBERS_IMPL_INLINE u64 u64::MIN = u64(min_);
+
+template <>
+NUMBERS_IMPL_INLINE u128 u128::MAX = u128(max_);
+template <>
+NUMBERS_IMPL_INLINE u128 u128::MIN = u128(min_);
+}  // namespace numbers
+#endif
+
+#endif  // NUMBERS_INTERNAL_UINTEGER_IMPL_HH
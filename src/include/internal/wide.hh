@@ -0,0 +1,248 @@
+#ifndef NUMBERS_INTERNAL_WIDE_HH
+#define NUMBERS_INTERNAL_WIDE_HH
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "int128.hh"
+
+namespace numbers_internal {
+
+// wide256
+//
+// A fixed 256-bit two's complement integer used as the widening domain for
+// 128-bit operands: the full product of two 128-bit values always fits. Only
+// the operations needed to evaluate an expression exactly and range check the
+// result are provided; it is not a general purpose arithmetic type.
+template <bool Signed>
+class wide256 {
+ public:
+  constexpr wide256() noexcept : w_{0, 0, 0, 0} {}
+
+  // Sign-extends (or zero-extends) a built-in integer or a 128-bit integer.
+  template <typename T>
+  static wide256 from(T v) noexcept {
+    wide256 ret;
+    if constexpr (std::is_same_v<T, numbers::uint128>) {
+      ret.w_[0] = numbers::uint128_low64(v);
+      ret.w_[1] = numbers::uint128_high64(v);
+    } else if constexpr (std::is_same_v<T, numbers::int128>) {
+      ret.w_[0] = numbers::int128_low64(v);
+      ret.w_[1] = static_cast<uint64_t>(numbers::int128_high64(v));
+      ret.w_[2] = ret.w_[3] = numbers::int128_high64(v) < 0 ? ~uint64_t{0} : 0;
+    } else if constexpr (std::is_signed_v<T>) {
+      ret.w_[0] = static_cast<uint64_t>(static_cast<int64_t>(v));
+      ret.w_[1] = ret.w_[2] = ret.w_[3] = v < 0 ? ~uint64_t{0} : 0;
+    } else {
+      ret.w_[0] = static_cast<uint64_t>(v);
+    }
+    return ret;
+  }
+
+  constexpr uint64_t word(int i) const noexcept { return w_[i]; }
+
+  constexpr bool is_negative() const noexcept { return Signed && (w_[3] >> 63) != 0; }
+
+  // Returns the low bits of the value reinterpreted as `T`.
+  template <typename T>
+  T truncate() const noexcept {
+    if constexpr (std::is_same_v<T, numbers::uint128>) {
+      return numbers::make_uint128(w_[1], w_[0]);
+    } else if constexpr (std::is_same_v<T, numbers::int128>) {
+      return numbers::make_int128(numbers::int128_internal::BitCastToSigned(w_[1]), w_[0]);
+    } else {
+      return static_cast<T>(w_[0]);
+    }
+  }
+
+  // Returns true if the value is representable by `T`.
+  template <typename T>
+  bool fits() const noexcept {
+    if constexpr (std::is_same_v<T, numbers::int128>) {
+      return is_narrow_signed();
+    } else if constexpr (std::is_same_v<T, numbers::uint128>) {
+      return (w_[2] | w_[3]) == 0;
+    }
+    const wide256 lo = from(std::numeric_limits<T>::min());
+    const wide256 hi = from(std::numeric_limits<T>::max());
+    return !(*this < lo) && !(hi < *this);
+  }
+
+  friend wide256 operator+(const wide256 &lhs, const wide256 &rhs) noexcept {
+    wide256 ret;
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+      const uint64_t sum = lhs.w_[i] + rhs.w_[i];
+      const uint64_t carry_out = sum < lhs.w_[i];
+      ret.w_[i] = sum + carry;
+      carry = carry_out | (ret.w_[i] < sum);
+    }
+    return ret;
+  }
+
+  friend wide256 operator-(const wide256 &lhs, const wide256 &rhs) noexcept {
+    wide256 ret;
+    uint64_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+      const uint64_t diff = lhs.w_[i] - rhs.w_[i];
+      const uint64_t borrow_out = lhs.w_[i] < rhs.w_[i];
+      ret.w_[i] = diff - borrow;
+      borrow = borrow_out | (diff < borrow);
+    }
+    return ret;
+  }
+
+  friend wide256 operator-(const wide256 &val) noexcept { return wide256{} - val; }
+
+  friend wide256 operator*(const wide256 &lhs, const wide256 &rhs) noexcept {
+    return lhs.is_narrow() && rhs.is_narrow() ? narrow_multiply(lhs, rhs) : truncated_multiply(lhs, rhs);
+  }
+
+  friend bool operator==(const wide256 &lhs, const wide256 &rhs) noexcept {
+    return lhs.w_[0] == rhs.w_[0] && lhs.w_[1] == rhs.w_[1] && lhs.w_[2] == rhs.w_[2] && lhs.w_[3] == rhs.w_[3];
+  }
+
+  friend bool operator!=(const wide256 &lhs, const wide256 &rhs) noexcept { return !(lhs == rhs); }
+
+  friend bool operator<(const wide256 &lhs, const wide256 &rhs) noexcept {
+    if (lhs.w_[3] != rhs.w_[3]) {
+      if constexpr (Signed) {
+        return static_cast<int64_t>(lhs.w_[3]) < static_cast<int64_t>(rhs.w_[3]);
+      } else {
+        return lhs.w_[3] < rhs.w_[3];
+      }
+    }
+    for (int i = 2; i >= 0; --i) {
+      if (lhs.w_[i] != rhs.w_[i]) {
+        return lhs.w_[i] < rhs.w_[i];
+      }
+    }
+    return false;
+  }
+
+  // Stores the wrapped result into `ret` and returns true if an overflow occurred.
+  static bool overflowing_add(const wide256 &lhs, const wide256 &rhs, wide256 &ret) noexcept {
+    ret = lhs + rhs;
+    if constexpr (Signed) {
+      return lhs.is_negative() == rhs.is_negative() && ret.is_negative() != lhs.is_negative();
+    } else {
+      return ret < lhs;
+    }
+  }
+
+  static bool overflowing_sub(const wide256 &lhs, const wide256 &rhs, wide256 &ret) noexcept {
+    ret = lhs - rhs;
+    if constexpr (Signed) {
+      return lhs.is_negative() != rhs.is_negative() && ret.is_negative() != lhs.is_negative();
+    } else {
+      return lhs < rhs;
+    }
+  }
+
+  static bool overflowing_mul(const wide256 &lhs, const wide256 &rhs, wide256 &ret) noexcept {
+    const bool negative = lhs.is_negative() != rhs.is_negative();
+    const wide256 a = lhs.is_negative() ? -lhs : lhs;
+    const wide256 b = rhs.is_negative() ? -rhs : rhs;
+    uint64_t full[8];
+    multiply(a, b, full);
+    for (int i = 0; i < 4; ++i) {
+      ret.w_[i] = full[i];
+    }
+    bool overflow = (full[4] | full[5] | full[6] | full[7]) != 0;
+    if constexpr (Signed) {
+      // The magnitude must stay below 2^255, or be exactly 2^255 for a negative result.
+      const bool top = (full[3] >> 63) != 0;
+      const bool is_min = full[3] == (uint64_t{1} << 63) && (full[0] | full[1] | full[2]) == 0;
+      overflow = overflow || (top && !(negative && is_min));
+    }
+    if (negative) {
+      ret = -ret;
+    }
+    return overflow;
+  }
+
+ private:
+  // Returns true if the value is the sign (or zero) extension of its low 128 bits.
+  constexpr bool is_narrow() const noexcept {
+    if constexpr (Signed) {
+      return is_narrow_signed();
+    } else {
+      return (w_[2] | w_[3]) == 0;
+    }
+  }
+
+  // Returns true if the value is the sign extension of its low 128 bits.
+  constexpr bool is_narrow_signed() const noexcept {
+    const uint64_t ext = (w_[1] >> 63) != 0 ? ~uint64_t{0} : 0;
+    return w_[2] == ext && w_[3] == ext;
+  }
+
+  // The full product of two 128-bit values, computed from four 64-bit
+  // products. For signed operands the unsigned high half is corrected by
+  // subtracting the other operand once per negative operand.
+  static wide256 narrow_multiply(const wide256 &lhs, const wide256 &rhs) noexcept {
+    const numbers::uint128 p00 = numbers::uint128(lhs.w_[0]) * numbers::uint128(rhs.w_[0]);
+    const numbers::uint128 p01 = numbers::uint128(lhs.w_[0]) * numbers::uint128(rhs.w_[1]);
+    const numbers::uint128 p10 = numbers::uint128(lhs.w_[1]) * numbers::uint128(rhs.w_[0]);
+    const numbers::uint128 p11 = numbers::uint128(lhs.w_[1]) * numbers::uint128(rhs.w_[1]);
+    const numbers::uint128 mid = numbers::uint128(numbers::uint128_high64(p00)) + numbers::uint128_low64(p01) +
+                                 numbers::uint128_low64(p10);
+    numbers::uint128 high = p11 + numbers::uint128_high64(p01) + numbers::uint128_high64(p10) +
+                            numbers::uint128_high64(mid);
+    if constexpr (Signed) {
+      const numbers::uint128 lhs_mask = lhs.w_[3] == 0 ? numbers::uint128(0) : ~numbers::uint128(0);
+      const numbers::uint128 rhs_mask = rhs.w_[3] == 0 ? numbers::uint128(0) : ~numbers::uint128(0);
+      high -= (numbers::make_uint128(rhs.w_[1], rhs.w_[0]) & lhs_mask) +
+              (numbers::make_uint128(lhs.w_[1], lhs.w_[0]) & rhs_mask);
+    }
+    wide256 ret;
+    ret.w_[0] = numbers::uint128_low64(p00);
+    ret.w_[1] = numbers::uint128_low64(mid);
+    ret.w_[2] = numbers::uint128_low64(high);
+    ret.w_[3] = numbers::uint128_high64(high);
+    return ret;
+  }
+
+  // Schoolbook multiplication keeping only the words that land in the low 256 bits.
+  static wide256 truncated_multiply(const wide256 &lhs, const wide256 &rhs) noexcept {
+    wide256 ret;
+    for (int i = 0; i < 4; ++i) {
+      uint64_t carry = 0;
+      for (int j = 0; i + j < 4; ++j) {
+        const numbers::uint128 t =
+            numbers::uint128(lhs.w_[i]) * numbers::uint128(rhs.w_[j]) + numbers::uint128(ret.w_[i + j]) + carry;
+        ret.w_[i + j] = numbers::uint128_low64(t);
+        carry = numbers::uint128_high64(t);
+      }
+    }
+    return ret;
+  }
+
+  // Schoolbook multiplication of the raw words, producing the full 512-bit product.
+  static void multiply(const wide256 &lhs, const wide256 &rhs, uint64_t (&full)[8]) noexcept {
+    for (int i = 0; i < 8; ++i) {
+      full[i] = 0;
+    }
+    for (int i = 0; i < 4; ++i) {
+      uint64_t carry = 0;
+      for (int j = 0; j < 4; ++j) {
+        const numbers::uint128 t =
+            numbers::uint128(lhs.w_[i]) * numbers::uint128(rhs.w_[j]) + numbers::uint128(full[i + j]) + carry;
+        full[i + j] = numbers::uint128_low64(t);
+        carry = numbers::uint128_high64(t);
+      }
+      full[i + 4] = carry;
+    }
+  }
+
+  // little endian
+  uint64_t w_[4];
+};
+
+using int256 = wide256<true>;
+using uint256 = wide256<false>;
+
+}  // namespace numbers_internal
+
+#endif
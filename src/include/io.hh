@@ -0,0 +1,90 @@
+#ifndef NUMBERS_IO_HH
+#define NUMBERS_IO_HH
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Stream operators
+//
+// The integer headers do not include any stream header, so that including
+// numbers.h neither pulls in <iostream> nor its static initialization. This
+// header adds operator<< and operator>> for the integer aliases, int128 and
+// uint128.
+//
+// i8 and u8 are written and read as numbers, not characters. int128 and
+// uint128 honour the base, showbase, showpos, width and fill flags when
+// writing and read decimal digits. Reading a value out of range sets failbit
+// and gives the nearest limit, as the standard extractors do.
+//
+// Example:
+//
+//   #include "io.hh"
+//
+//   numbers::i64 a;
+//   std::cin >> a;
+//   std::cout << a * numbers::i64(2) << '\n';
+
+std::ostream &operator<<(std::ostream &os, uint128 v);
+std::ostream &operator<<(std::ostream &os, int128 v);
+std::istream &operator>>(std::istream &is, uint128 &v);
+std::istream &operator>>(std::istream &is, int128 &v);
+
+namespace io_internal {
+
+// The type streamed for T, where the 8-bit types are not characters.
+template <typename T>
+using stream_type_t = std::conditional_t<sizeof(T) == 1, std::conditional_t<std::is_signed_v<T>, int16_t, uint16_t>, T>;
+
+template <typename T>
+T read(std::istream &is) {
+  stream_type_t<T> value{};
+  is >> value;
+  if constexpr (!std::is_same_v<stream_type_t<T>, T>) {
+    if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+      is.setstate(std::ios::failbit);
+      return value < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    }
+  }
+  return static_cast<T>(value);
+}
+
+}  // namespace io_internal
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const Integer<T> &num) {
+  return os << static_cast<io_internal::stream_type_t<T>>(static_cast<T>(num));
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const Uinteger<T> &num) {
+  return os << static_cast<io_internal::stream_type_t<T>>(static_cast<T>(num));
+}
+
+template <typename T>
+std::istream &operator>>(std::istream &is, Integer<T> &num) {
+  num = Integer<T>(io_internal::read<T>(is));
+  return is;
+}
+
+template <typename T>
+std::istream &operator>>(std::istream &is, Uinteger<T> &num) {
+  num = Uinteger<T>(io_internal::read<T>(is));
+  return is;
+}
+
+}  // namespace numbers
+
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/io_impl.hh"
+#endif
+
+#endif
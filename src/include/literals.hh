@@ -0,0 +1,217 @@
+#ifndef NUMBERS_LITERALS_HH
+#define NUMBERS_LITERALS_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Integer literals
+//
+// `using namespace numbers::literals;` enables the suffixes _i8, _i16, _i32,
+// _i64, _i128, _u8, _u16, _u32, _u64 and _u128 on integer literals, in
+// decimal, hexadecimal, octal or binary and with digit separators:
+//
+//   constexpr numbers::u128 big = 340282366920938463463374607431768211455_u128;
+//   constexpr numbers::i128 min = -170141183460469231731687303715884105728_i128;
+//   constexpr numbers::u8 mask = 0xFF_u8;
+//   constexpr numbers::u32 flags = 0b1010'0000_u32;
+//
+// The digits are parsed at compile time, so even 39-digit constants cost
+// nothing at runtime and can be used in constexpr tables. A literal out of
+// range for its type, or a floating literal, is a compile error.
+//
+// In `-x_i64` the minus is applied to the literal `x_i64`, so x must fit in
+// i64. The one exception is the magnitude of MIN, e.g. 128_i8, which may only
+// be negated.
+
+namespace literals_internal {
+
+// A 128-bit magnitude, as long as `overflow` is false.
+struct magnitude {
+  uint64_t hi;
+  uint64_t lo;
+  bool overflow;
+  bool valid;
+};
+
+constexpr int digit_value(char c) noexcept {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+template <char... Cs>
+constexpr magnitude parse() noexcept {
+  constexpr char text[] = {Cs...};
+  constexpr size_t size = sizeof...(Cs);
+  size_t i = 0;
+  uint32_t base = 10;
+  if (size > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+    base = 16;
+    i = 2;
+  } else if (size > 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B')) {
+    base = 2;
+    i = 2;
+  } else if (size > 1 && text[0] == '0') {
+    base = 8;
+    i = 1;
+  }
+
+  // four 32-bit limbs, least significant first
+  uint64_t limbs[4] = {};
+  bool overflow = false;
+  bool valid = true;
+  for (; i < size; ++i) {
+    if (text[i] == '\'') {
+      continue;
+    }
+    const int digit = digit_value(text[i]);
+    if (digit < 0 || static_cast<uint32_t>(digit) >= base) {
+      // a '.', an exponent or a suffix of a floating literal
+      valid = false;
+      break;
+    }
+    uint64_t carry = static_cast<uint64_t>(digit);
+    for (auto &limb : limbs) {
+      const uint64_t next = limb * base + carry;
+      limb = next & 0xFFFFFFFF;
+      carry = next >> 32;
+    }
+    overflow = overflow || carry != 0;
+  }
+  return magnitude{(limbs[3] << 32) | limbs[2], (limbs[1] << 32) | limbs[0], overflow, valid};
+}
+
+// The number of significant bits in the magnitude.
+constexpr int bit_width(const magnitude &m) noexcept {
+  int width = 0;
+  for (uint64_t hi = m.hi; hi != 0; hi >>= 1) {
+    ++width;
+  }
+  if (width != 0) {
+    return width + 64;
+  }
+  for (uint64_t lo = m.lo; lo != 0; lo >>= 1) {
+    ++width;
+  }
+  return width;
+}
+
+// Whether the magnitude is 2^bits.
+constexpr bool is_power_of_two(const magnitude &m, int bits) noexcept {
+  return bits >= 64 ? m.lo == 0 && m.hi == uint64_t{1} << (bits - 64) : m.hi == 0 && m.lo == uint64_t{1} << bits;
+}
+
+template <typename R>
+constexpr R to_raw(const magnitude &m) noexcept {
+  if constexpr (std::is_same_v<R, uint128>) {
+    return make_uint128(m.hi, m.lo);
+  } else if constexpr (std::is_same_v<R, int128>) {
+    return make_int128(static_cast<int64_t>(m.hi), m.lo);
+  } else {
+    return static_cast<R>(m.lo);
+  }
+}
+
+template <typename>
+inline constexpr bool dependent_false_v = false;
+
+// The magnitude of T::MIN, which is only valid negated.
+template <typename T>
+struct min_magnitude {
+  constexpr T operator-() const noexcept { return T(std::numeric_limits<numbers_internal::raw_type_t<T>>::min()); }
+
+  template <typename U>
+  operator U() const noexcept {
+    static_assert(dependent_false_v<U>, "integer literal out of range, only its negation fits");
+    return U();
+  }
+};
+
+template <typename T, char... Cs>
+constexpr auto make() noexcept {
+  using raw_type = numbers_internal::raw_type_t<T>;
+  constexpr magnitude m = parse<Cs...>();
+  static_assert(m.valid, "a numbers literal must be an integer literal");
+  constexpr int digits = std::numeric_limits<raw_type>::digits;
+  if constexpr (std::numeric_limits<raw_type>::is_signed && !m.overflow && is_power_of_two(m, digits)) {
+    return min_magnitude<T>{};
+  } else {
+    static_assert(!m.overflow && bit_width(m) <= digits, "integer literal out of range");
+    return T(to_raw<raw_type>(m));
+  }
+}
+
+}  // namespace literals_internal
+
+inline namespace literals {
+
+template <char... Cs>
+constexpr auto operator""_i8() noexcept {
+  return literals_internal::make<i8, Cs...>();
+}
+
+template <char... Cs>
+constexpr auto operator""_i16() noexcept {
+  return literals_internal::make<i16, Cs...>();
+}
+
+template <char... Cs>
+constexpr auto operator""_i32() noexcept {
+  return literals_internal::make<i32, Cs...>();
+}
+
+template <char... Cs>
+constexpr auto operator""_i64() noexcept {
+  return literals_internal::make<i64, Cs...>();
+}
+
+template <char... Cs>
+constexpr auto operator""_i128() noexcept {
+  return literals_internal::make<i128, Cs...>();
+}
+
+template <char... Cs>
+constexpr u8 operator""_u8() noexcept {
+  return literals_internal::make<u8, Cs...>();
+}
+
+template <char... Cs>
+constexpr u16 operator""_u16() noexcept {
+  return literals_internal::make<u16, Cs...>();
+}
+
+template <char... Cs>
+constexpr u32 operator""_u32() noexcept {
+  return literals_internal::make<u32, Cs...>();
+}
+
+template <char... Cs>
+constexpr u64 operator""_u64() noexcept {
+  return literals_internal::make<u64, Cs...>();
+}
+
+template <char... Cs>
+constexpr u128 operator""_u128() noexcept {
+  return literals_internal::make<u128, Cs...>();
+}
+
+}  // namespace literals
+
+}  // namespace numbers
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef NUMBERS_MIXED_HH
+#define NUMBERS_MIXED_HH
+
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "overflow.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Mixed-type operations
+//
+// Adds, subtracts or multiplies two integers of different signedness or
+// width, e.g. i64 + u64, u32 * i16 or i128 - u64. The result type is
+// `mixed_t<A, B>`: as wide as the wider operand, and signed if either operand
+// is signed, so
+//
+//   mixed_t<i64, u64>  is i64
+//   mixed_t<u32, i16>  is i32
+//   mixed_t<u8, u16>   is u16
+//
+// The operation is exact: the operands are not converted to the result type
+// first, only the result is range checked, and no type wider than the
+// operands is used.
+//
+// The operators throw on overflow, and the checked_, overflowing_,
+// saturating_ and wrapping_ functions behave like their member counterparts.
+//
+// Example:
+//
+//   numbers::i64 balance = -10;
+//   numbers::u64 deposit = 25;
+//   numbers::i64 ret = balance + deposit;  // 15
+//   std::optional<numbers::i64> sum = numbers::checked_add(balance, numbers::u64::MAX);  // std::nullopt
+
+namespace mixed_internal {
+
+using numbers_internal::raw_type_t;
+
+template <size_t Size, bool Signed>
+struct sized;
+
+template <>
+struct sized<1, true> {
+  using type = i8;
+};
+
+template <>
+struct sized<2, true> {
+  using type = i16;
+};
+
+template <>
+struct sized<4, true> {
+  using type = i32;
+};
+
+template <>
+struct sized<8, true> {
+  using type = i64;
+};
+
+template <>
+struct sized<16, true> {
+  using type = i128;
+};
+
+template <>
+struct sized<1, false> {
+  using type = u8;
+};
+
+template <>
+struct sized<2, false> {
+  using type = u16;
+};
+
+template <>
+struct sized<4, false> {
+  using type = u32;
+};
+
+template <>
+struct sized<8, false> {
+  using type = u64;
+};
+
+template <>
+struct sized<16, false> {
+  using type = u128;
+};
+
+template <typename A, typename B>
+using common_t =
+    typename sized<(sizeof(A) > sizeof(B) ? sizeof(A) : sizeof(B)),
+                   numbers_internal::is_signed_integer_v<A> || numbers_internal::is_signed_integer_v<B>>::type;
+
+template <typename A, typename B>
+using enable_if_numbers_t =
+    std::enable_if_t<numbers_internal::is_numbers_type_v<A> && numbers_internal::is_numbers_type_v<B>>;
+
+// Operators are only provided between different types, the members cover the same type.
+template <typename A, typename B>
+using enable_if_mixed_t = std::enable_if_t<numbers_internal::is_numbers_type_v<A> &&
+                                           numbers_internal::is_numbers_type_v<B> && !std::is_same_v<A, B>>;
+
+template <typename N>
+using result_t = numbers_internal::mixed_result<raw_type_t<N>>;
+
+template <typename N, typename A, typename B>
+N unwrap(const result_t<N> &ret, const char *op, A lhs, B rhs) noexcept(false) {
+  if (ret.overflow) {
+    overflow_internal::report(op, static_cast<raw_type_t<A>>(lhs), static_cast<raw_type_t<B>>(rhs));
+  }
+  return N(ret.value);
+}
+
+template <typename N>
+std::optional<N> checked(const result_t<N> &ret) noexcept {
+  if (ret.overflow) {
+    return {};
+  }
+  return N(ret.value);
+}
+
+template <typename N>
+std::tuple<N, bool> overflowing(const result_t<N> &ret) noexcept {
+  return {N(ret.value), ret.overflow};
+}
+
+template <typename N>
+N saturating(const result_t<N> &ret) noexcept {
+  if (ret.overflow) {
+    return ret.negative ? N::MIN : N::MAX;
+  }
+  return N(ret.value);
+}
+
+template <typename A, typename B, typename N = common_t<raw_type_t<A>, raw_type_t<B>>>
+result_t<N> add(A lhs, B rhs) noexcept {
+  return numbers_internal::mixed_add<raw_type_t<N>>(static_cast<raw_type_t<A>>(lhs), static_cast<raw_type_t<B>>(rhs));
+}
+
+template <typename A, typename B, typename N = common_t<raw_type_t<A>, raw_type_t<B>>>
+result_t<N> sub(A lhs, B rhs) noexcept {
+  return numbers_internal::mixed_sub<raw_type_t<N>>(static_cast<raw_type_t<A>>(lhs), static_cast<raw_type_t<B>>(rhs));
+}
+
+template <typename A, typename B, typename N = common_t<raw_type_t<A>, raw_type_t<B>>>
+result_t<N> mul(A lhs, B rhs) noexcept {
+  return numbers_internal::mixed_mul<raw_type_t<N>>(static_cast<raw_type_t<A>>(lhs), static_cast<raw_type_t<B>>(rhs));
+}
+
+}  // namespace mixed_internal
+
+template <typename A, typename B>
+using mixed_t = mixed_internal::common_t<numbers_internal::raw_type_t<A>, numbers_internal::raw_type_t<B>>;
+
+template <typename A, typename B, typename = mixed_internal::enable_if_mixed_t<A, B>>
+mixed_t<A, B> operator+(A lhs, B rhs) noexcept(false) {
+  return mixed_internal::unwrap<mixed_t<A, B>>(mixed_internal::add(lhs, rhs), "add", lhs, rhs);
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::optional<mixed_t<A, B>> checked_add(A lhs, B rhs) noexcept {
+  return mixed_internal::checked<mixed_t<A, B>>(mixed_internal::add(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::tuple<mixed_t<A, B>, bool> overflowing_add(A lhs, B rhs) noexcept {
+  return mixed_internal::overflowing<mixed_t<A, B>>(mixed_internal::add(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> saturating_add(A lhs, B rhs) noexcept {
+  return mixed_internal::saturating<mixed_t<A, B>>(mixed_internal::add(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> wrapping_add(A lhs, B rhs) noexcept {
+  return mixed_t<A, B>(mixed_internal::add(lhs, rhs).value);
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_mixed_t<A, B>>
+mixed_t<A, B> operator-(A lhs, B rhs) noexcept(false) {
+  return mixed_internal::unwrap<mixed_t<A, B>>(mixed_internal::sub(lhs, rhs), "sub", lhs, rhs);
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::optional<mixed_t<A, B>> checked_sub(A lhs, B rhs) noexcept {
+  return mixed_internal::checked<mixed_t<A, B>>(mixed_internal::sub(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::tuple<mixed_t<A, B>, bool> overflowing_sub(A lhs, B rhs) noexcept {
+  return mixed_internal::overflowing<mixed_t<A, B>>(mixed_internal::sub(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> saturating_sub(A lhs, B rhs) noexcept {
+  return mixed_internal::saturating<mixed_t<A, B>>(mixed_internal::sub(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> wrapping_sub(A lhs, B rhs) noexcept {
+  return mixed_t<A, B>(mixed_internal::sub(lhs, rhs).value);
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_mixed_t<A, B>>
+mixed_t<A, B> operator*(A lhs, B rhs) noexcept(false) {
+  return mixed_internal::unwrap<mixed_t<A, B>>(mixed_internal::mul(lhs, rhs), "mul", lhs, rhs);
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::optional<mixed_t<A, B>> checked_mul(A lhs, B rhs) noexcept {
+  return mixed_internal::checked<mixed_t<A, B>>(mixed_internal::mul(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+std::tuple<mixed_t<A, B>, bool> overflowing_mul(A lhs, B rhs) noexcept {
+  return mixed_internal::overflowing<mixed_t<A, B>>(mixed_internal::mul(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> saturating_mul(A lhs, B rhs) noexcept {
+  return mixed_internal::saturating<mixed_t<A, B>>(mixed_internal::mul(lhs, rhs));
+}
+
+template <typename A, typename B, typename = mixed_internal::enable_if_numbers_t<A, B>>
+mixed_t<A, B> wrapping_mul(A lhs, B rhs) noexcept {
+  return mixed_t<A, B>(mixed_internal::mul(lhs, rhs).value);
+}
+
+}  // namespace numbers
+
+#endif
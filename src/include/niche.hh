@@ -0,0 +1,140 @@
+#ifndef NUMBERS_NICHE_HH
+#define NUMBERS_NICHE_HH
+
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "integer.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Nullable integers without extra storage
+//
+// `niche_optional<T>` is an optional numbers integer that keeps the empty
+// state in one reserved value of T, MIN for signed and MAX for unsigned types,
+// so `sizeof(niche_optional<i64>) == 8` where `std::optional<i64>` takes 16
+// bytes. The reserved value itself can not be held: constructing from it gives
+// an empty optional. The values are thus [MIN + 1, MAX] and [0, MAX - 1],
+// which for signed types are symmetric around zero.
+//
+// Apart from that it behaves like std::optional: has_value(), value(), which
+// throws std::bad_optional_access, operator*, operator->, value_or() and
+// reset(), and it converts to and from std::optional<T>. Equality compares the
+// stored integers, so all empty optionals are equal.
+//
+// The checked operations returning it take the overflowing_ member and store
+// the reserved value when it overflows, so there is no branch. A result equal
+// to the reserved value is reported as an overflow as well.
+//
+//   niche_checked_add(a, b)  niche_checked_sub(a, b)  niche_checked_mul(a, b)
+//   niche_checked_div(a, b)  niche_checked_neg(a)     niche_checked_abs(a)
+//
+// niche_checked_div checks before dividing, since MIN / -1 traps, and is also
+// empty for division by zero.
+//
+// Example:
+//
+//   std::vector<numbers::niche_optional<numbers::i64>> column(rows);
+//   for (size_t i = 0; i < rows; ++i) {
+//     column[i] = numbers::niche_checked_mul(price[i], qty[i]);
+//   }
+//   numbers::i64 total = column[0].value_or(0);
+
+template <typename T>
+class niche_optional {
+  static_assert(numbers_internal::is_numbers_type_v<T>, "niche_optional holds a numbers integer type");
+
+  using raw_type = numbers_internal::raw_type_t<T>;
+
+  static constexpr raw_type kNiche = std::numeric_limits<raw_type>::is_signed ? std::numeric_limits<raw_type>::min()
+                                                                               : std::numeric_limits<raw_type>::max();
+
+ public:
+  using value_type = T;
+
+  niche_optional() noexcept : value_(kNiche) {}
+  niche_optional(std::nullopt_t) noexcept : value_(kNiche) {}
+  niche_optional(const T &value) noexcept : value_(value) {}
+  niche_optional(const std::optional<T> &value) noexcept : value_(value ? *value : T(kNiche)) {}
+
+  // The result of an overflowing_ operation, empty if it overflowed.
+  static niche_optional from_overflowing(const std::tuple<T, bool> &ret) noexcept {
+    const auto [value, overflow] = ret;
+    return niche_optional(overflow ? T(kNiche) : value);
+  }
+
+  // The value standing for empty.
+  static T niche() noexcept { return T(kNiche); }
+
+  bool has_value() const noexcept { return static_cast<raw_type>(value_) != kNiche; }
+  explicit operator bool() const noexcept { return has_value(); }
+
+  const T &value() const noexcept(false) {
+    if (!has_value()) {
+      throw std::bad_optional_access();
+    }
+    return value_;
+  }
+  const T &operator*() const noexcept { return value_; }
+  const T *operator->() const noexcept { return &value_; }
+  T value_or(const T &fallback) const noexcept { return has_value() ? value_ : fallback; }
+
+  void reset() noexcept { value_ = T(kNiche); }
+
+  operator std::optional<T>() const noexcept {
+    if (!has_value()) {
+      return {};
+    }
+    return value_;
+  }
+
+  friend bool operator==(const niche_optional &lhs, const niche_optional &rhs) noexcept {
+    return static_cast<raw_type>(lhs.value_) == static_cast<raw_type>(rhs.value_);
+  }
+  friend bool operator!=(const niche_optional &lhs, const niche_optional &rhs) noexcept { return !(lhs == rhs); }
+
+ private:
+  T value_;
+};
+
+template <typename T>
+niche_optional<T> niche_checked_add(const T &a, const numbers_internal::type_identity_t<T> &b) noexcept {
+  return niche_optional<T>::from_overflowing(a.overflowing_add(b));
+}
+
+template <typename T>
+niche_optional<T> niche_checked_sub(const T &a, const numbers_internal::type_identity_t<T> &b) noexcept {
+  return niche_optional<T>::from_overflowing(a.overflowing_sub(b));
+}
+
+template <typename T>
+niche_optional<T> niche_checked_mul(const T &a, const numbers_internal::type_identity_t<T> &b) noexcept {
+  return niche_optional<T>::from_overflowing(a.overflowing_mul(b));
+}
+
+template <typename T>
+niche_optional<T> niche_checked_div(const T &a, const numbers_internal::type_identity_t<T> &b) noexcept {
+  if (b == T(0)) {
+    return std::nullopt;
+  }
+  // overflowing_div would trap on MIN / -1, so this one checks first
+  return a.checked_div(b);
+}
+
+template <typename T>
+niche_optional<T> niche_checked_neg(const T &a) noexcept {
+  return niche_optional<T>::from_overflowing(a.overflowing_neg());
+}
+
+template <typename T>
+niche_optional<T> niche_checked_abs(const T &a) noexcept {
+  return niche_optional<T>::from_overflowing(a.overflowing_abs());
+}
+
+}  // namespace numbers
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef NUMBERS_OVERFLOW_HH
+#define NUMBERS_OVERFLOW_HH
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "int128.hh"
+#include "internal/config.h"
+
+#if NUMBERS_HAVE_BUILTIN(__builtin_FILE) || (defined(__GNUC__) && !defined(__clang__)) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1926)
+#define NUMBERS_INTERNAL_HAVE_SOURCE_LOCATION 1
+#endif
+
+namespace numbers {
+
+// Overflow errors
+//
+// Every throwing operation of the library that overflows, from the integer
+// operators to decimal, rational, fixed, try_from, expr, the fused operations
+// and atomic, throws `numbers::overflow_error`, a std::runtime_error with a
+// message like "add overflow: 2147483647 + 1". op() names the operation,
+// "add", "sub", "mul", "div", "rem", "neg", "abs", "shl" or "cast", lhs() and
+// rhs() are the operands in decimal, rhs() is empty for neg, abs and cast,
+// and location() is the call site:
+//
+//   try {
+//     total = total + price * qty;
+//   } catch (const numbers::overflow_error &err) {
+//     std::cerr << err.op() << ' ' << err.lhs() << ' ' << err.rhs() << '\n';
+//   }
+//
+// The operands are given as the type stores them: the count of units of a
+// decimal or fixed, and "num/den" for a rational. Dividing a decimal or a
+// rational by zero is a "div" overflow. The fused operations and expr check
+// only their whole result, and report the first step that overflows when the
+// operators are applied one at a time.
+//
+// An operator can not see its caller, so the location is empty for the
+// operators; functions taking a source_location, like numbers::ct::add, fill
+// it in.
+//
+// The reporting functions are cold and never inlined: a checked operator
+// compiles to the operation, a compare and a jump to a call, and the message
+// is only built once it overflows.
+
+// A call site, like C++20 std::source_location. Default constructed, or where
+// the compiler can not tell, the file and function are "" and the line is 0.
+class source_location {
+ public:
+  constexpr source_location() noexcept = default;
+
+#ifdef NUMBERS_INTERNAL_HAVE_SOURCE_LOCATION
+  // As a default argument, the location of the caller.
+  static constexpr source_location current(const char *file = __builtin_FILE(), unsigned line = __builtin_LINE(),
+                                           const char *function = __builtin_FUNCTION()) noexcept {
+    source_location location;
+    location.file_ = file;
+    location.line_ = line;
+    location.function_ = function;
+    return location;
+  }
+#else
+  static constexpr source_location current() noexcept { return source_location(); }
+#endif
+
+  constexpr const char *file_name() const noexcept { return file_; }
+  constexpr unsigned line() const noexcept { return line_; }
+  constexpr const char *function_name() const noexcept { return function_; }
+
+ private:
+  const char *file_ = "";
+  unsigned line_ = 0;
+  const char *function_ = "";
+};
+
+namespace overflow_internal {
+
+// Holds two 128-bit values in decimal, with their signs, a slash between them
+// and the terminating zero, as in the fraction "-3/4".
+constexpr size_t kTextSize = 88;
+
+template <typename V>
+NUMBERS_COLD char *append(char *first, char *last, V value) noexcept {
+  if constexpr (std::numeric_limits<V>::is_signed) {
+    return to_chars(first, last, int128(value));
+  } else {
+    return to_chars(first, last, uint128(value));
+  }
+}
+
+template <typename V>
+NUMBERS_COLD void to_text(char (&text)[kTextSize], V value) noexcept {
+  *append(text, text + kTextSize - 1, value) = '\0';
+}
+
+// "num/den", for the operands of a fraction.
+template <typename V>
+NUMBERS_COLD void to_text(char (&text)[kTextSize], V num, V den) noexcept {
+  char *end = append(text, text + kTextSize - 1, num);
+  *end++ = '/';
+  *append(end, text + kTextSize - 1, den) = '\0';
+}
+
+NUMBERS_COLD inline const char *symbol(const char *op) noexcept {
+  if (std::strcmp(op, "add") == 0) {
+    return "+";
+  }
+  if (std::strcmp(op, "sub") == 0) {
+    return "-";
+  }
+  if (std::strcmp(op, "mul") == 0) {
+    return "*";
+  }
+  if (std::strcmp(op, "div") == 0) {
+    return "/";
+  }
+  if (std::strcmp(op, "rem") == 0) {
+    return "%";
+  }
+  if (std::strcmp(op, "shl") == 0) {
+    return "<<";
+  }
+  return op;
+}
+
+// "add overflow: 1 + 2", "neg overflow: neg(-128)", followed by
+// " at file:line in function" when the location is known.
+NUMBERS_COLD inline std::string message(const char *op, const char *lhs, const char *rhs,
+                                     const source_location &location) {
+  std::string text = std::string(op) + " overflow: ";
+  if (*rhs == '\0') {
+    text.append(op).append("(").append(lhs).append(")");
+  } else {
+    text.append(lhs).append(" ").append(symbol(op)).append(" ").append(rhs);
+  }
+  if (location.line() != 0) {
+    text.append(" at ").append(location.file_name()).append(":").append(std::to_string(location.line()));
+    text.append(" in ").append(location.function_name());
+  }
+  return text;
+}
+
+}  // namespace overflow_internal
+
+class overflow_error : public std::runtime_error {
+ public:
+  // lhs and rhs are the operands as text, rhs is "" for a unary operation.
+  NUMBERS_COLD overflow_error(const char *op, const char *lhs, const char *rhs, source_location location = {})
+      : std::runtime_error(overflow_internal::message(op, lhs, rhs, location)), op_(op), location_(location) {
+    copy(lhs_, lhs);
+    copy(rhs_, rhs);
+  }
+
+  const char *op() const noexcept { return op_; }
+  const char *lhs() const noexcept { return lhs_; }
+  const char *rhs() const noexcept { return rhs_; }
+  const source_location &location() const noexcept { return location_; }
+
+ private:
+  // The operands are kept inline, so that copying the error can not throw.
+  static void copy(char (&to)[overflow_internal::kTextSize], const char *from) noexcept {
+    size_t size = std::strlen(from);
+    size = size < sizeof(to) - 1 ? size : sizeof(to) - 1;
+    std::memcpy(to, from, size);
+    to[size] = '\0';
+  }
+
+  const char *op_;
+  char lhs_[overflow_internal::kTextSize];
+  char rhs_[overflow_internal::kTextSize];
+  source_location location_;
+};
+
+namespace overflow_internal {
+
+// Throw the overflow_error of `lhs op rhs`, or of a unary op on value, where
+// the operands are primitive integers. The variants without a location keep
+// the call sites in the operators to a few register moves.
+template <typename L, typename R>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_at(const char *op, L lhs, R rhs, source_location location) {
+  char lhs_text[kTextSize];
+  char rhs_text[kTextSize];
+  to_text(lhs_text, lhs);
+  to_text(rhs_text, rhs);
+  throw overflow_error(op, lhs_text, rhs_text, location);
+}
+
+template <typename L, typename R>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report(const char *op, L lhs, R rhs) {
+  report_at(op, lhs, rhs, source_location());
+}
+
+// The same for `lhs + rhs` and `lhs - rhs`, given the wrapped result in place
+// of lhs. The add or sub instruction overwrites lhs with the result, and
+// working lhs out again here spares the operator a copy of it.
+template <typename T>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_add(T sum, T rhs) {
+  report_at("add", static_cast<T>(uint128(sum) - uint128(rhs)), rhs, source_location());
+}
+
+template <typename T>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_sub(T difference, T rhs) {
+  report_at("sub", static_cast<T>(uint128(difference) + uint128(rhs)), rhs, source_location());
+}
+
+template <typename V>
+[[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_unary(const char *op, V value) {
+  char text[kTextSize];
+  to_text(text, value);
+  throw overflow_error(op, text, "");
+}
+
+}  // namespace overflow_internal
+
+}  // namespace numbers
+
+#endif
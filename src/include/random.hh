@@ -0,0 +1,318 @@
+#ifndef NUMBERS_RANDOM_HH
+#define NUMBERS_RANDOM_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "internal/wide.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Random numbers
+//
+// Two engines meeting the standard UniformRandomBitGenerator requirements,
+// so they also work with <random> distributions and std::shuffle:
+//
+//   pcg64         PCG XSL RR 128/64: a 128-bit LCG with a permuted 64-bit
+//                 output, the same sequence as pcg64 of the PCG reference
+//                 implementation; discard() jumps ahead in O(log n) steps
+//   xoshiro256ss  xoshiro256**: 256 bits of state and no multiplication in
+//                 the state update; jump() skips 2^128 values for parallel
+//                 streams
+//
+// and uniform sampling of any integer type, i8 ... i128, u8 ... u128,
+// int128, uint128 or a built-in integer, from an engine producing 64 random
+// bits at a time:
+//
+//   uniform<T>(engine)           any value of `T`
+//   uniform(engine, lo, hi)      a value in [lo, hi], without bias
+//
+// The bounded sampling is Lemire's multiply-shift method: the random value
+// is multiplied by the size of the range in a type twice as wide, and the
+// high half is the result. A division is only needed for the rare draws
+// that would make the result biased.
+//
+// The bulk variants fill `count` values into `dst`, with the engine state and
+// the rejection threshold kept in registers for the whole loop:
+//
+//   fill(engine, dst, count)
+//   fill_uniform(engine, dst, count, lo, hi)
+//
+// Example:
+//
+//   numbers::pcg64 engine(42);
+//   numbers::u128 id = numbers::uniform<numbers::u128>(engine);
+//   numbers::i32 die = numbers::uniform(engine, numbers::i32(1), numbers::i32(6));
+
+class pcg64 {
+ public:
+  using result_type = uint64_t;
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  pcg64() noexcept : state_(kDefaultState), inc_(kDefaultIncrement) {}
+  explicit pcg64(uint128 seed, uint128 stream = kDefaultStream) noexcept { this->seed(seed, stream); }
+
+  void seed(uint128 seed, uint128 stream = kDefaultStream) noexcept {
+    inc_ = (stream << 1) | 1;
+    state_ = 0;
+    step();
+    state_ += seed;
+    step();
+  }
+
+  result_type operator()() noexcept {
+    step();
+    const uint64_t x = uint128_high64(state_) ^ uint128_low64(state_);
+    const int rot = static_cast<int>(uint128_high64(state_) >> 58);
+    return (x >> rot) | (x << ((64 - rot) & 63));
+  }
+
+  // Advances the state by `z` steps, in O(log z) multiplications.
+  void discard(unsigned long long z) noexcept {
+    uint128 acc_mult = 1;
+    uint128 acc_plus = 0;
+    uint128 cur_mult = kMultiplier;
+    uint128 cur_plus = inc_;
+    for (; z > 0; z >>= 1) {
+      if (z & 1) {
+        acc_mult *= cur_mult;
+        acc_plus = acc_plus * cur_mult + cur_plus;
+      }
+      cur_plus = (cur_mult + 1) * cur_plus;
+      cur_mult *= cur_mult;
+    }
+    state_ = acc_mult * state_ + acc_plus;
+  }
+
+  friend bool operator==(const pcg64 &lhs, const pcg64 &rhs) noexcept {
+    return lhs.state_ == rhs.state_ && lhs.inc_ == rhs.inc_;
+  }
+  friend bool operator!=(const pcg64 &lhs, const pcg64 &rhs) noexcept { return !(lhs == rhs); }
+
+ private:
+  static constexpr uint128 kMultiplier = make_uint128(2549297995355413924ull, 4865540595714422341ull);
+  static constexpr uint128 kDefaultState = make_uint128(0x979c9a98d8462005ull, 0x7d3e9cb6cfe0549bull);
+  static constexpr uint128 kDefaultIncrement = make_uint128(0x0000000000000001ull, 0xda3e39cb94b95bdbull);
+  static constexpr uint128 kDefaultStream = make_uint128(0, 0xed1f1ce5ca5cadedull);
+
+  void step() noexcept { state_ = state_ * kMultiplier + inc_; }
+
+  uint128 state_;
+  uint128 inc_;
+};
+
+class xoshiro256ss {
+ public:
+  using result_type = uint64_t;
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+  xoshiro256ss() noexcept : xoshiro256ss(0) {}
+  explicit xoshiro256ss(uint64_t seed) noexcept { this->seed(seed); }
+  xoshiro256ss(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3) noexcept : s_{s0, s1, s2, s3} {}
+
+  // Expands `seed` with splitmix64, as recommended by the authors, so that no seed gives the all zero state.
+  void seed(uint64_t seed) noexcept {
+    for (auto &s : s_) {
+      seed += 0x9e3779b97f4a7c15ull;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      s = z ^ (z >> 31);
+    }
+  }
+
+  result_type operator()() noexcept {
+    const uint64_t ret = rotl(s_[1] * 5, 7) * 9;
+    const uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 45);
+    return ret;
+  }
+
+  void discard(unsigned long long z) noexcept {
+    for (; z > 0; --z) {
+      (*this)();
+    }
+  }
+
+  // Equivalent to 2^128 calls; gives 2^128 non-overlapping subsequences.
+  void jump() noexcept {
+    constexpr uint64_t kJump[] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull,
+                                  0x39abdc4529b1661cull};
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (uint64_t jump : kJump) {
+      for (int b = 0; b < 64; ++b) {
+        if (jump & (uint64_t{1} << b)) {
+          for (int i = 0; i < 4; ++i) {
+            s[i] ^= s_[i];
+          }
+        }
+        (*this)();
+      }
+    }
+    for (int i = 0; i < 4; ++i) {
+      s_[i] = s[i];
+    }
+  }
+
+  friend bool operator==(const xoshiro256ss &lhs, const xoshiro256ss &rhs) noexcept {
+    return lhs.s_[0] == rhs.s_[0] && lhs.s_[1] == rhs.s_[1] && lhs.s_[2] == rhs.s_[2] && lhs.s_[3] == rhs.s_[3];
+  }
+  friend bool operator!=(const xoshiro256ss &lhs, const xoshiro256ss &rhs) noexcept { return !(lhs == rhs); }
+
+ private:
+  static uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+  uint64_t s_[4];
+};
+
+namespace random_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename T>
+constexpr bool is_integer_v = numbers_internal::is_numbers_type_v<T> || numbers_internal::is_integer_v<T>;
+
+template <typename T>
+using enable_if_integer_t = std::enable_if_t<is_integer_v<T>>;
+
+// The unsigned type the sampling works in: at least 32 bits wide, so that narrow types cost one draw.
+template <typename T>
+using work_t = std::conditional_t<sizeof(T) <= sizeof(uint32_t), uint32_t,
+                                  std::conditional_t<sizeof(T) <= sizeof(uint64_t), uint64_t, uint128>>;
+
+template <typename Engine>
+constexpr void check_engine() noexcept {
+  static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<uint64_t>::max(),
+                "the engine must produce 64 random bits per call");
+}
+
+template <typename U, typename Engine>
+U bits(Engine &engine) {
+  if constexpr (std::is_same_v<U, uint32_t>) {
+    // the high bits are the better ones for some engines
+    return static_cast<uint32_t>(engine() >> 32);
+  } else if constexpr (std::is_same_v<U, uint64_t>) {
+    return engine();
+  } else {
+    const uint64_t hi = engine();
+    return make_uint128(hi, engine());
+  }
+}
+
+// The full product of `x` and `s`, split into its low and high halves.
+template <typename U>
+void multiply(U x, U s, U &lo, U &hi) noexcept {
+  if constexpr (std::is_same_v<U, uint32_t>) {
+    const uint64_t m = uint64_t{x} * s;
+    lo = static_cast<uint32_t>(m);
+    hi = static_cast<uint32_t>(m >> 32);
+  } else if constexpr (std::is_same_v<U, uint64_t>) {
+    const uint128 m = uint128(x) * s;
+    lo = uint128_low64(m);
+    hi = uint128_high64(m);
+  } else {
+    using wide = numbers_internal::wide256<false>;
+    const wide m = wide::from(x) * wide::from(s);
+    lo = make_uint128(m.word(1), m.word(0));
+    hi = make_uint128(m.word(3), m.word(2));
+  }
+}
+
+// Draws a value in [0, s) for s > 0. The products whose low half is below
+// 2^N mod s are rejected. That bound needs a division, and it is only looked
+// at when the low half is below s, so it is computed then and cached in
+// `threshold`; 0 means not computed yet.
+template <typename U, typename Engine>
+U bounded(Engine &engine, U s, U &threshold) {
+  U lo, hi;
+  multiply(bits<U>(engine), s, lo, hi);
+  if (lo < s) {
+    if (threshold == 0) {
+      threshold = (U(0) - s) % s;
+    }
+    while (lo < threshold) {
+      multiply(bits<U>(engine), s, lo, hi);
+    }
+  }
+  return hi;
+}
+
+template <typename T, typename Engine>
+T sample(Engine &engine, T lo, T hi, work_t<raw_type_t<T>> &threshold) {
+  using R = raw_type_t<T>;
+  using U = work_t<R>;
+  // sign or zero extending both ends keeps their difference
+  const U base = static_cast<U>(static_cast<R>(lo));
+  const U range = static_cast<U>(static_cast<R>(hi)) - base;
+  if (range == std::numeric_limits<U>::max()) {
+    return T(static_cast<R>(bits<U>(engine)));
+  }
+  return T(static_cast<R>(base + bounded(engine, static_cast<U>(range + 1), threshold)));
+}
+
+template <typename T>
+void check_range(T lo, T hi) noexcept(false) {
+  if (hi < lo) {
+    throw std::runtime_error("uniform empty range");
+  }
+}
+
+}  // namespace random_internal
+
+template <typename T, typename Engine, typename = random_internal::enable_if_integer_t<T>>
+T uniform(Engine &engine) {
+  random_internal::check_engine<Engine>();
+  using R = numbers_internal::raw_type_t<T>;
+  return T(static_cast<R>(random_internal::bits<random_internal::work_t<R>>(engine)));
+}
+
+template <typename T, typename Engine, typename = random_internal::enable_if_integer_t<T>>
+T uniform(Engine &engine, T lo, T hi) noexcept(false) {
+  random_internal::check_engine<Engine>();
+  random_internal::check_range(lo, hi);
+  random_internal::work_t<numbers_internal::raw_type_t<T>> threshold = 0;
+  return random_internal::sample(engine, lo, hi, threshold);
+}
+
+template <typename T, typename Engine, typename = random_internal::enable_if_integer_t<T>>
+void fill(Engine &engine, T *dst, size_t count) {
+  random_internal::check_engine<Engine>();
+  Engine local = engine;
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = uniform<T>(local);
+  }
+  engine = local;
+}
+
+template <typename T, typename Engine, typename = random_internal::enable_if_integer_t<T>>
+void fill_uniform(Engine &engine, T *dst, size_t count, T lo, T hi) noexcept(false) {
+  random_internal::check_engine<Engine>();
+  random_internal::check_range(lo, hi);
+  Engine local = engine;
+  random_internal::work_t<numbers_internal::raw_type_t<T>> threshold = 0;
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = random_internal::sample(local, lo, hi, threshold);
+  }
+  engine = local;
+}
+
+}  // namespace numbers
+
+#endif
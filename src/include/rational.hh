@@ -0,0 +1,606 @@
+#ifndef NUMBERS_RATIONAL_HH
+#define NUMBERS_RATIONAL_HH
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "int128.hh"
+#include "integer.hh"
+#include "internal/bits.hh"
+#include "internal/config.h"
+#include "internal/divide.hh"
+#include "internal/traits.hh"
+#include "internal/wide.hh"
+#include "overflow.hh"
+
+namespace numbers {
+
+// Rational numbers
+//
+// `rational<IntT>` is an exact fraction of two i64 or i128 values, kept
+// normalized: the denominator is positive, numerator and denominator have no
+// common factor, and zero is 0/1. Common factors are found with the binary
+// gcd, which needs no division.
+//
+// The operations cancel common factors first, as in Knuth's algorithms, and
+// form the remaining products in twice the width, int128 for i64 and 256 bits
+// for i128, so they only fail when the reduced result itself does not fit.
+//
+//   a + b, a - b, a * b, a / b   throw numbers::overflow_error if the result does not fit
+//   checked_add(b) ...           std::nullopt if the result does not fit
+//   saturating_add(b) ...        MIN or MAX if the result is beyond them; a result
+//                                within them that does not fit is rounded to the
+//                                nearest fraction that does, the best rational
+//                                approximation from its continued fraction
+//
+// A wrapped fraction has no meaning, so there are no overflowing_ or wrapping_
+// variants. Dividing by zero throws a "div" overflow_error; checked_div
+// returns std::nullopt, and saturating_div gives MIN or MAX by the sign, or 0
+// for 0/0.
+//
+// Comparisons multiply across, a/b < c/d as a * d < c * b in the wide type,
+// instead of dividing.
+//
+//   from(num, den)           normalizes num/den, throwing if den is 0 or the
+//                            result does not fit, like 1/MIN
+//   checked_from(num, den)   std::nullopt instead of throwing
+//   numerator(), denominator(), to_double()
+//
+// Example:
+//
+//   using ratio = numbers::rational<numbers::i64>;
+//   ratio a = ratio::from(numbers::i64(1), numbers::i64(3));
+//   ratio b = a + ratio::from(numbers::i64(1), numbers::i64(6));  // 1/2
+//   bool less = a < b;                                          // true
+
+namespace rational_internal {
+
+using numbers_internal::magnitude256;
+
+template <typename T>
+using unsigned_t = std::conditional_t<std::is_same_v<T, int128>, uint128, uint64_t>;
+
+inline int trailing_zeros(uint64_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int i = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    ++i;
+  }
+  return i;
+#endif
+}
+
+inline int trailing_zeros(uint128 x) noexcept {
+  const uint64_t lo = uint128_low64(x);
+  return lo != 0 ? trailing_zeros(lo) : 64 + trailing_zeros(uint128_high64(x));
+}
+
+// Stein's binary gcd: the common twos are set aside, and then the smaller odd
+// value is subtracted from the larger until they meet.
+template <typename U>
+U gcd(U a, U b) noexcept {
+  if (a == 0) {
+    return b;
+  }
+  if (b == 0) {
+    return a;
+  }
+  const int shift = trailing_zeros(a | b);
+  a >>= trailing_zeros(a);
+  do {
+    b >>= trailing_zeros(b);
+    if (a > b) {
+      const U t = a;
+      a = b;
+      b = t;
+    }
+    b -= a;
+  } while (b != 0);
+  return a << shift;
+}
+
+template <typename T>
+unsigned_t<T> magnitude_of(T v) noexcept {
+  using U = unsigned_t<T>;
+  return v < 0 ? U(0) - U(v) : U(v);
+}
+
+inline magnitude256 widen(uint64_t v) noexcept { return {{v, 0, 0, 0}}; }
+inline magnitude256 widen(uint128 v) noexcept { return {{uint128_low64(v), uint128_high64(v), 0, 0}}; }
+
+template <typename U>
+U narrow(const magnitude256 &m) noexcept {
+  if constexpr (std::is_same_v<U, uint128>) {
+    return make_uint128(m.w[1], m.w[0]);
+  } else {
+    return m.w[0];
+  }
+}
+
+// Divides `m` in place by `d` and returns the remainder.
+template <typename U>
+U divide(magnitude256 &m, U d) noexcept {
+  return narrow<U>(widen(numbers_internal::divide(m, d)));
+}
+
+template <typename U>
+U quotient(U n, U d) noexcept {
+  if constexpr (std::is_same_v<U, uint128>) {
+    if (d == 1) {
+      return n;
+    }
+    magnitude256 m = widen(n);
+    divide(m, d);
+    return narrow<U>(m);
+  } else {
+    return n / d;
+  }
+}
+
+inline magnitude256 product(uint64_t a, uint64_t b) noexcept { return widen(uint128(a) * b); }
+inline magnitude256 product(uint128 a, uint128 b) noexcept { return numbers_internal::multiply(widen(a), widen(b)); }
+
+inline bool is_zero(const magnitude256 &m) noexcept { return (m.w[0] | m.w[1] | m.w[2] | m.w[3]) == 0; }
+
+inline bool less(const magnitude256 &a, const magnitude256 &b) noexcept {
+  for (int i = 3; i >= 0; --i) {
+    if (a.w[i] != b.w[i]) {
+      return a.w[i] < b.w[i];
+    }
+  }
+  return false;
+}
+
+inline magnitude256 add(const magnitude256 &a, const magnitude256 &b) noexcept {
+  magnitude256 ret;
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; ++i) {
+    const uint64_t sum = a.w[i] + b.w[i];
+    ret.w[i] = sum + carry;
+    carry = (sum < a.w[i]) | (ret.w[i] < sum);
+  }
+  return ret;
+}
+
+// a - b for b <= a.
+inline magnitude256 sub(const magnitude256 &a, const magnitude256 &b) noexcept {
+  magnitude256 ret;
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; ++i) {
+    const uint64_t diff = a.w[i] - b.w[i];
+    ret.w[i] = diff - borrow;
+    borrow = (a.w[i] < b.w[i]) | (diff < borrow);
+  }
+  return ret;
+}
+
+inline int bit_width(const magnitude256 &m) noexcept {
+  for (int i = 3; i >= 0; --i) {
+    if (m.w[i] != 0) {
+      return 64 * i + 64 - numbers_internal::count_leading_zeroes(m.w[i]);
+    }
+  }
+  return 0;
+}
+
+// m >> k and m << k for 0 <= k < 256, the bits shifted out dropped.
+inline magnitude256 shift_right(const magnitude256 &m, int k) noexcept {
+  magnitude256 ret{{0, 0, 0, 0}};
+  const int words = k / 64;
+  const int bits = k % 64;
+  for (int i = 0; i + words < 4; ++i) {
+    const uint64_t next = i + words + 1 < 4 ? m.w[i + words + 1] : 0;
+    ret.w[i] = bits == 0 ? m.w[i + words] : (m.w[i + words] >> bits) | (next << (64 - bits));
+  }
+  return ret;
+}
+
+inline magnitude256 shift_left(const magnitude256 &m, int k) noexcept {
+  magnitude256 ret{{0, 0, 0, 0}};
+  const int words = k / 64;
+  const int bits = k % 64;
+  for (int i = 3; i >= words; --i) {
+    const uint64_t next = i - words - 1 >= 0 ? m.w[i - words - 1] : 0;
+    ret.w[i] = bits == 0 ? m.w[i - words] : (m.w[i - words] << bits) | (next >> (64 - bits));
+  }
+  return ret;
+}
+
+template <typename U>
+bool at_most(const magnitude256 &m, U limit) noexcept {
+  return !less(widen(limit), m);
+}
+
+// An exact result before it is narrowed: (negative ? -num : num) / den, reduced.
+struct fraction {
+  bool negative;
+  magnitude256 num;
+  magnitude256 den;
+};
+
+inline fraction make_fraction(bool negative, const magnitude256 &num, const magnitude256 &den) noexcept {
+  if (is_zero(num)) {
+    return {false, num, {{1, 0, 0, 0}}};
+  }
+  return {negative, num, den};
+}
+
+// (an / ad) * (bn / bd), cancelling across first: gcd(an, bd) and gcd(bn, ad).
+template <typename U>
+fraction multiply(bool negative, U an, U ad, U bn, U bd) noexcept {
+  const U g1 = gcd(an, bd);
+  const U g2 = gcd(bn, ad);
+  return make_fraction(negative, product(quotient(an, g1), quotient(bn, g2)),
+                       product(quotient(ad, g2), quotient(bd, g1)));
+}
+
+// ±an/ad ± bn/bd. With g = gcd(ad, bd) the sum is t / (ad/g * bd) for
+// t = an * (bd/g) ± bn * (ad/g), and t can only share factors of g with that.
+template <typename U>
+fraction add(bool a_negative, U an, U ad, bool b_negative, U bn, U bd) noexcept {
+  const U g = gcd(ad, bd);
+  const U ad_g = quotient(ad, g);
+  const magnitude256 x = product(an, quotient(bd, g));
+  const magnitude256 y = product(bn, ad_g);
+  magnitude256 t;
+  bool negative;
+  if (a_negative == b_negative) {
+    t = add(x, y);
+    negative = a_negative;
+  } else if (less(x, y)) {
+    t = sub(y, x);
+    negative = b_negative;
+  } else {
+    t = sub(x, y);
+    negative = a_negative;
+  }
+  U g2 = 1;
+  if (g != 1) {
+    magnitude256 r = t;
+    g2 = gcd(divide(r, g), g);
+  }
+  if (g2 != 1) {
+    divide(t, g2);
+  }
+  return make_fraction(negative, t, product(ad_g, quotient(bd, g2)));
+}
+
+// Stores the fraction in `num` and `den` and returns true if it does not fit `T`.
+template <typename T>
+bool to_raw(const fraction &f, T &num, T &den) noexcept {
+  using U = unsigned_t<T>;
+  const U max = U(std::numeric_limits<T>::max());
+  if (!at_most(f.den, max) || !at_most(f.num, f.negative ? max + 1 : max)) {
+    return true;
+  }
+  const U n = narrow<U>(f.num);
+  num = static_cast<T>(f.negative ? U(0) - n : n);
+  den = static_cast<T>(narrow<U>(f.den));
+  return false;
+}
+
+// a / b for a non-zero b, leaving a % b in `a`. Most quotients of a
+// continued fraction are 1, 2 or 3, so those are subtracted out, and the
+// rest of the quotient is found a bit at a time.
+inline magnitude256 long_divide(magnitude256 &a, const magnitude256 &b) noexcept {
+  uint64_t small = 0;
+  for (; small < 3; ++small) {
+    if (less(a, b)) {
+      return widen(small);
+    }
+    a = sub(a, b);
+  }
+  magnitude256 q{{0, 0, 0, 0}};
+  int shift = bit_width(a) - bit_width(b);
+  magnitude256 d = shift_left(b, shift > 0 ? shift : 0);
+  for (; shift >= 0; --shift) {
+    if (!less(a, d)) {
+      a = sub(a, d);
+      q.w[shift / 64] |= uint64_t{1} << (shift % 64);
+    }
+    d = shift_right(d, 1);
+  }
+  return add(q, widen(small));
+}
+
+// The same for the fractions of two i64, whose parts fit 128 bits.
+inline uint128 long_divide(uint128 &a, uint128 b) noexcept {
+  uint128 q = 0;
+  for (; q < 3; ++q) {
+    if (a < b) {
+      return q;
+    }
+    a -= b;
+  }
+  const uint128 rest = a / b;
+  a -= rest * b;
+  return q + rest;
+}
+
+inline bool less(uint128 a, uint128 b) noexcept { return a < b; }
+inline bool is_zero(uint128 m) noexcept { return m == 0; }
+inline const magnitude256 &widen(const magnitude256 &m) noexcept { return m; }
+
+template <typename U>
+bool at_most(uint128 m, U limit) noexcept {
+  return m <= uint128(limit);
+}
+
+template <typename U>
+U narrow(uint128 m) noexcept {
+  return U(m);
+}
+
+// Whether step * h + h0 <= limit.
+inline bool step_fits(uint64_t step, uint64_t h, uint64_t h0, uint64_t limit) noexcept {
+  return uint128(step) * h + h0 <= limit;
+}
+
+inline bool step_fits(uint128 step, uint128 h, uint128 h0, uint128 limit) noexcept {
+  return at_most(add(product(step, h), widen(h0)), limit);
+}
+
+// m * k, for a product known to fit 256 bits.
+template <typename U>
+magnitude256 scale(const magnitude256 &m, U k) noexcept {
+  const magnitude256 high{{m.w[2], m.w[3], 0, 0}};
+  return add(numbers_internal::multiply(m, widen(k)), shift_left(numbers_internal::multiply(high, widen(k)), 128));
+}
+
+// The nearest fraction to y/z whose numerator and denominator fit, for one
+// that does not, found on its continued fraction. With h1/k1 the last
+// convergent and h0/k0 the one before, the value is
+// (h1 y/z + h0) / (k1 y/z + k0) for the complete quotient y/z. The expansion
+// stops at the first partial quotient a that would step past a limit; the
+// best fractions are then the semiconvergent s = (t h1 + h0) / (t k1 + k0),
+// for the largest t < a that fits, and h1/k1, since every fraction between
+// them is wider than both. A value beyond the limits ends on the integer MIN
+// or MAX.
+template <typename T, typename W>
+void approximate(bool negative, W y, W z, T &num, T &den) noexcept {
+  using U = unsigned_t<T>;
+  const U max_den = U(std::numeric_limits<T>::max());
+  const U max_num = negative ? max_den + 1 : max_den;
+  U h0 = 0;
+  U k0 = 1;
+  U h1 = 1;
+  U k1 = 0;
+  for (;;) {
+    W r = y;
+    const W a = long_divide(r, z);
+    const U step = narrow<U>(a);
+    if (at_most(a, max_num) && step_fits(step, h1, h0, max_num) && step_fits(step, k1, k0, max_den)) {
+      const U h = step * h1 + h0;
+      const U k = step * k1 + k0;
+      h0 = h1;
+      k0 = k1;
+      h1 = h;
+      k1 = k;
+      if (is_zero(r)) {
+        break;
+      }
+      y = z;
+      z = r;
+      continue;
+    }
+    // s is nearer than h1/k1 when y k1 < (2 t k1 + k0) z. As k1 y + k0 z is
+    // the denominator of the value, neither side needs more than 256 bits.
+    const U t_num = h1 == 0 ? std::numeric_limits<U>::max() : (max_num - h0) / h1;
+    const U t_den = k1 == 0 ? std::numeric_limits<U>::max() : (max_den - k0) / k1;
+    const U t = t_num < t_den ? t_num : t_den;
+    const U ks = t * k1 + k0;
+    if (k1 == 0 || less(scale(widen(y), k1), scale(widen(z), ks + t * k1))) {
+      h1 = t * h1 + h0;
+      k1 = ks;
+    }
+    break;
+  }
+  num = static_cast<T>(negative ? U(0) - h1 : h1);
+  den = static_cast<T>(k1);
+}
+
+template <typename T>
+void approximate(const fraction &f, T &num, T &den) noexcept {
+  if constexpr (std::is_same_v<T, int128>) {
+    approximate(f.negative, f.num, f.den, num, den);
+  } else {
+    approximate(f.negative, narrow<uint128>(f.num), narrow<uint128>(f.den), num, den);
+  }
+}
+
+// The sign of a/b - c/d for positive b and d.
+template <typename T>
+int compare(T a, T b, T c, T d) noexcept {
+  if (b == d) {
+    return a < c ? -1 : a > c;
+  }
+  if constexpr (std::is_same_v<T, int128>) {
+    using wide = numbers_internal::wide256<true>;
+    const wide x = wide::from(a) * wide::from(d);
+    const wide y = wide::from(c) * wide::from(b);
+    return x < y ? -1 : y < x;
+  } else {
+    const int128 x = int128(a) * d;
+    const int128 y = int128(c) * b;
+    return x < y ? -1 : x > y;
+  }
+}
+
+}  // namespace rational_internal
+
+template <typename IntT>
+class rational {
+  static_assert(std::is_same_v<IntT, i64> || std::is_same_v<IntT, i128>, "rational storage is i64 or i128");
+
+  using raw_type = numbers_internal::raw_type_t<IntT>;
+  using unsigned_type = rational_internal::unsigned_t<raw_type>;
+
+ public:
+  constexpr rational() noexcept : num_(0), den_(1) {}
+  constexpr explicit rational(IntT whole) noexcept : num_(static_cast<raw_type>(whole)), den_(1) {}
+
+  static std::optional<rational> checked_from(IntT num, IntT den) noexcept {
+    const raw_type n = static_cast<raw_type>(num);
+    const raw_type d = static_cast<raw_type>(den);
+    if (d == 0) {
+      return {};
+    }
+    const unsigned_type un = rational_internal::magnitude_of(n);
+    const unsigned_type ud = rational_internal::magnitude_of(d);
+    const unsigned_type g = rational_internal::gcd(un, ud);
+    const unsigned_type reduced_num = rational_internal::quotient(un, g);
+    const unsigned_type reduced_den = rational_internal::quotient(ud, g);
+    return from_fraction(rational_internal::make_fraction(
+        (n < 0) != (d < 0), rational_internal::widen(reduced_num), rational_internal::widen(reduced_den)));
+  }
+
+  static rational from(IntT num, IntT den) noexcept(false) {
+    const std::optional<rational> ret = checked_from(num, den);
+    if (!ret) {
+      overflow_internal::report("div", static_cast<raw_type>(num), static_cast<raw_type>(den));
+    }
+    return *ret;
+  }
+
+  inline static const rational MIN = rational(IntT(std::numeric_limits<raw_type>::min()));
+  inline static const rational MAX = rational(IntT(std::numeric_limits<raw_type>::max()));
+
+  constexpr IntT numerator() const noexcept { return IntT(num_); }
+  constexpr IntT denominator() const noexcept { return IntT(den_); }
+
+  double to_double() const noexcept { return static_cast<double>(num_) / static_cast<double>(den_); }
+
+  rational operator+(const rational &other) const noexcept(false) {
+    const std::optional<rational> ret = checked_add(other);
+    if (!ret) {
+      report("add", other);
+    }
+    return *ret;
+  }
+  std::optional<rational> checked_add(const rational &other) const noexcept { return from_fraction(sum(other, false)); }
+  rational saturating_add(const rational &other) const noexcept { return approximate(sum(other, false)); }
+
+  rational operator-(const rational &other) const noexcept(false) {
+    const std::optional<rational> ret = checked_sub(other);
+    if (!ret) {
+      report("sub", other);
+    }
+    return *ret;
+  }
+  std::optional<rational> checked_sub(const rational &other) const noexcept { return from_fraction(sum(other, true)); }
+  rational saturating_sub(const rational &other) const noexcept { return approximate(sum(other, true)); }
+
+  rational operator-() const noexcept(false) {
+    if (num_ == std::numeric_limits<raw_type>::min()) {
+      report_neg();
+    }
+    rational ret;
+    ret.num_ = -num_;
+    ret.den_ = den_;
+    return ret;
+  }
+
+  rational operator*(const rational &other) const noexcept(false) {
+    const std::optional<rational> ret = checked_mul(other);
+    if (!ret) {
+      report("mul", other);
+    }
+    return *ret;
+  }
+  std::optional<rational> checked_mul(const rational &other) const noexcept {
+    return from_fraction(product(other, false));
+  }
+  rational saturating_mul(const rational &other) const noexcept { return approximate(product(other, false)); }
+
+  rational operator/(const rational &other) const noexcept(false) {
+    const std::optional<rational> ret = checked_div(other);
+    if (!ret) {
+      report("div", other);
+    }
+    return *ret;
+  }
+  std::optional<rational> checked_div(const rational &other) const noexcept {
+    if (other.num_ == 0) {
+      return {};
+    }
+    return from_fraction(product(other, true));
+  }
+  rational saturating_div(const rational &other) const noexcept {
+    if (other.num_ == 0) {
+      return num_ == 0 ? rational() : num_ < 0 ? MIN : MAX;
+    }
+    return approximate(product(other, true));
+  }
+
+  friend bool operator==(const rational &lhs, const rational &rhs) noexcept {
+    return lhs.num_ == rhs.num_ && lhs.den_ == rhs.den_;
+  }
+  friend bool operator!=(const rational &lhs, const rational &rhs) noexcept { return !(lhs == rhs); }
+  friend bool operator<(const rational &lhs, const rational &rhs) noexcept { return lhs.compare(rhs) < 0; }
+  friend bool operator<=(const rational &lhs, const rational &rhs) noexcept { return lhs.compare(rhs) <= 0; }
+  friend bool operator>(const rational &lhs, const rational &rhs) noexcept { return lhs.compare(rhs) > 0; }
+  friend bool operator>=(const rational &lhs, const rational &rhs) noexcept { return lhs.compare(rhs) >= 0; }
+
+ private:
+  int compare(const rational &other) const noexcept {
+    return rational_internal::compare(num_, den_, other.num_, other.den_);
+  }
+
+  rational_internal::fraction sum(const rational &other, bool subtract) const noexcept {
+    return rational_internal::add(num_ < 0, rational_internal::magnitude_of(num_), unsigned_type(den_),
+                                  (other.num_ < 0) != subtract, rational_internal::magnitude_of(other.num_),
+                                  unsigned_type(other.den_));
+  }
+
+  // this * other, or this / other for a non-zero `other`.
+  rational_internal::fraction product(const rational &other, bool divide) const noexcept {
+    const unsigned_type on = rational_internal::magnitude_of(other.num_);
+    const unsigned_type od = unsigned_type(other.den_);
+    return rational_internal::multiply((num_ < 0) != (other.num_ < 0), rational_internal::magnitude_of(num_),
+                                       unsigned_type(den_), divide ? od : on, divide ? on : od);
+  }
+
+  static std::optional<rational> from_fraction(const rational_internal::fraction &f) noexcept {
+    rational ret;
+    if (rational_internal::to_raw(f, ret.num_, ret.den_)) {
+      return {};
+    }
+    return ret;
+  }
+
+  static rational approximate(const rational_internal::fraction &f) noexcept {
+    rational ret;
+    if (rational_internal::to_raw(f, ret.num_, ret.den_)) {
+      rational_internal::approximate(f, ret.num_, ret.den_);
+    }
+    return ret;
+  }
+
+  // Throws the overflow_error of `*this op other`, with the operands as
+  // "num/den".
+  [[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report(const char *op, const rational &other) const {
+    char lhs[overflow_internal::kTextSize];
+    char rhs[overflow_internal::kTextSize];
+    overflow_internal::to_text(lhs, num_, den_);
+    overflow_internal::to_text(rhs, other.num_, other.den_);
+    throw overflow_error(op, lhs, rhs);
+  }
+
+  [[noreturn]] NUMBERS_COLD NUMBERS_NOINLINE void report_neg() const {
+    char text[overflow_internal::kTextSize];
+    overflow_internal::to_text(text, num_, den_);
+    throw overflow_error("neg", text, "");
+  }
+
+  raw_type num_;
+  raw_type den_;
+};
+
+}  // namespace numbers
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef NUMBERS_SHARDED_COUNTER_HH
+#define NUMBERS_SHARDED_COUNTER_HH
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+#include "atomic.hh"
+#include "integer.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+namespace numbers {
+
+// Sharded counters
+//
+// `sharded_counter<N>` spreads a counter over `shards` slots, each on its own
+// cache line, so that threads adding to it do not fight over one line. Each
+// thread is given a slot the first time it adds to any counter, round robin,
+// and a slot is only shared by threads whose number differs by a multiple of
+// the shard count. Adding is a saturating add on that slot, which is never
+// contended when there are at least as many shards as threads.
+//
+// Reading sums the slots, so it costs one cache miss per shard and is meant
+// for the metrics scraper rather than the hot path:
+//
+//   load()          the saturating sum, in `N`
+//   checked_load()  the sum, or std::nullopt if it does not fit `N`
+//   load_as<W>()    the saturating sum in a type holding every value of `N`:
+//                   as wide and of the same signedness, or signed and wider,
+//                   e.g. u128, which does not overflow for a u64 counter
+//
+// A slot that saturated stays at N::MAX, so once that happens the sum is a
+// lower bound.
+//
+// Example:
+//
+//   numbers::sharded_counter<numbers::u64> requests;  // one shard per hardware thread
+//   requests.add(numbers::u64(1));
+//   numbers::u64 total = requests.load();
+
+namespace sharded_internal {
+
+constexpr size_t kCacheLine = 64;
+
+// The index of the calling thread, assigned the first time it asks.
+inline size_t thread_index() noexcept {
+  static std::atomic<size_t> next{0};
+  thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+inline size_t round_up_to_power_of_two(size_t n) noexcept {
+  size_t ret = 1;
+  while (ret < n) {
+    ret *= 2;
+  }
+  return ret;
+}
+
+// Whether every value of N is a value of W.
+template <typename W, typename N>
+constexpr bool holds_all() noexcept {
+  constexpr bool kSignedW = std::numeric_limits<numbers_internal::raw_type_t<W>>::is_signed;
+  constexpr bool kSignedN = std::numeric_limits<numbers_internal::raw_type_t<N>>::is_signed;
+  return kSignedW == kSignedN ? sizeof(W) >= sizeof(N) : kSignedW && sizeof(W) > sizeof(N);
+}
+
+template <typename W, typename N>
+constexpr bool holds_all_v = holds_all<W, N>();
+
+}  // namespace sharded_internal
+
+template <typename N>
+class sharded_counter {
+  static_assert(numbers_internal::is_numbers_type_v<N>, "sharded_counter needs one of the aliases");
+
+ public:
+  // The shard count is rounded up to a power of two; 0 means one per hardware thread.
+  explicit sharded_counter(size_t shards = 0)
+      : mask_(sharded_internal::round_up_to_power_of_two(shards ? shards : std::thread::hardware_concurrency()) - 1),
+        slots_(new slot[mask_ + 1]) {}
+
+  sharded_counter(const sharded_counter &) = delete;
+  sharded_counter &operator=(const sharded_counter &) = delete;
+
+  size_t shards() const noexcept { return mask_ + 1; }
+
+  void add(N delta) noexcept {
+    slots_[sharded_internal::thread_index() & mask_].value.fetch_saturating_add(delta, std::memory_order_relaxed);
+  }
+
+  N load() const noexcept {
+    N ret = N(0);
+    for (size_t i = 0; i <= mask_; ++i) {
+      ret = ret.saturating_add(slots_[i].value.load(std::memory_order_relaxed));
+    }
+    return ret;
+  }
+
+  std::optional<N> checked_load() const noexcept {
+    N ret = N(0);
+    for (size_t i = 0; i <= mask_; ++i) {
+      const std::optional<N> sum = ret.checked_add(slots_[i].value.load(std::memory_order_relaxed));
+      if (!sum) {
+        return {};
+      }
+      ret = *sum;
+    }
+    return ret;
+  }
+
+  template <typename W>
+  W load_as() const noexcept {
+    static_assert(numbers_internal::is_numbers_type_v<W> && sharded_internal::holds_all_v<W, N>,
+                  "load_as needs an alias holding every value of N");
+    using raw_type = numbers_internal::raw_type_t<W>;
+    W ret = W(0);
+    for (size_t i = 0; i <= mask_; ++i) {
+      const auto value = static_cast<numbers_internal::raw_type_t<N>>(slots_[i].value.load(std::memory_order_relaxed));
+      ret = ret.saturating_add(W(static_cast<raw_type>(value)));
+    }
+    return ret;
+  }
+
+  // Not atomic with respect to concurrent adds, which may land before or after.
+  void reset() noexcept {
+    for (size_t i = 0; i <= mask_; ++i) {
+      slots_[i].value.store(N(0), std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  struct alignas(sharded_internal::kCacheLine) slot {
+    atomic<N> value;
+  };
+
+  const size_t mask_;
+  const std::unique_ptr<slot[]> slots_;
+};
+
+}  // namespace numbers
+
+#endif
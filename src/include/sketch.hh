@@ -0,0 +1,361 @@
+#ifndef NUMBERS_SKETCH_HH
+#define NUMBERS_SKETCH_HH
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "bits.hh"
+#include "hash.hh"
+#include "internal/hash.hh"
+#include "internal/mixed.hh"
+#include "internal/traits.hh"
+#include "uinteger.hh"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NUMBERS_SKETCH_SSE2 1
+#endif
+
+namespace numbers {
+
+// Sketches
+//
+// Two fixed size summaries of a stream of integer keys, hashed with the same
+// multiply-fold mixer as numbers::hash. The keys are any of the aliases,
+// int128, uint128 or a built-in integer.
+//
+// `count_min<C>` estimates how often each key was seen, never below the true
+// count, for heavy hitter detection. It has `depth` rows of `width` counters
+// of type C, which is u8, u16 or u32; narrow counters fit more of them in
+// cache and saturate at C::MAX instead of wrapping back to small counts.
+//
+//   add(key, n)               adds `n` to the key's counter in every row
+//   add_conservative(key, n)  only raises the counters that are below the new
+//                             estimate, which overestimates less
+//   estimate(key)             the smallest of the key's counters
+//   merge(other)              adds the counters of a sketch of the same shape and seed
+//
+// `hyperloglog` estimates the number of distinct keys, to about
+// 1.04 / sqrt(2^precision), with 2^precision registers of one byte each.
+//
+//   add(key), estimate(), merge(other)
+//
+// Both also take `count` keys at a time, hashing a block of keys and
+// prefetching their counters before updating them. Merging uses SSE2
+// saturating adds and byte max instructions where available.
+//
+// Example:
+//
+//   numbers::count_min<numbers::u16> hits(4096, 4);
+//   hits.add_conservative(numbers::u64(client_id));
+//   numbers::u16 seen = hits.estimate(numbers::u64(client_id));
+//
+//   numbers::hyperloglog clients;
+//   clients.add(numbers::u64(client_id));
+//   double distinct = clients.estimate();
+
+namespace sketch_internal {
+
+using numbers_internal::raw_type_t;
+
+template <typename K>
+constexpr bool is_key_v = numbers_internal::is_numbers_type_v<K> || numbers_internal::is_integer_v<K>;
+
+template <typename K>
+using enable_if_key_t = std::enable_if_t<is_key_v<K>>;
+
+constexpr size_t kBlock = 16;
+
+inline void prefetch(const void *p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p);
+#elif defined(NUMBERS_SKETCH_SSE2)
+  _mm_prefetch(static_cast<const char *>(p), _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+inline size_t log2_ceil(size_t n) noexcept {
+  size_t ret = 0;
+  while ((size_t{1} << ret) < n) {
+    ++ret;
+  }
+  return ret;
+}
+
+// dst[i] = saturating dst[i] + src[i]
+template <typename T>
+void saturating_add(T *dst, const T *src, size_t count) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_SKETCH_SSE2)
+  constexpr size_t kLanes = 16 / sizeof(T);
+  for (; i + kLanes <= count; i += kLanes) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    __m128i sum;
+    if constexpr (sizeof(T) == 1) {
+      sum = _mm_adds_epu8(a, b);
+    } else if constexpr (sizeof(T) == 2) {
+      sum = _mm_adds_epu16(a, b);
+    } else {
+      // a lane overflowed if the sum is below `a`; SSE2 only compares signed, so flip the sign bits first
+      const __m128i sign = _mm_set1_epi32(INT32_MIN);
+      sum = _mm_add_epi32(a, b);
+      sum = _mm_or_si128(sum, _mm_cmpgt_epi32(_mm_xor_si128(a, sign), _mm_xor_si128(sum, sign)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), sum);
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = static_cast<T>(Uinteger<T>(dst[i]).saturating_add(Uinteger<T>(src[i])));
+  }
+}
+
+// 2^-r for 0 <= r <= 64, built from its exponent bits.
+inline double inverse_power_of_two(uint8_t r) noexcept {
+  const uint64_t bits = static_cast<uint64_t>(1023 - r) << 52;
+  double ret;
+  std::memcpy(&ret, &bits, sizeof(ret));
+  return ret;
+}
+
+// dst[i] = max(dst[i], src[i])
+inline void max_bytes(uint8_t *dst, const uint8_t *src, size_t count) noexcept {
+  size_t i = 0;
+#if defined(NUMBERS_SKETCH_SSE2)
+  for (; i + 16 <= count; i += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_max_epu8(a, b));
+  }
+#endif
+  for (; i < count; ++i) {
+    dst[i] = src[i] > dst[i] ? src[i] : dst[i];
+  }
+}
+
+}  // namespace sketch_internal
+
+template <typename C>
+class count_min {
+  static_assert(std::is_same_v<C, u8> || std::is_same_v<C, u16> || std::is_same_v<C, u32>,
+                "count_min counters are u8, u16 or u32");
+
+  using raw_type = numbers_internal::raw_type_t<C>;
+
+ public:
+  // `width` is rounded up to a power of two. Throws std::runtime_error if `width` or `depth` is 0.
+  count_min(size_t width, size_t depth, uint64_t seed = 0) noexcept(false)
+      : shift_(64 - sketch_internal::log2_ceil(width)),
+        width_(size_t{1} << sketch_internal::log2_ceil(width)),
+        depth_(depth),
+        seed_(numbers_internal::hash_seed(seed)),
+        counters_(width_ * depth) {
+    if (width == 0 || depth == 0) {
+      throw std::runtime_error("count_min empty shape");
+    }
+  }
+
+  size_t width() const noexcept { return width_; }
+  size_t depth() const noexcept { return depth_; }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add(K key, C n = C(1)) noexcept {
+    const probe p = locate(key);
+    bump([&](size_t r) { return slot(p, r); }, n);
+  }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add_conservative(K key, C n = C(1)) noexcept {
+    const probe p = locate(key);
+    raise([&](size_t r) { return slot(p, r); }, n);
+  }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add(const K *keys, size_t count, C n = C(1)) {
+    each_block(keys, count, [&](const size_t *slots) { bump([&](size_t r) { return slots[r]; }, n); });
+  }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add_conservative(const K *keys, size_t count, C n = C(1)) {
+    each_block(keys, count, [&](const size_t *slots) { raise([&](size_t r) { return slots[r]; }, n); });
+  }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  C estimate(K key) const noexcept {
+    const probe p = locate(key);
+    return C(minimum([&](size_t r) { return slot(p, r); }));
+  }
+
+  // Throws std::runtime_error unless `other` has the same width, depth and seed.
+  void merge(const count_min &other) noexcept(false) {
+    if (other.width_ != width_ || other.depth_ != depth_ || other.seed_ != seed_) {
+      throw std::runtime_error("count_min shape mismatch");
+    }
+    sketch_internal::saturating_add(counters_.data(), other.counters_.data(), counters_.size());
+  }
+
+  void reset() noexcept { counters_.assign(counters_.size(), 0); }
+
+ private:
+  // The row r counter of a key is at (h1 + r * h2) >> shift_, h2 odd, which
+  // gives `depth` independent enough indices from two hashes.
+  struct probe {
+    uint64_t h1;
+    uint64_t h2;
+  };
+
+  template <typename K>
+  probe locate(K key) const noexcept {
+    const uint64_t h1 = hash_internal::hash_one(key, seed_);
+    return {h1, numbers_internal::hash_mix(h1, numbers_internal::kHashSecret0) | 1};
+  }
+
+  size_t slot(const probe &p, size_t r) const noexcept {
+    // a shift by 64 is undefined, and a width of 1 has only index 0
+    const uint64_t h = p.h1 + r * p.h2;
+    return r * width_ + (shift_ == 64 ? 0 : static_cast<size_t>(h >> shift_));
+  }
+
+  // `slot_of(r)` is the index of the key's counter in row r.
+  template <typename F>
+  void bump(F &&slot_of, C n) noexcept {
+    for (size_t r = 0; r < depth_; ++r) {
+      raw_type &c = counters_[slot_of(r)];
+      c = static_cast<raw_type>(C(c).saturating_add(n));
+    }
+  }
+
+  template <typename F>
+  raw_type minimum(F &&slot_of) const noexcept {
+    raw_type ret = counters_[slot_of(0)];
+    for (size_t r = 1; r < depth_; ++r) {
+      const raw_type c = counters_[slot_of(r)];
+      ret = c < ret ? c : ret;
+    }
+    return ret;
+  }
+
+  template <typename F>
+  void raise(F &&slot_of, C n) noexcept {
+    const raw_type target = static_cast<raw_type>(C(minimum(slot_of)).saturating_add(n));
+    for (size_t r = 0; r < depth_; ++r) {
+      raw_type &c = counters_[slot_of(r)];
+      c = c < target ? target : c;
+    }
+  }
+
+  // Computes and prefetches the counters of a block of keys, then calls `fn`
+  // with the `depth` counter indices of each key in turn.
+  template <typename K, typename F>
+  void each_block(const K *keys, size_t count, F &&fn) {
+    std::vector<size_t> slots(sketch_internal::kBlock * depth_);
+    for (size_t start = 0; start < count; start += sketch_internal::kBlock) {
+      const size_t n = count - start < sketch_internal::kBlock ? count - start : sketch_internal::kBlock;
+      for (size_t k = 0; k < n; ++k) {
+        const probe p = locate(keys[start + k]);
+        for (size_t r = 0; r < depth_; ++r) {
+          slots[k * depth_ + r] = slot(p, r);
+          sketch_internal::prefetch(&counters_[slots[k * depth_ + r]]);
+        }
+      }
+      for (size_t k = 0; k < n; ++k) {
+        fn(&slots[k * depth_]);
+      }
+    }
+  }
+
+  size_t shift_;
+  size_t width_;
+  size_t depth_;
+  uint64_t seed_;
+  std::vector<raw_type> counters_;
+};
+
+class hyperloglog {
+ public:
+  static constexpr int kMinPrecision = 4;
+  static constexpr int kMaxPrecision = 18;
+
+  // Throws std::runtime_error unless kMinPrecision <= precision <= kMaxPrecision.
+  explicit hyperloglog(int precision = 12, uint64_t seed = 0) noexcept(false)
+      : precision_(precision), seed_(numbers_internal::hash_seed(seed)) {
+    if (precision < kMinPrecision || precision > kMaxPrecision) {
+      throw std::runtime_error("hyperloglog precision out of range");
+    }
+    registers_.resize(size_t{1} << precision);
+  }
+
+  int precision() const noexcept { return precision_; }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add(K key) noexcept {
+    update(hash_internal::hash_one(key, seed_));
+  }
+
+  template <typename K, typename = sketch_internal::enable_if_key_t<K>>
+  void add(const K *keys, size_t count) noexcept {
+    uint64_t hashes[sketch_internal::kBlock];
+    for (size_t start = 0; start < count; start += sketch_internal::kBlock) {
+      const size_t n = count - start < sketch_internal::kBlock ? count - start : sketch_internal::kBlock;
+      for (size_t k = 0; k < n; ++k) {
+        hashes[k] = hash_internal::hash_one(keys[start + k], seed_);
+        sketch_internal::prefetch(&registers_[hashes[k] >> (64 - precision_)]);
+      }
+      for (size_t k = 0; k < n; ++k) {
+        update(hashes[k]);
+      }
+    }
+  }
+
+  // The raw HyperLogLog estimate, with linear counting for small cardinalities.
+  double estimate() const noexcept {
+    const double m = static_cast<double>(registers_.size());
+    double sum = 0;
+    size_t zeros = 0;
+    for (const uint8_t r : registers_) {
+      sum += sketch_internal::inverse_power_of_two(r);
+      zeros += r == 0;
+    }
+    const double alpha = 0.7213 / (1 + 1.079 / m);
+    const double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && zeros != 0) {
+      return m * std::log(m / static_cast<double>(zeros));
+    }
+    return raw;
+  }
+
+  // Throws std::runtime_error unless `other` has the same precision and seed.
+  void merge(const hyperloglog &other) noexcept(false) {
+    if (other.precision_ != precision_ || other.seed_ != seed_) {
+      throw std::runtime_error("hyperloglog shape mismatch");
+    }
+    sketch_internal::max_bytes(registers_.data(), other.registers_.data(), registers_.size());
+  }
+
+  void reset() noexcept { registers_.assign(registers_.size(), 0); }
+
+ private:
+  // The top `precision` bits pick the register, which keeps the longest run
+  // of leading zeros plus one seen in the remaining bits.
+  void update(uint64_t h) noexcept {
+    uint8_t &r = registers_[h >> (64 - precision_)];
+    const uint64_t rest = (h << precision_) | (uint64_t{1} << (precision_ - 1));
+    const uint8_t rank = static_cast<uint8_t>(countl_zero(rest) + 1);
+    r = rank > r ? rank : r;
+  }
+
+  int precision_;
+  uint64_t seed_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace numbers
+
+#endif
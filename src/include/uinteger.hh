@@ -1,12 +1,15 @@
 #ifndef NUMBERS_UNINTEGER_HH
 #define NUMBERS_UNINTEGER_HH
 
-#include <iostream>
 #include <limits>
 #include <optional>
 #include <type_traits>
 #include "int128.hh"
 #include "internal/config.h"
+#include "internal/floating.hh"
+#include "internal/hash.hh"
+#include "internal/mixed.hh"
+#include "overflow.hh"
 
 namespace numbers {
 
@@ -28,17 +31,19 @@ class Uinteger {
   constexpr Uinteger() noexcept : num_{} {}
 
   template <typename U, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
-  Uinteger(U num) noexcept : num_{static_cast<T>(num)} {}
+  constexpr Uinteger(U num) noexcept : num_{static_cast<T>(num)} {}
 
-  Uinteger(float num) noexcept : num_{static_cast<T>(num)} {}
-  Uinteger(double num) noexcept : num_{static_cast<T>(num)} {}
-  Uinteger(long double num) noexcept : num_{static_cast<T>(num)} {}
+  // Truncates toward zero; NaN becomes 0 and out of range values saturate.
+  Uinteger(float num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
+  Uinteger(double num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
+  Uinteger(long double num) noexcept : num_{numbers_internal::saturating_from_float<T>(num)} {}
 
   constexpr Uinteger operator+(const Uinteger<T> &other) const noexcept(false) {
+    const T sum = static_cast<T>(num_ + other.num_);
     if (add_overflow(num_, other.num_)) {
-      throw std::runtime_error("add overflow");
+      overflow_internal::report_add(sum, other.num_);
     }
-    return Uinteger(num_ + other.num_);
+    return Uinteger(sum);
   }
 
   constexpr Uinteger wrapping_add(const Uinteger<T> &other) const noexcept { return Uinteger(num_ + other.num_); }
@@ -62,10 +67,11 @@ class Uinteger {
   }
 
   constexpr Uinteger operator-(const Uinteger<T> &other) const noexcept(false) {
+    const T difference = static_cast<T>(num_ - other.num_);
     if (sub_overflow(num_, other.num_)) {
-      throw std::runtime_error("sub overflow");
+      overflow_internal::report_sub(difference, other.num_);
     }
-    return Uinteger(num_ - other.num_);
+    return Uinteger(difference);
   }
 
   constexpr Uinteger wrapping_sub(const Uinteger<T> &other) const noexcept { return Uinteger(num_ - other.num_); }
@@ -90,7 +96,7 @@ class Uinteger {
 
   constexpr Uinteger operator/(const Uinteger<T> &other) const noexcept(false) {
     if (div_overflow(num_, other.num_)) {
-      throw std::runtime_error("div overflow");
+      overflow_internal::report("div", num_, other.num_);
     }
     return Uinteger(num_ / other.num_);
   }
@@ -117,7 +123,7 @@ class Uinteger {
 
   constexpr Uinteger operator*(const Uinteger<T> &other) const noexcept(false) {
     if (mul_overflow(num_, other.num_)) {
-      throw std::runtime_error("mul overflow");
+      overflow_internal::report("mul", num_, other.num_);
     }
     return Uinteger(num_ * other.num_);
   }
@@ -148,7 +154,7 @@ class Uinteger {
     if (num_ == min_) {
       return Uinteger(num_);
     }
-    throw std::runtime_error("neg overflow");
+    overflow_internal::report_unary("neg", num_);
   }
 
   constexpr std::optional<Uinteger> checked_neg() const noexcept {
@@ -270,17 +276,12 @@ class Uinteger {
   }
 
   template <typename U, typename = std::enable_if<std::is_convertible_v<U, T>>>
-  explicit operator U() const noexcept {
+  constexpr explicit operator U() const noexcept {
     return static_cast<U>(num_);
   }
 
-  friend std::ostream &operator<<(std::ostream &os, const Uinteger<T> &num) {
-    os << num.num_;
-    return os;
-  }
-
  private:
-  constexpr bool add_overflow(T a, T b) const noexcept { return b > max_ - a; }
+  constexpr bool add_overflow(T a, T b) const noexcept { return static_cast<T>(a + b) < a; }
 
   constexpr bool sub_overflow(T minuend, T subtrahend) const noexcept { return minuend < subtrahend; }
 
@@ -317,7 +318,12 @@ constexpr Uinteger<T> &operator+=(Uinteger<T> lhs, Uinteger<T> rhs) noexcept(fal
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr Uinteger<T> operator+(U lhs, Uinteger<T> rhs) noexcept(false) {
-  return Uinteger<T>(lhs) + rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Uinteger<T>(numbers_internal::value_or_report(numbers_internal::mixed_add<T>(lhs, static_cast<T>(rhs)),
+                                                         "add", lhs, static_cast<T>(rhs)));
+  } else {
+    return Uinteger<T>(lhs) + rhs;
+  }
 }
 
 template <typename T>
@@ -328,7 +334,12 @@ constexpr Uinteger<T> &operator-=(Uinteger<T> lhs, Uinteger<T> rhs) noexcept(fal
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr Uinteger<T> operator-(U lhs, Uinteger<T> rhs) noexcept(false) {
-  return Uinteger<T>(lhs) - rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Uinteger<T>(numbers_internal::value_or_report(numbers_internal::mixed_sub<T>(lhs, static_cast<T>(rhs)),
+                                                         "sub", lhs, static_cast<T>(rhs)));
+  } else {
+    return Uinteger<T>(lhs) - rhs;
+  }
 }
 
 template <typename T>
@@ -339,7 +350,12 @@ constexpr Uinteger<T> &operator/=(Uinteger<T> lhs, Uinteger<T> rhs) noexcept(fal
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr Uinteger<T> operator/(U lhs, Uinteger<T> rhs) noexcept(false) {
-  return Uinteger<T>(lhs) / rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Uinteger<T>(numbers_internal::value_or_report(numbers_internal::mixed_div<T>(lhs, static_cast<T>(rhs)),
+                                                         "div", lhs, static_cast<T>(rhs)));
+  } else {
+    return Uinteger<T>(lhs) / rhs;
+  }
 }
 
 template <typename T>
@@ -350,7 +366,12 @@ constexpr Uinteger<T> &operator%=(Uinteger<T> lhs, Uinteger<T> rhs) noexcept(fal
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr Uinteger<T> operator%(U lhs, Uinteger<T> rhs) noexcept(false) {
-  return Uinteger<T>(lhs) % rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Uinteger<T>(numbers_internal::value_or_report(numbers_internal::mixed_rem<T>(lhs, static_cast<T>(rhs)),
+                                                         "rem", lhs, static_cast<T>(rhs)));
+  } else {
+    return Uinteger<T>(lhs) % rhs;
+  }
 }
 
 template <typename T>
@@ -361,7 +382,12 @@ constexpr Uinteger<T> &operator*=(Uinteger<T> lhs, Uinteger<T> rhs) noexcept(fal
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr Uinteger<T> operator*(U lhs, Uinteger<T> rhs) noexcept(false) {
-  return Uinteger<T>(lhs) / rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return Uinteger<T>(numbers_internal::value_or_report(numbers_internal::mixed_mul<T>(lhs, static_cast<T>(rhs)),
+                                                         "mul", lhs, static_cast<T>(rhs)));
+  } else {
+    return Uinteger<T>(lhs) * rhs;
+  }
 }
 
 template <typename T>
@@ -376,27 +402,47 @@ constexpr bool operator!=(Uinteger<T> lhs, Uinteger<T> rhs) {
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr bool operator==(U lhs, Uinteger<T> rhs) noexcept {
-  return Uinteger<T>(lhs) == rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_equal(lhs, static_cast<T>(rhs));
+  } else {
+    return Uinteger<T>(lhs) == rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr bool operator>(U lhs, Uinteger<T> rhs) noexcept {
-  return Uinteger<T>(lhs) > rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_less(static_cast<T>(rhs), lhs);
+  } else {
+    return Uinteger<T>(lhs) > rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr bool operator>=(U lhs, Uinteger<T> rhs) noexcept {
-  return Uinteger<T>(lhs) >= rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return !numbers_internal::cmp_less(lhs, static_cast<T>(rhs));
+  } else {
+    return Uinteger<T>(lhs) >= rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr bool operator<(U lhs, Uinteger<T> rhs) noexcept {
-  return Uinteger<T>(lhs) < rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return numbers_internal::cmp_less(lhs, static_cast<T>(rhs));
+  } else {
+    return Uinteger<T>(lhs) < rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_convertible_v<U, T>>>
 constexpr bool operator<=(U lhs, Uinteger<T> rhs) noexcept {
-  return Uinteger<T>(lhs) <= rhs;
+  if constexpr (numbers_internal::is_integer_v<U>) {
+    return !numbers_internal::cmp_less(static_cast<T>(rhs), lhs);
+  } else {
+    return Uinteger<T>(lhs) <= rhs;
+  }
 }
 
 template <typename U, typename T, typename = std::enable_if_t<std::is_signed_v<U> && std::is_convertible_v<U, T>>>
@@ -425,25 +471,36 @@ using u128 = Uinteger<uint128>;
 namespace std {
 template <>
 struct hash<numbers::u8> {
-  size_t operator()(const numbers::u8 &obj) const { return std::hash<uint8_t>()(static_cast<uint8_t>(obj)); }
+  size_t operator()(const numbers::u8 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<uint8_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::u16> {
-  size_t operator()(const numbers::u16 &obj) const { return std::hash<uint16_t>()(static_cast<uint16_t>(obj)); }
+  size_t operator()(const numbers::u16 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<uint16_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::u32> {
-  size_t operator()(const numbers::u32 &obj) const { return std::hash<uint32_t>()(static_cast<uint32_t>(obj)); }
+  size_t operator()(const numbers::u32 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<uint32_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
 template <>
 struct hash<numbers::u64> {
-  size_t operator()(const numbers::u64 &obj) const { return std::hash<uint64_t>()(static_cast<uint64_t>(obj)); }
+  size_t operator()(const numbers::u64 &obj) const {
+    return static_cast<size_t>(
+        numbers_internal::hash_integral(static_cast<uint64_t>(obj), numbers_internal::kHashDefaultSeed));
+  }
 };
 
-// TODO hash collision
 template <>
 struct hash<numbers::u128> {
   size_t operator()(const numbers::u128 &obj) const {
@@ -453,4 +510,8 @@ struct hash<numbers::u128> {
 
 }  // namespace std
 
-#endif
\ No newline at end of file
+#ifdef NUMBERS_HEADER_ONLY
+#include "internal/uinteger_impl.hh"
+#endif
+
+#endif
@@ -0,0 +1,3 @@
+#include "cast.hh"
+
+#include "internal/cast_impl.hh"
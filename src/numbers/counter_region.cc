@@ -0,0 +1,3 @@
+#include "counter_region.hh"
+
+#include "internal/counter_region_impl.hh"
@@ -0,0 +1,3 @@
+#include "fixed.hh"
+
+#include "internal/fixed_impl.hh"
@@ -0,0 +1,3 @@
+#include "floating.hh"
+
+#include "internal/floating_impl.hh"
@@ -0,0 +1,3 @@
+#include "histogram.hh"
+
+#include "internal/histogram_impl.hh"
@@ -0,0 +1,3 @@
+#include "io.hh"
+
+#include "internal/io_impl.hh"
@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "atomic.hh"
+
+using namespace numbers;
+
+TEST(atomicTest, FetchOperations) {
+  atomic<i64> a(i64::MAX - i64(1));
+  EXPECT_EQ(a.fetch_checked_add(i64(2)), std::nullopt);
+  EXPECT_EQ(a.fetch_add(i64(1)), i64::MAX - i64(1));
+  EXPECT_EQ(a.fetch_saturating_add(i64(100)), i64::MAX);
+  EXPECT_EQ(a.load(), i64::MAX);
+  EXPECT_EQ(a.fetch_overflowing_add(i64(1)), std::make_tuple(i64::MAX, true));
+  EXPECT_EQ(a.load(), i64::MIN);
+  EXPECT_EQ(a.fetch_saturating_sub(i64(1)), i64::MIN);
+  EXPECT_EQ(a.load(), i64::MIN);
+  EXPECT_EQ(a.fetch_checked_sub(i64(-5)), i64::MIN);
+  EXPECT_EQ(a.load(), i64::MIN + i64(5));
+  EXPECT_EQ(a.fetch_wrapping_sub(i64(6)), i64::MIN + i64(5));
+  EXPECT_EQ(a.load(), i64::MAX);
+
+  atomic<i8> b(i8(-100));
+  EXPECT_EQ(b.fetch_saturating_add(i8(-100)), i8(-100));
+  EXPECT_EQ(b.load(), i8::MIN);
+  EXPECT_THROW(b.fetch_sub(i8(1)), std::runtime_error);
+  EXPECT_EQ(b.fetch_overflowing_sub(i8(-1)), std::make_tuple(i8::MIN, false));
+}
+
+TEST(atomicTest, Threads) {
+  constexpr int kThreads = 4;
+  constexpr int kAdds = 20000;
+  atomic<i32> balance;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kAdds; ++i) {
+        if (t % 2) {
+          balance.fetch_saturating_sub(i32(7));
+        } else {
+          balance.fetch_add(i32(7));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(balance.load(), i32(0));
+}
+
+TEST(atomicTest, Wide) {
+  atomic<i128> a(i128::MIN + i128(1));
+  EXPECT_EQ(a.fetch_checked_sub(i128(2)), std::nullopt);
+  EXPECT_EQ(a.fetch_saturating_sub(i128(2)), i128::MIN + i128(1));
+  EXPECT_EQ(a.load(), i128::MIN);
+  EXPECT_EQ(a.fetch_wrapping_sub(i128(1)), i128::MIN);
+  EXPECT_EQ(a.load(), i128::MAX);
+  EXPECT_THROW(a.fetch_add(i128(1)), std::runtime_error);
+  a.store(i128(-1));
+  EXPECT_EQ(a.fetch_add(i128(1)), i128(-1));
+  EXPECT_EQ(a.load(), i128(0));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 10000; ++i) {
+        a.fetch_wrapping_add(t % 2 ? i128(make_int128(-3, 0)) : i128(make_int128(3, 0)));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(a.load(), i128(0));
+}
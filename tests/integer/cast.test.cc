@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "cast.hh"
+
+using namespace numbers;
+
+TEST(castTest, Narrowing) {
+  EXPECT_EQ(checked_cast<i32>(i64(1) << 40), std::nullopt);
+  EXPECT_EQ(checked_cast<i32>(i64(-5)), i32(-5));
+  EXPECT_EQ(checked_cast<i32>(i64(i32::MIN)), i32::MIN);
+  EXPECT_EQ(checked_cast<i32>(i64(static_cast<int64_t>(i32::MIN) - 1)), std::nullopt);
+  EXPECT_EQ(saturating_cast<i16>(i64(1) << 40), i16::MAX);
+  EXPECT_EQ(saturating_cast<i16>(i64::MIN), i16::MIN);
+  EXPECT_EQ(wrapping_cast<i8>(i32(300)), i8(44));
+  auto [ret, overflow] = overflowing_cast<i8>(i32(-129));
+  EXPECT_EQ(ret, i8(127));
+  EXPECT_TRUE(overflow);
+  EXPECT_THROW(try_from<i8>(i16(128)), std::runtime_error);
+  EXPECT_EQ(try_from<i8>(i16(-128)), i8::MIN);
+}
+
+TEST(castTest, Signedness) {
+  EXPECT_EQ(checked_cast<u16>(i32(-1)), std::nullopt);
+  EXPECT_EQ(checked_cast<u16>(i32(65535)), u16::MAX);
+  EXPECT_EQ(saturating_cast<u16>(i32(-1)), u16(0));
+  EXPECT_EQ(saturating_cast<u16>(i32::MAX), u16::MAX);
+  EXPECT_EQ(checked_cast<i64>(u64::MAX), std::nullopt);
+  EXPECT_EQ(saturating_cast<i64>(u64::MAX), i64::MAX);
+  EXPECT_EQ(checked_cast<u64>(i8(-1)), std::nullopt);
+  EXPECT_EQ(wrapping_cast<u64>(i8(-1)), u64::MAX);
+  EXPECT_EQ(checked_cast<i16>(u8::MAX), i16(255));
+}
+
+TEST(castTest, Wide) {
+  EXPECT_EQ(checked_cast<i64>(i128::MAX), std::nullopt);
+  EXPECT_EQ(checked_cast<i64>(i128(-7)), i64(-7));
+  EXPECT_EQ(saturating_cast<i64>(i128::MIN), i64::MIN);
+  EXPECT_EQ(checked_cast<u128>(i128(-1)), std::nullopt);
+  EXPECT_EQ(checked_cast<i128>(u128::MAX), std::nullopt);
+  EXPECT_EQ(saturating_cast<i128>(u128::MAX), i128::MAX);
+  EXPECT_EQ(checked_cast<u8>(u128(255)), u8::MAX);
+  EXPECT_EQ(checked_cast<i8>(uint128(128)), std::nullopt);
+  EXPECT_EQ(checked_cast<int128>(i64::MIN), int128(INT64_MIN));
+  EXPECT_EQ(checked_cast<int32_t>(i64(7)), 7);
+  EXPECT_EQ(saturating_cast<uint8_t>(-3), 0);
+  // widening never fails
+  EXPECT_EQ(try_from<i128>(i64::MIN), i128(INT64_MIN));
+  EXPECT_EQ(try_from<u128>(u64::MAX), u128(UINT64_MAX));
+}
+
+TEST(castTest, Batch) {
+  std::vector<i32> src;
+  for (int32_t v = -70000; v <= 70000; v += 997) {
+    src.emplace_back(v);
+  }
+  src.emplace_back(i32::MIN);
+  src.emplace_back(i32::MAX);
+
+  std::vector<i16> narrow(src.size());
+  EXPECT_FALSE(checked_cast(src.data(), src.size(), narrow.data()));
+  std::vector<u16> unsigned_narrow(src.size());
+  saturating_cast(src.data(), src.size(), unsigned_narrow.data());
+  for (size_t i = 0; i < src.size(); ++i) {
+    EXPECT_EQ(narrow[i], saturating_cast<i16>(src[i]));
+    EXPECT_EQ(unsigned_narrow[i], saturating_cast<u16>(src[i]));
+  }
+
+  std::vector<i32> small(37, i32(-32768));
+  small[20] = i32(32767);
+  EXPECT_TRUE(checked_cast(small.data(), small.size(), narrow.data()));
+  EXPECT_EQ(narrow[20], i16::MAX);
+
+  std::vector<i16> bytes;
+  for (int16_t v = -300; v <= 300; v += 7) {
+    bytes.emplace_back(v);
+  }
+  std::vector<i8> signed_bytes(bytes.size());
+  std::vector<u8> unsigned_bytes(bytes.size());
+  EXPECT_FALSE(checked_cast(bytes.data(), bytes.size(), signed_bytes.data()));
+  EXPECT_FALSE(checked_cast(bytes.data(), bytes.size(), unsigned_bytes.data()));
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    EXPECT_EQ(signed_bytes[i], saturating_cast<i8>(bytes[i]));
+    EXPECT_EQ(unsigned_bytes[i], saturating_cast<u8>(bytes[i]));
+  }
+
+  std::vector<i64> wide = {i64(1) << 40, i64(-1), i64(7)};
+  std::vector<u32> ret(wide.size());
+  EXPECT_FALSE(checked_cast(wide.data(), wide.size(), ret.data()));
+  EXPECT_EQ(ret[0], u32::MAX);
+  EXPECT_EQ(ret[1], u32(0));
+  EXPECT_EQ(ret[2], u32(7));
+  wrapping_cast(wide.data(), wide.size(), ret.data());
+  EXPECT_EQ(ret[1], u32::MAX);
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+#include "ct.hh"
+
+using namespace numbers;
+
+// Evaluated by the compiler; an overflowing argument would not compile.
+static_assert(ct::add(i8(100), i8(27)) == i8(127));
+static_assert(ct::add(i8(-100), i8(-28)) == i8(-128));
+static_assert(ct::sub(i32(-2147483647), i32(1)) == i32(-2147483647 - 1));
+static_assert(ct::sub(u16(1), u16(1)) == u16(0));
+static_assert(ct::mul(i64(-3037000499), i64(3037000499)) == i64(-9223372030926249001));
+static_assert(ct::mul(u32(65535), u32(65537)) == u32(0xFFFFFFFF));
+static_assert(ct::mul(u128(uint128_max()), u128(1)) == u128(uint128_max()));
+static_assert(ct::shl(u64(1), 63) == u64(0x8000000000000000));
+static_assert(ct::shl(i8(-1), 7) == i8(-128));
+static_assert(ct::shl(i16(3), 0) == i16(3));
+static_assert(ct::shl(i128(-1), 127) == i128(int128_min()));
+
+constexpr u32 kFieldCount = 12;
+constexpr u32 kHeaderSize = ct::add(ct::mul(kFieldCount, u32(4)), u32(8));
+static_assert(kHeaderSize == u32(56));
+
+TEST(ctIntegerTest, RuntimeOverflowThrows) {
+  i8 a = 100;
+  u32 b = 1;
+  EXPECT_EQ(ct::add(a, i8(27)), i8::MAX);
+  EXPECT_THROW(ct::add(a, a), std::runtime_error);
+  EXPECT_THROW(ct::sub(i8::MIN, i8(1)), std::runtime_error);
+  EXPECT_THROW(ct::sub(u32(0), b), std::runtime_error);
+  EXPECT_THROW(ct::mul(i64::MIN, i64(-1)), std::runtime_error);
+  EXPECT_THROW(ct::mul(u128::MAX, u128(2)), std::runtime_error);
+  EXPECT_THROW(ct::shl(b, 32), std::runtime_error);
+  EXPECT_THROW(ct::shl(b, -1), std::runtime_error);
+  EXPECT_THROW(ct::shl(u32(0x80000000), 1), std::runtime_error);
+  EXPECT_THROW(ct::shl(i8(64), 1), std::runtime_error);
+  EXPECT_THROW(ct::shl(i8(-65), 1), std::runtime_error);
+  EXPECT_EQ(ct::shl(i8(-64), 1), i8::MIN);
+  EXPECT_EQ(ct::shl(b, 31), u32(0x80000000));
+}
@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "decimal.hh"
+#include "random.hh"
+
+using namespace numbers;
+
+namespace {
+
+using money = decimal64<4>;
+
+money parse(const char *text) { return *money::parse(text); }
+
+}  // namespace
+
+TEST(decimalIntegerTest, ParseAndFormat) {
+  EXPECT_EQ(parse("12.34").units(), i64(123400));
+  EXPECT_EQ(parse("-0.0001").units(), i64(-1));
+  EXPECT_EQ(parse("+7").units(), i64(70000));
+  EXPECT_EQ(parse(".5").units(), i64(5000));
+  EXPECT_EQ(parse("3.").units(), i64(30000));
+  EXPECT_EQ(parse("0001.10").units(), i64(11000));
+  EXPECT_EQ(money::parse(""), std::nullopt);
+  EXPECT_EQ(money::parse("-"), std::nullopt);
+  EXPECT_EQ(money::parse("."), std::nullopt);
+  EXPECT_EQ(money::parse("1.2.3"), std::nullopt);
+  EXPECT_EQ(money::parse("1e3"), std::nullopt);
+  EXPECT_EQ(money::parse(" 1"), std::nullopt);
+  EXPECT_EQ(money::parse("922337203685477.5807"), money::MAX);
+  EXPECT_EQ(money::parse("-922337203685477.5808"), money::MIN);
+  EXPECT_EQ(money::parse("922337203685477.5808"), std::nullopt);
+  EXPECT_EQ(money::parse("100000000000000000000000000000000000000000"), std::nullopt);
+
+  // extra digits are rounded
+  EXPECT_EQ(parse("0.00005").units(), i64(0));
+  EXPECT_EQ(parse("0.00015").units(), i64(2));
+  EXPECT_EQ(parse("0.000050001").units(), i64(1));
+  EXPECT_EQ(parse("-0.00016").units(), i64(-2));
+  EXPECT_EQ(money::parse("0.00005", rounding::half_up)->units(), i64(1));
+
+  EXPECT_EQ(parse("12.34").to_string(), "12.3400");
+  EXPECT_EQ(parse("-0.0001").to_string(), "-0.0001");
+  EXPECT_EQ(money().to_string(), "0.0000");
+  EXPECT_EQ(money::MIN.to_string(), "-922337203685477.5808");
+  EXPECT_EQ(money::MAX.to_string(), "922337203685477.5807");
+  EXPECT_EQ((decimal64<0>::from_units(i64(-42)).to_string()), "-42");
+  EXPECT_EQ(decimal128<38>::MIN.to_string(), "-1.70141183460469231731687303715884105728");
+  EXPECT_EQ(decimal128<38>::from_units(i128(5)).to_string(), "0.00000000000000000000000000000000000005");
+  EXPECT_EQ(decimal128<2>::MAX.to_string(), "1701411834604692317316873037158841057.27");
+
+  char buf[8];
+  EXPECT_EQ(parse("-12.5").to_chars(buf, buf + 8), buf + 8);
+  EXPECT_EQ(std::string(buf, 8), "-12.5000");
+  EXPECT_EQ(parse("-123.5").to_chars(buf, buf + 8), nullptr);
+}
+
+TEST(decimalIntegerTest, AddSub) {
+  EXPECT_EQ(parse("1.5") + parse("2.25"), parse("3.75"));
+  EXPECT_EQ(parse("1.5") - parse("2.25"), parse("-0.75"));
+  EXPECT_EQ(-parse("1.5"), parse("-1.5"));
+  EXPECT_THROW(money::MAX + parse("0.0001"), std::runtime_error);
+  EXPECT_THROW(money::MIN - parse("0.0001"), std::runtime_error);
+  EXPECT_EQ(money::MAX.checked_add(parse("0.0001")), std::nullopt);
+  EXPECT_EQ(money::MAX.saturating_add(parse("1")), money::MAX);
+  EXPECT_EQ(money::MIN.saturating_sub(parse("1")), money::MIN);
+  EXPECT_EQ(money::MAX.overflowing_add(parse("0.0001")), std::make_tuple(money::MIN, true));
+  EXPECT_EQ(parse("1").checked_sub(parse("2")), parse("-1"));
+}
+
+TEST(decimalIntegerTest, Mul) {
+  EXPECT_EQ(parse("1.5") * parse("2.25"), parse("3.375"));
+  EXPECT_EQ(parse("-1.5") * parse("2.25"), parse("-3.375"));
+  // 0.0005 * 0.1 = 0.00005, a tie
+  EXPECT_EQ(parse("0.0005") * parse("0.1"), parse("0"));
+  EXPECT_EQ(parse("0.0015") * parse("0.1"), parse("0.0002"));
+  EXPECT_EQ(parse("-0.0015") * parse("0.1"), parse("-0.0002"));
+  EXPECT_EQ(parse("0.0005").mul(parse("0.1"), rounding::half_up), parse("0.0001"));
+  EXPECT_EQ(parse("-0.0005").mul(parse("0.1"), rounding::half_up), parse("-0.0001"));
+  EXPECT_EQ(parse("0.0005") * parse("0.11"), parse("0.0001"));
+
+  const money big = parse("1000000000");
+  EXPECT_THROW(big * big, std::runtime_error);
+  EXPECT_EQ(big.checked_mul(big), std::nullopt);
+  EXPECT_EQ(big.saturating_mul(big), money::MAX);
+  EXPECT_EQ(big.saturating_mul(-big), money::MIN);
+  EXPECT_TRUE(std::get<1>(big.overflowing_mul(big)));
+  EXPECT_EQ(money::MIN * parse("1"), money::MIN);
+  EXPECT_EQ(money::MIN.checked_mul(parse("-1")), std::nullopt);
+
+  // the 256-bit product of two i128 values
+  using wide = decimal128<30>;
+  const wide a = *wide::parse("12345678.123456789012345678901234567891");
+  const wide b = *wide::parse("-2.5");
+  EXPECT_EQ((a * b).to_string(), "-30864195.308641972530864197253086419728");
+  EXPECT_EQ((a * b).mul(*wide::parse("0.000000000000000000000000000001"), rounding::half_up).to_string(),
+            "-0.000000000000000000000030864195");
+}
+
+TEST(decimalIntegerTest, Div) {
+  EXPECT_EQ(parse("1") / parse("3"), parse("0.3333"));
+  EXPECT_EQ(parse("2") / parse("3"), parse("0.6667"));
+  EXPECT_EQ(parse("-2") / parse("3"), parse("-0.6667"));
+  EXPECT_EQ(parse("0.0001") / parse("2"), parse("0"));
+  EXPECT_EQ(parse("0.0003") / parse("2"), parse("0.0002"));
+  EXPECT_EQ(parse("0.0001").div(parse("2"), rounding::half_up), parse("0.0001"));
+  EXPECT_EQ(parse("7.5") / parse("-0.25"), parse("-30"));
+
+  EXPECT_THROW(parse("1") / money(), std::runtime_error);
+  EXPECT_EQ(parse("1").checked_div(money()), std::nullopt);
+  EXPECT_EQ(parse("1").saturating_div(money()), money::MAX);
+  EXPECT_EQ(parse("-1").saturating_div(money()), money::MIN);
+  EXPECT_EQ(money().saturating_div(money()), money());
+  EXPECT_EQ(parse("1").overflowing_div(money()), std::make_tuple(money(), true));
+  EXPECT_THROW(money::MAX / parse("0.5"), std::runtime_error);
+  EXPECT_EQ(money::MAX.saturating_div(parse("-0.5")), money::MIN);
+
+  using wide = decimal128<20>;
+  const wide a = *wide::parse("1000000000000000");
+  // a 256-bit dividend, divided by a 64-bit and by a 128-bit divisor
+  EXPECT_EQ((a / *wide::parse("0.07")).to_string(), "14285714285714285.71428571428571428571");
+  EXPECT_EQ((a / *wide::parse("3")).to_string(), "333333333333333.33333333333333333333");
+  EXPECT_EQ((-a / *wide::parse("6")).to_string(), "-166666666666666.66666666666666666667");
+}
+
+TEST(decimalIntegerTest, Rescale) {
+  const money m = parse("-2.5051");
+  EXPECT_EQ((m.rescale<2>().to_string()), "-2.51");
+  EXPECT_EQ((m.rescale<3>().to_string()), "-2.505");
+  EXPECT_EQ((parse("2.5").rescale<0>().to_string()), "2");
+  EXPECT_EQ((parse("3.5").rescale<0>().to_string()), "4");
+  EXPECT_EQ((parse("2.5").rescale<0>(rounding::half_up).to_string()), "3");
+  EXPECT_EQ((m.rescale<8>().to_string()), "-2.50510000");
+  EXPECT_EQ(money::MAX.checked_rescale<6>(), std::nullopt);
+  EXPECT_THROW(money::MAX.rescale<6>(), std::runtime_error);
+
+  EXPECT_EQ(money::from_integer(i64(-3)), parse("-3"));
+  EXPECT_EQ(money::checked_from_integer(i64::MAX), std::nullopt);
+  EXPECT_EQ(parse("-7.9").integer_part(), i64(-7));
+  EXPECT_DOUBLE_EQ(parse("-7.25").to_double(), -7.25);
+  EXPECT_LT(parse("-7.25"), parse("7"));
+}
+
+#ifdef __SIZEOF_INT128__
+TEST(decimalIntegerTest, MatchesNaiveInt128) {
+  xoshiro256ss engine(7);
+  // rounds n / d to nearest, ties to even
+  const auto round_div = [](__int128 n, __int128 d) {
+    __int128 q = n / d;
+    const __int128 r = n % d;
+    const __int128 twice = (r < 0 ? -r : r) * 2;
+    const __int128 ad = d < 0 ? -d : d;
+    if (twice > ad || (twice == ad && (q & 1))) {
+      q += (n < 0) != (d < 0) ? -1 : 1;
+    }
+    return q;
+  };
+  for (int i = 0; i < 20000; ++i) {
+    const int64_t a = static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 0, 62);
+    const int64_t b = static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 0, 62);
+    const money x = money::from_units(i64(a));
+    const money y = money::from_units(i64(b));
+
+    const __int128 product = round_div(static_cast<__int128>(a) * b, 10000);
+    const std::optional<money> mul = x.checked_mul(y);
+    if (product >= INT64_MIN && product <= INT64_MAX) {
+      ASSERT_TRUE(mul.has_value()) << a << " * " << b;
+      EXPECT_EQ(static_cast<int64_t>(mul->units()), static_cast<int64_t>(product)) << a << " * " << b;
+    } else {
+      EXPECT_EQ(mul, std::nullopt) << a << " * " << b;
+    }
+
+    if (b != 0) {
+      const __int128 quotient = round_div(static_cast<__int128>(a) * 10000, b);
+      const std::optional<money> div = x.checked_div(y);
+      if (quotient >= INT64_MIN && quotient <= INT64_MAX) {
+        ASSERT_TRUE(div.has_value()) << a << " / " << b;
+        EXPECT_EQ(static_cast<int64_t>(div->units()), static_cast<int64_t>(quotient)) << a << " / " << b;
+      } else {
+        EXPECT_EQ(div, std::nullopt) << a << " / " << b;
+      }
+    }
+
+    char buf[money::kMaxChars];
+    const char *end = x.to_chars(buf, buf + sizeof(buf));
+    EXPECT_EQ(money::parse(std::string_view(buf, end - buf)), x);
+  }
+
+  // wide divisors take the two-word division
+  using wide = decimal128<0>;
+  for (int i = 0; i < 20000; ++i) {
+    const auto random = [&] {
+      const unsigned __int128 bits =
+          (static_cast<unsigned __int128>(uniform<uint64_t>(engine)) << 64) | uniform<uint64_t>(engine);
+      return static_cast<__int128>(bits) >> uniform(engine, 1, 126);
+    };
+    const __int128 a = random();
+    const __int128 b = random();
+    if (b == 0) {
+      continue;
+    }
+    const std::optional<wide> div = wide::from_units(i128(a)).checked_div(wide::from_units(i128(b)));
+    ASSERT_TRUE(div.has_value());
+    EXPECT_TRUE(static_cast<__int128>(div->units()) == round_div(a, b));
+  }
+}
+#endif
@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdint>
+
+#include "duration.hh"
+#include "random.hh"
+
+using namespace numbers;
+using namespace std::chrono_literals;
+
+TEST(durationIntegerTest, Units) {
+  EXPECT_EQ(duration_ns::seconds(i64(2)).count(), i64(2'000'000'000));
+  EXPECT_EQ(duration_ns::hours(i64(-1)).count(), i64(-3'600'000'000'000));
+  EXPECT_EQ(duration_ns::microseconds(i64(INT64_MAX)), duration_ns::MAX);
+  EXPECT_EQ(duration_ns::milliseconds(i64(INT64_MIN)), duration_ns::MIN);
+  EXPECT_EQ(duration_ns(i64(1'999'999)).count_as<std::milli>(), i64(1));
+  EXPECT_EQ(duration_ns(i64(-1'999'999)).count_as<std::milli>(), i64(-1));
+  EXPECT_EQ(duration_ns::MIN.count_as<std::ratio<60>>(), i64(INT64_MIN / 60'000'000'000));
+  EXPECT_EQ(duration_ns(i64(5)).count_as<std::pico>(), i64(5000));
+  EXPECT_EQ(duration_ns::MAX.count_as<std::pico>(), i64::MAX);
+  EXPECT_EQ(duration_ns::nanoseconds(i64(7)), duration_ns(i64(7)));
+
+  EXPECT_EQ(duration_ps::seconds(i128(1)).count(), i128(1'000'000'000'000));
+  EXPECT_EQ(duration_ps::hours(i128(INT64_MAX)).count_as<std::ratio<3600>>(), i128(INT64_MAX));
+  EXPECT_EQ(duration_ps(i128::MAX).count_as<std::nano>(), i128::MAX / i128(1000));
+  EXPECT_EQ(duration_ps(i128::MIN).count_as<std::ratio<1>>(), i128::MIN / i128(1'000'000'000'000));
+}
+
+TEST(durationIntegerTest, Saturates) {
+  const duration_ns timeout = duration_ns::MAX;
+  const timestamp_ns now = timestamp_ns::from_epoch(duration_ns::seconds(i64(1000)));
+  EXPECT_EQ(now + timeout, timestamp_ns::MAX);
+  EXPECT_EQ(timeout + now, timestamp_ns::MAX);
+  EXPECT_EQ(now.checked_add(timeout), std::nullopt);
+  EXPECT_EQ(now - duration_ns::MAX, timestamp_ns::from_epoch(duration_ns(i64(1'000'000'000'000 - INT64_MAX))));
+  EXPECT_EQ(timestamp_ns::MIN - now, duration_ns::MIN);
+  EXPECT_EQ(timestamp_ns::MIN.checked_sub(now), std::nullopt);
+  EXPECT_EQ(timestamp_ns::MAX - timestamp_ns::MIN, duration_ns::MAX);
+  EXPECT_EQ((now + 5s) - now, duration_ns::seconds(i64(5)));
+  EXPECT_EQ(*now.checked_sub(duration_ns::seconds(i64(1000))), timestamp_ns());
+
+  timestamp_ns deadline = now;
+  deadline += timeout;
+  deadline -= 1s;
+  EXPECT_EQ(deadline, timestamp_ns::MAX - 1s);
+
+  EXPECT_EQ(-duration_ns::MIN, duration_ns::MAX);
+  EXPECT_EQ(duration_ns::MAX * i64(2), duration_ns::MAX);
+  EXPECT_EQ(i64(-2) * duration_ns::MAX, duration_ns::MIN);
+  EXPECT_EQ(duration_ns::MAX.checked_mul(i64(2)), std::nullopt);
+  EXPECT_EQ(duration_ns::MIN / i64(-1), duration_ns::MAX);
+  EXPECT_EQ(duration_ns::MIN.checked_div(i64(-1)), std::nullopt);
+  EXPECT_EQ(duration_ns::seconds(i64(7)) / i64(2), 3500ms);
+  EXPECT_EQ(duration_ns::seconds(i64(7)) / duration_ns::seconds(i64(2)), i64(3));
+  EXPECT_THROW(duration_ns::MAX / i64(0), overflow_error);
+  EXPECT_THROW(duration_ns::seconds(i64(1)) / duration_ns(), overflow_error);
+  try {
+    static_cast<void>(duration_ns::MAX / i64(0));
+  } catch (const overflow_error &err) {
+    EXPECT_STREQ(err.what(), "div overflow: 9223372036854775807 / 0");
+  }
+  EXPECT_EQ(duration_ns::MAX.checked_div(i64(0)), std::nullopt);
+
+  EXPECT_EQ(duration_ps::MAX + duration_ps::seconds(i128(1)), duration_ps::MAX);
+  EXPECT_EQ(duration_ps::MIN / i128(-1), duration_ps::MAX);
+  EXPECT_EQ(duration_ps::seconds(i128(-7)) / i128(2), duration_ps::milliseconds(i128(-3500)));
+  EXPECT_EQ(duration_ps::MAX / duration_ps::hours(i128(1)), i128::MAX / i128(3'600'000'000'000'000));
+  EXPECT_EQ(timestamp_ps::MAX - timestamp_ps(), duration_ps::MAX);
+  EXPECT_THROW(duration_ps::MAX / i128(0), overflow_error);
+  EXPECT_THROW(duration_ps::MAX / duration_ps(), overflow_error);
+}
+
+TEST(durationIntegerTest, Chrono) {
+  // same period: a copy of the count, also at compile time
+  constexpr duration_ns d = std::chrono::nanoseconds(42);
+  static_assert(d.to_chrono() == std::chrono::nanoseconds(42));
+  static_assert(std::is_same_v<decltype(d.to_chrono()), std::chrono::nanoseconds>);
+
+  EXPECT_EQ(duration_ns(3min), duration_ns::minutes(i64(3)));
+  EXPECT_EQ(duration_ns(std::chrono::hours(INT64_MAX / 3600)), duration_ns::MAX);
+  EXPECT_LE(duration_ns(-1ns), 0ms);
+  EXPECT_EQ(duration_ns::from_chrono(std::chrono::duration<int64_t, std::pico>{-2999}), duration_ns(i64(-2)));
+  EXPECT_EQ(duration_ns::MAX.to_chrono<std::chrono::seconds>().count(), INT64_MAX / 1'000'000'000);
+  using i32_ms = std::chrono::duration<int32_t, std::milli>;
+  using u64_ps = std::chrono::duration<uint64_t, std::pico>;
+  using u32_s = std::chrono::duration<uint32_t>;
+  using i64_ps = std::chrono::duration<int64_t, std::pico>;
+  EXPECT_EQ(duration_ns::MIN.to_chrono<i32_ms>().count(), INT32_MIN);
+  EXPECT_EQ(duration_ns::MAX.to_chrono<u64_ps>().count(), UINT64_MAX);
+  EXPECT_EQ(duration_ns(-1s).to_chrono<u32_s>().count(), 0u);
+
+  EXPECT_EQ(duration_ps(1ns).count(), i128(1000));
+  EXPECT_EQ(duration_ps::MAX.to_chrono(), i64_ps::max());
+  EXPECT_EQ(duration_ps::seconds(i128(3)).to_chrono<std::chrono::milliseconds>(), 3000ms);
+
+  const auto before = std::chrono::steady_clock::now();
+  const timestamp_ns now = timestamp_ns::now<std::chrono::steady_clock>();
+  EXPECT_GE(now, timestamp_ns::from_chrono(before));
+  const auto point = now.to_chrono<std::chrono::steady_clock>();
+  EXPECT_EQ(point.time_since_epoch().count(), static_cast<int64_t>(now.since_epoch().count()));
+  EXPECT_EQ(timestamp_ps::from_chrono(point).since_epoch(), duration_ps(now.since_epoch().to_chrono()));
+  EXPECT_EQ(timestamp_ps::from_chrono(point).to_chrono<std::chrono::steady_clock>(), point);
+}
+
+TEST(durationIntegerTest, MatchesChrono) {
+  xoshiro256ss engine(5);
+  for (int i = 0; i < 20000; ++i) {
+    const int64_t n = static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 0, 63);
+    const duration_ns d{i64(n)};
+    EXPECT_EQ(static_cast<int64_t>(d.count_as<std::micro>()), std::chrono::nanoseconds(n) / 1us);
+    EXPECT_EQ(static_cast<int64_t>(d.count_as<std::ratio<60>>()), std::chrono::nanoseconds(n) / 1min);
+
+    // picoseconds above 2^64 go through the 128-bit division
+    const duration_ps p = duration_ps(d) * i128(uniform(engine, 1, 1 << 30));
+    const i128 ps = p.count();
+    EXPECT_EQ(p.count_as<std::nano>(), ps / i128(1000));
+    EXPECT_EQ(p.count_as<std::micro>(), ps / i128(1'000'000));
+    EXPECT_EQ(p.count_as<std::ratio<3600>>(), ps / i128(3'600'000'000'000'000));
+  }
+}
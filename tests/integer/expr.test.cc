@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include "expr.hh"
+
+using namespace numbers;
+
+TEST(exprTest, EvaluatesInInt64) {
+  i32 a = 1000;
+  i32 b = -2000;
+  i32 c = 7;
+  i32 d = 3;
+  i32 ret = expr(a) * b + c - d;
+  EXPECT_EQ(ret, i32(a * b + c - d));
+  EXPECT_EQ((expr(a) * b + c - d).checked(), i32(-1999996));
+  EXPECT_EQ((-expr(a) + 5).value(), i32(-995));
+}
+
+TEST(exprTest, IntermediateOverflowCancels) {
+  i32 max = i32::MAX;
+  // max * 2 overflows i32, but the whole expression does not
+  EXPECT_THROW(max * 2 - max, std::runtime_error);
+  i32 ret = expr(max) * 2 - max;
+  EXPECT_EQ(ret, max);
+
+  i8 a = 100;
+  EXPECT_EQ((expr(a) + a - a).checked(), a);
+  EXPECT_EQ((expr(a) + a).checked(), std::nullopt);
+}
+
+TEST(exprTest, FinalOverflow) {
+  i32 max = i32::MAX;
+  i32 min = i32::MIN;
+  EXPECT_THROW(i32(expr(max) + 1), std::runtime_error);
+  EXPECT_EQ((expr(max) + 1).checked(), std::nullopt);
+  EXPECT_EQ((expr(max) + 1).saturating(), max);
+  EXPECT_EQ((expr(min) - 1).saturating(), min);
+  EXPECT_EQ((expr(min) * max).saturating(), min);
+
+  auto [wrapped, overflow] = (expr(max) + 1).overflowing();
+  EXPECT_TRUE(overflow);
+  EXPECT_EQ(wrapped, min);
+  EXPECT_EQ((expr(max) * 2 + 2).wrapping(), i32(0));
+}
+
+TEST(exprTest, WideDomains) {
+  i64 max = i64::MAX;
+  i64 min = i64::MIN;
+  // evaluated in int128
+  EXPECT_EQ((expr(max) * max - expr(max) * max + 1).checked(), i64(1));
+  EXPECT_EQ((expr(min) * min).checked(), std::nullopt);
+  EXPECT_EQ((expr(min) * min - expr(min) * min + min).checked(), min);
+
+  // evaluated in 256 bits
+  i128 big = i128::MAX;
+  EXPECT_EQ((expr(big) * big - expr(big) * big).checked(), i128(0));
+  EXPECT_EQ((expr(big) * 2 - big).checked(), big);
+  EXPECT_EQ((expr(big) * big).checked(), std::nullopt);
+  EXPECT_EQ((expr(i128::MIN) * -1).saturating(), big);
+
+  // too wide for 256 bits, checked step by step
+  i128 small = 3;
+  EXPECT_EQ((expr(small) * small * small * small * small).checked(), i128(243));
+  EXPECT_EQ((expr(small) * small * small - 30).wrapping(), i128(-3));
+  EXPECT_EQ((expr(big) * big * big).checked(), std::nullopt);
+  EXPECT_TRUE(std::get<1>((expr(big) * big * small).overflowing()));
+}
+
+TEST(exprTest, Unsigned) {
+  u32 a = 10;
+  u32 b = 20;
+  // negative intermediate values are fine as long as the result fits
+  EXPECT_EQ((expr(a) - b + b).checked(), a);
+  EXPECT_EQ((expr(a) - b).checked(), std::nullopt);
+  EXPECT_EQ((expr(a) - b).saturating(), u32::MIN);
+  EXPECT_EQ((expr(a) - b).wrapping(), a.wrapping_sub(b));
+
+  u64 max = u64::MAX;
+  EXPECT_EQ((expr(max) * max - expr(max) * max + max).checked(), max);
+  EXPECT_EQ((expr(max) + 1).saturating(), max);
+
+  u128 big = u128::MAX;
+  EXPECT_EQ((expr(big) - big + big).checked(), big);
+  EXPECT_EQ((expr(big) * 2 - big).checked(), big);
+  EXPECT_EQ((expr(big) + 1).checked(), std::nullopt);
+  EXPECT_EQ((expr(big) + 1).wrapping(), u128(0));
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "fixed.hh"
+#include "random.hh"
+
+using namespace numbers;
+
+TEST(fixedIntegerTest, Conversions) {
+  EXPECT_EQ(q15::from_float(0.5f).raw(), i16(16384));
+  EXPECT_EQ(q15::from_float(-1.0).raw(), i16(-32768));
+  EXPECT_EQ(q15::from_float(1.0), q15::MAX);
+  EXPECT_EQ(q15::from_float(-2.0f), q15::MIN);
+  EXPECT_EQ(q15::from_float(std::nanf("")), q15());
+  // ties to even
+  EXPECT_EQ(q15::from_float(std::ldexp(2.5, -15)).raw(), i16(2));
+  EXPECT_EQ(q15::from_float(std::ldexp(-3.5, -15)).raw(), i16(-4));
+
+  EXPECT_EQ(q31::from_float(0.25).raw(), i32(1 << 29));
+  EXPECT_EQ(q31::from_float(1.0f), q31::MAX);
+  EXPECT_EQ(q63::from_float(-0.5).raw(), i64(INT64_MIN / 2));
+  EXPECT_EQ(q63::from_float(std::numeric_limits<double>::infinity()), q63::MAX);
+
+  using q8_8 = fixed<i16, 8>;
+  EXPECT_EQ(q8_8::from_float(1.5).raw(), i16(384));
+  EXPECT_EQ(q8_8::from_raw(i16(-640)).to_double(), -2.5);
+  EXPECT_EQ(q15::from_raw(i16(-16384)).to_float(), -0.5f);
+  EXPECT_EQ(q63::from_float(0.125).to_double(), 0.125);
+}
+
+TEST(fixedIntegerTest, AddSub) {
+  const q15 a = q15::from_float(0.75);
+  const q15 b = q15::from_float(0.5);
+  EXPECT_EQ((a - b).to_double(), 0.25);
+  EXPECT_THROW(a + b, std::runtime_error);
+  EXPECT_EQ(a.checked_add(b), std::nullopt);
+  EXPECT_EQ(a.saturating_add(b), q15::MAX);
+  EXPECT_EQ(a.wrapping_add(b).to_double(), -0.75);
+  EXPECT_EQ(std::get<1>(a.overflowing_add(b)), true);
+  EXPECT_EQ((-a).saturating_sub(b), q15::MIN);
+  EXPECT_EQ(q31::MIN.checked_sub(q31::from_raw(i32(1))), std::nullopt);
+  EXPECT_THROW(-q63::MIN, std::runtime_error);
+}
+
+TEST(fixedIntegerTest, Mul) {
+  EXPECT_EQ((q15::from_float(0.75) * q15::from_float(0.5)).to_double(), 0.375);
+  EXPECT_EQ((q31::from_float(-0.75) * q31::from_float(0.5)).to_double(), -0.375);
+  EXPECT_EQ((q63::from_float(-0.75) * q63::from_float(-0.5)).to_double(), 0.375);
+
+  // -1 * -1 is the only overflow of the Q formats
+  EXPECT_THROW(q15::MIN * q15::MIN, std::runtime_error);
+  EXPECT_EQ(q15::MIN.saturating_mul(q15::MIN), q15::MAX);
+  EXPECT_EQ(q31::MIN.checked_mul(q31::MIN), std::nullopt);
+  EXPECT_EQ(q63::MIN.saturating_mul(q63::MIN), q63::MAX);
+  EXPECT_EQ(q63::MIN.wrapping_mul(q63::MIN), q63::MIN);
+  EXPECT_EQ(q15::MIN.saturating_mul(q15::MAX).raw(), i16(-32767));
+
+  // rounding ties go up, like pmulhrsw
+  EXPECT_EQ(q15::from_raw(i16(1)).saturating_mul(q15::from_raw(i16(16384))).raw(), i16(1));
+  EXPECT_EQ(q15::from_raw(i16(-1)).saturating_mul(q15::from_raw(i16(16384))).raw(), i16(0));
+
+  using q8_8 = fixed<i16, 8>;
+  EXPECT_EQ((q8_8::from_float(1.5) * q8_8::from_float(-2.25)).to_double(), -3.375);
+  EXPECT_EQ(q8_8::from_float(100.0).saturating_mul(q8_8::from_float(-2.0)), q8_8::MIN);
+
+  EXPECT_EQ(q15::from_float(0.5).saturating_mac(q15::MAX, q15::MAX), q15::MAX);
+  EXPECT_EQ(q15::from_float(0.25).saturating_mac(q15::from_float(0.5), q15::from_float(-0.5)), q15());
+}
+
+TEST(fixedIntegerTest, BatchMatchesScalar) {
+  xoshiro256ss engine(5);
+  // odd counts leave a tail for every register width
+  const size_t count = 1000 + 13;
+  std::vector<q15> a(count), b(count), acc(count), dst(count);
+  std::vector<fixed<i32, 20>> c(count), d(count), wide(count);
+  std::vector<float> floats(count);
+  for (size_t i = 0; i < count; ++i) {
+    // plenty of extremes, so that the saturating lanes are exercised
+    a[i] = i % 7 == 0 ? q15::MIN : q15::from_raw(i16(uniform<int16_t>(engine)));
+    b[i] = i % 5 == 0 ? q15::MIN : q15::from_raw(i16(uniform<int16_t>(engine)));
+    acc[i] = q15::from_raw(i16(uniform<int16_t>(engine)));
+    c[i] = fixed<i32, 20>::from_raw(i32(uniform<int32_t>(engine)));
+    d[i] = i % 3 == 0 ? fixed<i32, 20>::MAX : fixed<i32, 20>::from_raw(i32(uniform<int32_t>(engine)));
+    floats[i] = static_cast<float>(uniform(engine, -3000, 3000)) / 2000;
+  }
+  floats[3] = std::nanf("");
+  floats[4] = std::numeric_limits<float>::infinity();
+  floats[5] = -std::numeric_limits<float>::infinity();
+  floats[6] = std::ldexp(0.5f, -15);
+
+  saturating_add(a.data(), b.data(), count, dst.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(dst[i], a[i].saturating_add(b[i])) << i;
+  }
+  saturating_mul(a.data(), b.data(), count, dst.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(dst[i], a[i].saturating_mul(b[i])) << i;
+  }
+  dst = acc;
+  saturating_mac(dst.data(), a.data(), b.data(), count);
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(dst[i], acc[i].saturating_mac(a[i], b[i])) << i;
+  }
+  from_float(floats.data(), count, dst.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(dst[i], q15::from_float(floats[i])) << i;
+  }
+
+  saturating_add(c.data(), d.data(), count, wide.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(wide[i], c[i].saturating_add(d[i])) << i;
+  }
+  saturating_mul(c.data(), d.data(), count, wide.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(wide[i], c[i].saturating_mul(d[i])) << i;
+  }
+  std::vector<q31> q(count);
+  from_float(floats.data(), count, q.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(q[i], q31::from_float(floats[i])) << i;
+  }
+  std::vector<q63> r(count);
+  from_float(floats.data(), count, r.data());
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_EQ(r[i], q63::from_float(floats[i])) << i;
+  }
+}
@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "flat_map.hh"
+
+using namespace numbers;
+
+TEST(flatMapTest, SignedKeys) {
+  flat_map<i64, i64> map;
+  for (int64_t i = -5000; i < 5000; ++i) {
+    map[i64(i)] = i64(-i);
+  }
+  map[i64::MIN] = i64(1);
+  map[i64::MAX] = i64(2);
+  EXPECT_EQ(map.size(), 10002u);
+  for (int64_t i = -5000; i < 5000; ++i) {
+    ASSERT_EQ(*map.find(i64(i)), i64(-i));
+  }
+  EXPECT_EQ(*map.find(i64::MIN), i64(1));
+  EXPECT_EQ(*map.find(i64::MAX), i64(2));
+  EXPECT_FALSE(map.contains(i64(5000)));
+}
+
+TEST(flatMapTest, Int128Keys) {
+  flat_map<i128, int> map;
+  std::unordered_map<i128, int> expected;
+  for (int i = 0; i < 3000; ++i) {
+    const i128 key = i128(make_int128(-i, static_cast<uint64_t>(i) * 3));
+    map[key] = i;
+    expected[key] = i;
+  }
+  for (int i = 0; i < 3000; i += 2) {
+    const i128 key = i128(make_int128(-i, static_cast<uint64_t>(i) * 3));
+    EXPECT_TRUE(map.erase(key));
+    expected.erase(key);
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  for (const auto &[key, value] : expected) {
+    ASSERT_NE(map.find(key), nullptr);
+    EXPECT_EQ(*map.find(key), value);
+  }
+
+  std::vector<i128> keys = {i128::MIN, i128(make_int128(-1, 3)), i128(make_int128(-2, 6))};
+  std::vector<int> values(keys.size());
+  EXPECT_EQ(map.find(keys.data(), keys.size(), values.data(), -1), 1u);
+  EXPECT_EQ(values, (std::vector<int>{-1, 1, -1}));
+}
+
+TEST(flatSetTest, BuiltinKeys) {
+  flat_set<int16_t> set;
+  for (int i = INT16_MIN; i <= INT16_MAX; ++i) {
+    ASSERT_TRUE(set.insert(static_cast<int16_t>(i)));
+  }
+  EXPECT_EQ(set.size(), 65536u);
+  for (int i = INT16_MIN; i <= INT16_MAX; i += 3) {
+    ASSERT_TRUE(set.erase(static_cast<int16_t>(i)));
+  }
+  for (int i = INT16_MIN; i <= INT16_MAX; ++i) {
+    ASSERT_EQ(set.contains(static_cast<int16_t>(i)), (i - INT16_MIN) % 3 != 0);
+  }
+}
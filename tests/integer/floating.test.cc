@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "floating.hh"
+
+using namespace numbers;
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+}  // namespace
+
+TEST(floatingTest, CheckedFromFloat) {
+  EXPECT_EQ(checked_from_float<i32>(3e9), std::nullopt);
+  EXPECT_EQ(checked_from_float<i32>(-2147483648.9), i32::MIN);
+  EXPECT_EQ(checked_from_float<i32>(-2147483649.0), std::nullopt);
+  EXPECT_EQ(checked_from_float<i32>(2147483647.9), i32::MAX);
+  EXPECT_EQ(checked_from_float<i32>(-7.9f), i32(-7));
+  EXPECT_EQ(checked_from_float<i8>(-128.5), i8::MIN);
+  EXPECT_EQ(checked_from_float<i8>(127.99f), i8::MAX);
+  EXPECT_EQ(checked_from_float<i8>(128.0f), std::nullopt);
+  EXPECT_EQ(checked_from_float<i64>(kNaN), std::nullopt);
+  EXPECT_EQ(checked_from_float<i64>(-kInf), std::nullopt);
+  EXPECT_EQ(checked_from_float<i64>(-9223372036854775808.0), i64::MIN);
+  EXPECT_EQ(checked_from_float<i64>(9223372036854775808.0), std::nullopt);
+  EXPECT_EQ(checked_from_float<i128>(-1.5e38), i128(-1.5e38));
+  EXPECT_EQ(checked_from_float<i128>(1.8e38), std::nullopt);
+  EXPECT_EQ(checked_from_float<i128>(-std::ldexp(1.0, 127)), i128::MIN);
+  EXPECT_EQ(checked_from_float<int16_t>(-0.5), int16_t{0});
+}
+
+TEST(floatingTest, SaturatingFromFloat) {
+  EXPECT_EQ(saturating_from_float<i32>(3e9), i32::MAX);
+  EXPECT_EQ(saturating_from_float<i32>(-3e9f), i32::MIN);
+  EXPECT_EQ(saturating_from_float<i32>(kNaN), i32(0));
+  EXPECT_EQ(saturating_from_float<i64>(kInf), i64::MAX);
+  EXPECT_EQ(saturating_from_float<i128>(-kInf), i128::MIN);
+  EXPECT_EQ(saturating_from_float<i128>(1e300), i128::MAX);
+  EXPECT_EQ(saturating_from_float<i16>(-12.7), i16(-12));
+  // the constructors saturate as well
+  EXPECT_EQ(i32(1e10), i32::MAX);
+  EXPECT_EQ(i8(kNaN), i8(0));
+  EXPECT_EQ(i128(-1e300), i128::MIN);
+}
+
+TEST(floatingTest, ToFloat) {
+  EXPECT_EQ(to_double(i32(-5)), -5.0);
+  EXPECT_EQ(to_double(i64::MIN), -9223372036854775808.0);
+  EXPECT_EQ(to_double(i128::MIN), -std::ldexp(1.0, 127));
+  EXPECT_EQ(to_float(i128::MAX), std::ldexp(1.0f, 127));
+  // the low 64 bits alone round up, so adding the rounded halves rounds twice
+  i128 v = i128(make_int128(0x468de09d224fea, 0x133bb4c2baaad651));
+  EXPECT_EQ(to_double(v), 0x1.1a378274893fbp+118);
+  EXPECT_EQ(to_double(-v), -0x1.1a378274893fbp+118);
+  EXPECT_EQ(to_float(int64_t{1} << 40), std::ldexp(1.0f, 40));
+}
+
+TEST(floatingTest, Batch) {
+  std::vector<float> floats = {1.5f, -1.5f, 3e9f, -3e9f, std::numeric_limits<float>::quiet_NaN(), 2147483520.0f, 0.0f};
+  std::vector<double> doubles = {1.5, -1.5, 3e9, -3e9, kNaN, 2147483647.5, -2147483648.5, kInf, 7.0};
+  std::vector<i32> ints(doubles.size());
+
+  saturating_from_float(floats.data(), floats.size(), ints.data());
+  for (size_t i = 0; i < floats.size(); ++i) {
+    EXPECT_EQ(ints[i], saturating_from_float<i32>(floats[i]));
+  }
+  saturating_from_float(doubles.data(), doubles.size(), ints.data());
+  for (size_t i = 0; i < doubles.size(); ++i) {
+    EXPECT_EQ(ints[i], saturating_from_float<i32>(doubles[i]));
+  }
+
+  std::vector<double> back(ints.size());
+  std::vector<float> back_float(ints.size());
+  to_double(ints.data(), ints.size(), back.data());
+  to_float(ints.data(), ints.size(), back_float.data());
+  for (size_t i = 0; i < ints.size(); ++i) {
+    EXPECT_EQ(back[i], to_double(ints[i]));
+    EXPECT_EQ(back_float[i], to_float(ints[i]));
+  }
+
+  std::vector<i64> wide(doubles.size());
+  saturating_from_float(doubles.data(), doubles.size(), wide.data());
+  EXPECT_EQ(wide[2], i64(3000000000));
+  EXPECT_EQ(wide[7], i64::MAX);
+}
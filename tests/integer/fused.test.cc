@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include "fused.hh"
+
+using namespace numbers;
+
+typedef ::testing::Types<i8, i16, i32, i64, i128> Integers;
+
+template <typename T>
+class fusedIntegerTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(fusedIntegerTest, Integers);
+
+TYPED_TEST(fusedIntegerTest, MulAdd) {
+  TypeParam max = TypeParam::MAX;
+  TypeParam min = TypeParam::MIN;
+  EXPECT_EQ(mul_add(TypeParam(3), 4, 5), TypeParam(17));
+  EXPECT_EQ(mul_add(TypeParam(-3), 4, 5), TypeParam(-7));
+  // max * 2 overflows on its own, the fused result does not
+  EXPECT_EQ(mul_add(max, 2, -max), max);
+  EXPECT_EQ(checked_mul_add(min, -1, -1), max);
+  EXPECT_EQ(checked_mul_add(min, -1, 0), std::nullopt);
+  EXPECT_EQ(checked_mul_add(min, 1, -1), std::nullopt);
+  EXPECT_EQ(checked_mul_add(min, -1, min), TypeParam(0));
+  EXPECT_THROW(mul_add(max, max, 0), std::runtime_error);
+  EXPECT_THROW(mul_add(max, 1, 1), std::runtime_error);
+
+  EXPECT_EQ(saturating_mul_add(max, max, min), max);
+  EXPECT_EQ(saturating_mul_add(max, min, max), min);
+  EXPECT_EQ(saturating_mul_add(min, 1, -1), min);
+  EXPECT_EQ(wrapping_mul_add(max, 1, 1), min);
+
+  auto [ret, overflow] = overflowing_mul_add(max, 1, 1);
+  EXPECT_EQ(ret, min);
+  EXPECT_TRUE(overflow);
+  std::tie(ret, overflow) = overflowing_mul_add(max, -1, -1);
+  EXPECT_EQ(ret, min);
+  EXPECT_FALSE(overflow);
+}
+
+TYPED_TEST(fusedIntegerTest, MulSub) {
+  TypeParam max = TypeParam::MAX;
+  TypeParam min = TypeParam::MIN;
+  EXPECT_EQ(mul_sub(TypeParam(3), 4, 5), TypeParam(7));
+  EXPECT_EQ(mul_sub(min, -1, 1), max);
+  EXPECT_EQ(checked_mul_sub(min, 1, 1), std::nullopt);
+  EXPECT_EQ(saturating_mul_sub(min, 1, 1), min);
+  EXPECT_EQ(saturating_mul_sub(min, min, 0), max);
+  EXPECT_EQ(wrapping_mul_sub(min, 1, 1), max);
+  EXPECT_TRUE(std::get<1>(overflowing_mul_sub(max, max, 0)));
+  EXPECT_THROW(mul_sub(min, -1, 0), std::runtime_error);
+}
+
+TYPED_TEST(fusedIntegerTest, Dot2) {
+  TypeParam max = TypeParam::MAX;
+  TypeParam min = TypeParam::MIN;
+  EXPECT_EQ(dot2(TypeParam(3), 4, 5, 6), TypeParam(42));
+  EXPECT_EQ(dot2(max, max, max, -max), TypeParam(0));
+  EXPECT_EQ(dot2(min, 1, max, 1), TypeParam(-1));
+  EXPECT_EQ(dot2(min, max, min, -max), TypeParam(0));
+  EXPECT_EQ(checked_dot2(min, min, min, max), std::nullopt);
+  EXPECT_EQ(checked_dot2(min, min, min, min), std::nullopt);
+  EXPECT_EQ(saturating_dot2(min, min, min, min), max);
+  EXPECT_EQ(saturating_dot2(min, max, min, max), min);
+  EXPECT_EQ(wrapping_dot2(min, min, min, min), TypeParam(0));
+  EXPECT_TRUE(std::get<1>(overflowing_dot2(min, min, min, min)));
+  EXPECT_THROW(dot2(max, max, 1, 1), std::runtime_error);
+}
+
+TYPED_TEST(fusedIntegerTest, Sum3) {
+  TypeParam max = TypeParam::MAX;
+  TypeParam min = TypeParam::MIN;
+  EXPECT_EQ(sum3(TypeParam(1), 2, 3), TypeParam(6));
+  EXPECT_EQ(sum3(max, max, min), max.wrapping_add(max).wrapping_add(min));
+  EXPECT_EQ(sum3(max, 1, -1), max);
+  EXPECT_EQ(checked_sum3(max, max, max), std::nullopt);
+  EXPECT_EQ(saturating_sum3(min, min, max), min);
+  EXPECT_EQ(wrapping_sum3(max, 1, 0), min);
+  EXPECT_FALSE(std::get<1>(overflowing_sum3(max, min, 0)));
+  EXPECT_THROW(sum3(min, -1, 0), std::runtime_error);
+}
@@ -0,0 +1,49 @@
+#include "gtest/gtest.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "hash.hh"
+
+using namespace numbers;
+
+TEST(hashTest, MatchesStdHash) {
+  if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+    EXPECT_EQ(std::hash<i8>()(i8(-7)), numbers::hash(i8(-7)));
+    EXPECT_EQ(std::hash<i64>()(i64::MIN), numbers::hash(i64::MIN));
+    EXPECT_EQ(std::hash<i128>()(i128::MIN), numbers::hash(i128::MIN));
+    EXPECT_EQ(std::hash<int128>()(make_int128(-3, 4)), numbers::hash(i128(make_int128(-3, 4))));
+  }
+  EXPECT_EQ(numbers::hash(i32(-1)), numbers::hash(int32_t{-1}));
+  // negative values are sign extended, so they differ from the same bits read unsigned
+  EXPECT_NE(numbers::hash(i32(-1)), numbers::hash(u32::MAX));
+}
+
+TEST(hashTest, StructuredKeys) {
+  constexpr int64_t kKeys = 1 << 16;
+  std::unordered_set<uint64_t> hashes;
+  std::unordered_set<uint64_t> buckets;
+  for (int64_t x = -kKeys / 2; x < kKeys / 2; ++x) {
+    const uint64_t h = std::hash<i128>()(i128(make_int128(x, static_cast<uint64_t>(2 * x))));
+    hashes.insert(h);
+    buckets.insert(h & (kKeys - 1));
+  }
+  EXPECT_EQ(hashes.size(), static_cast<size_t>(kKeys));
+  EXPECT_GT(buckets.size(), static_cast<size_t>(kKeys * 6 / 10));
+}
+
+TEST(hashTest, Batch) {
+  std::vector<i64> keys;
+  for (int64_t x = -20; x < 20; ++x) {
+    keys.push_back(i64(x * 1000003));
+  }
+  std::vector<uint64_t> hashes(keys.size());
+
+  numbers::hash(keys.data(), keys.size(), hashes.data(), 3);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(hashes[i], numbers::hash(keys[i], 3));
+  }
+
+  std::unordered_set<i64, seeded_hash<i64>> set(keys.begin(), keys.end(), 8, seeded_hash<i64>(3));
+  EXPECT_EQ(set.size(), keys.size());
+}
@@ -17,8 +17,11 @@
 #include "gtest/gtest.h"
 
 #include <numeric>
+#include <sstream>
+#include <string>
 
 #include "int128.hh"
+#include "io.hh"
 
 using namespace numbers;
 
@@ -480,6 +483,26 @@ TEST(Int128Test, DivisionAndModulo) {
   }
 }
 
+// Division, float conversion and formatting run at compile time.
+static_assert(int128(-7) / 2 == -3);
+static_assert(int128(-7) % 2 == -1);
+static_assert(int128_min() / -int128_max() == 1);
+static_assert(int128(-1e30) == -make_int128(0xC9F2C9CD0, 0x4675000000000000));
+static_assert(static_cast<double>(int128(-12345)) == -12345.0);
+
+TEST(Int128Test, ToChars) {
+  char buf[41];
+  char *end = to_chars(buf, buf + sizeof(buf), int128_min());
+  EXPECT_EQ(std::string(buf, end), "-170141183460469231731687303715884105728");
+  end = to_chars(buf, buf + sizeof(buf), int128(-255), 16);
+  EXPECT_EQ(std::string(buf, end), "-ff");
+  EXPECT_EQ(to_chars(buf, buf + 3, int128(-255)), nullptr);
+
+  std::ostringstream os;
+  os << int128(-42) << ' ' << int128_max();
+  EXPECT_EQ(os.str(), "-42 170141183460469231731687303715884105727");
+}
+
 TEST(Int128Test, BitwiseLogic) {
   EXPECT_EQ(int128(-1), ~int128(0));
 
@@ -4,6 +4,7 @@
 #include "gtest/gtest.h"
 
 #include "integer.hh"
+#include "io.hh"
 #include "test/utils.hh"
 
 using namespace numbers;
@@ -87,6 +88,39 @@ TEST(integerTest, integerStringStream) {
     stream << num;
     ASSERT_EQ(stream.str(), std::to_string(n));
   }
+
+  std::ostringstream stream;
+  stream << i8(-5) << ' ' << i128::MIN;
+  ASSERT_EQ(stream.str(), "-5 -170141183460469231731687303715884105728");
+}
+
+TEST(integerTest, integerStreamIn) {
+  std::istringstream stream(" -42 +7 -128 170141183460469231731687303715884105727 -170141183460469231731687303715884105728");
+  i32 a;
+  i8 b;
+  i8 c;
+  i128 d;
+  i128 e;
+  stream >> a >> b >> c >> d >> e;
+  ASSERT_TRUE(stream);
+  ASSERT_EQ(a, i32(-42));
+  ASSERT_EQ(b, i8(7));
+  ASSERT_EQ(c, i8::MIN);
+  ASSERT_EQ(d, i128::MAX);
+  ASSERT_EQ(e, i128::MIN);
+
+  // out of range sets failbit and gives the nearest limit
+  std::istringstream small("-129");
+  small >> b;
+  ASSERT_TRUE(small.fail());
+  ASSERT_EQ(b, i8::MIN);
+  std::istringstream big("170141183460469231731687303715884105728");
+  big >> d;
+  ASSERT_TRUE(big.fail());
+  ASSERT_EQ(d, i128::MAX);
+  std::istringstream text("x");
+  text >> d;
+  ASSERT_TRUE(text.fail());
 }
 
 TEST(integerTest, integerAdd) {
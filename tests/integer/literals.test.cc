@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+
+#include <type_traits>
+
+#include "literals.hh"
+
+using namespace numbers;
+using namespace numbers::literals;
+
+// parsed at compile time
+static_assert(static_cast<uint128>(340282366920938463463374607431768211455_u128) == uint128_max());
+static_assert(static_cast<int128>(-170141183460469231731687303715884105728_i128) == int128_min());
+static_assert(static_cast<int128>(170141183460469231731687303715884105727_i128) == int128_max());
+static_assert(static_cast<uint8_t>(0xFF_u8) == 255);
+static_assert(static_cast<int8_t>(-128_i8) == -128);
+static_assert(static_cast<uint32_t>(0b1010'0000_u32) == 160);
+static_assert(static_cast<uint16_t>(0777_u16) == 511);
+static_assert(std::is_same_v<decltype(42_i64), i64>);
+static_assert(std::is_same_v<decltype(-42_i64), i64>);
+
+constexpr u128 kPowersOfTen[] = {1_u128, 10'000'000'000'000'000'000_u128,
+                                  100'000'000'000'000'000'000'000'000'000'000'000'000_u128};
+
+TEST(literalsIntegerTest, Values) {
+  EXPECT_EQ(0_i32, i32(0));
+  EXPECT_EQ(-7_i16, i16(-7));
+  EXPECT_EQ(0_u8, u8(0));
+  EXPECT_EQ(0x7FFF'FFFF'FFFF'FFFF_i64, i64::MAX);
+  EXPECT_EQ(-9223372036854775808_i64, i64::MIN);
+  EXPECT_EQ(18446744073709551615_u64, u64::MAX);
+  EXPECT_EQ(18446744073709551616_u128, u128(make_uint128(1, 0)));
+  EXPECT_EQ(0xDEADBEEF'00000000'CAFEBABE'12345678_u128, u128(make_uint128(0xDEADBEEF00000000, 0xCAFEBABE12345678)));
+  EXPECT_EQ(0Xab_u8, u8(0xAB));
+  EXPECT_EQ(0B11_u8, u8(3));
+  EXPECT_EQ(-0x80000000000000000000000000000000_i128, i128::MIN);
+  EXPECT_EQ(-1_i128, i128(-1));
+
+  EXPECT_EQ(kPowersOfTen[1], u128(10'000'000'000'000'000'000ull));
+  EXPECT_EQ(kPowersOfTen[2] / kPowersOfTen[1], kPowersOfTen[1]);
+}
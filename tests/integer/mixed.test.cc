@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+
+#include "mixed.hh"
+
+using namespace numbers;
+
+TEST(mixedTest, ResultType) {
+  static_assert(std::is_same_v<mixed_t<i64, u64>, i64>);
+  static_assert(std::is_same_v<mixed_t<u32, i16>, i32>);
+  static_assert(std::is_same_v<mixed_t<i128, u64>, i128>);
+  static_assert(std::is_same_v<mixed_t<u8, u16>, u16>);
+  static_assert(std::is_same_v<mixed_t<i8, i32>, i32>);
+  static_assert(std::is_same_v<mixed_t<u128, i8>, i128>);
+}
+
+TEST(mixedTest, Add) {
+  EXPECT_EQ(i64(-10) + u64(25), i64(15));
+  EXPECT_EQ(u64(25) + i64(-10), i64(15));
+  EXPECT_EQ(checked_add(i64(-1), u64::MAX), std::nullopt);
+  EXPECT_EQ(checked_add(i64::MIN, u64::MAX), i64::MAX);
+  EXPECT_EQ(checked_add(i64::MIN, u64(0)), i64::MIN);
+  EXPECT_EQ(saturating_add(i64(1), u64::MAX), i64::MAX);
+  EXPECT_EQ(saturating_add(i8::MIN, i32(-1)), i32(-129));
+  EXPECT_EQ(wrapping_add(i64(-1), u64(1)), i64(0));
+  EXPECT_THROW(i64::MAX + u64(1), std::runtime_error);
+
+  auto [ret, overflow] = overflowing_add(i32::MAX, u32(1));
+  EXPECT_EQ(ret, i32::MIN);
+  EXPECT_TRUE(overflow);
+
+  EXPECT_EQ(i128::MIN + u128::MAX, i128::MAX);
+  EXPECT_EQ(checked_add(i128(-1), u128::MAX), std::nullopt);
+  EXPECT_EQ(saturating_add(i128::MAX, u64(1)), i128::MAX);
+  EXPECT_EQ(u8(200) + u16(100), u16(300));
+}
+
+TEST(mixedTest, Sub) {
+  EXPECT_EQ(i128(5) - u64(10), i128(-5));
+  EXPECT_EQ(checked_sub(i128::MIN, u64(1)), std::nullopt);
+  EXPECT_EQ(saturating_sub(i128::MIN, u64(1)), i128::MIN);
+  EXPECT_EQ(checked_sub(u64::MAX, i64(-1)), std::nullopt);
+  EXPECT_EQ(saturating_sub(u64::MAX, i64(-1)), i64::MAX);
+  EXPECT_EQ(checked_sub(u64::MAX, i64::MAX), std::nullopt);
+  EXPECT_EQ(checked_sub(u64::MAX - u64(1), i64::MAX), i64::MAX);
+  EXPECT_EQ(checked_sub(u64(0), i64::MIN), std::nullopt);
+  EXPECT_EQ(saturating_sub(u16(0), u32(1)), u32(0));
+  EXPECT_EQ(wrapping_sub(u16(0), u32(1)), u32::MAX);
+  EXPECT_THROW(u32(1) - u64(2), std::runtime_error);
+  EXPECT_TRUE(std::get<1>(overflowing_sub(i64::MIN, u8(1))));
+}
+
+TEST(mixedTest, Mul) {
+  EXPECT_EQ(u32(1000) * i16(-3), i32(-3000));
+  EXPECT_EQ(checked_mul(u32::MAX, i16(-1)), std::nullopt);
+  EXPECT_EQ(checked_mul(u32(1) << 31, i16(-1)), i32::MIN);
+  EXPECT_EQ(saturating_mul(u32::MAX, i16(-2)), i32::MIN);
+  EXPECT_EQ(saturating_mul(u32::MAX, i16(2)), i32::MAX);
+  EXPECT_EQ(wrapping_mul(u32::MAX, i16(-1)), i32(1));
+  EXPECT_EQ(u32(0) * i64::MIN, i64(0));
+
+  EXPECT_EQ(checked_mul(u64(1) << 63, i128(-2)), i128(-1) * (i128(1) << 64));
+  EXPECT_EQ(checked_mul(u128::MAX, i64(-1)), std::nullopt);
+  EXPECT_EQ(checked_mul(u128(1) << 127, i8(-1)), i128::MIN);
+  EXPECT_EQ(saturating_mul(u128::MAX, i8(-3)), i128::MIN);
+  EXPECT_EQ(saturating_mul(i128::MAX, u8(2)), i128::MAX);
+  EXPECT_EQ(wrapping_mul(u128::MAX, i8(-1)), i128(1));
+  EXPECT_THROW(i128::MAX * u64(2), std::runtime_error);
+}
+
+TEST(mixedTest, RawOperand) {
+  // the raw operand is not truncated to the type of the right hand side
+  EXPECT_EQ(200 + i8(-100), i8(100));
+  EXPECT_EQ(300 - i16(1), i16(299));
+  EXPECT_EQ(int64_t{1000} * i8(0), i8(0));
+  EXPECT_THROW(256 + i8(0), std::runtime_error);
+  EXPECT_THROW((int64_t{1} << 32) + i32(0), std::runtime_error);
+  EXPECT_EQ(1000 / i8(10), i8(100));
+  EXPECT_THROW(-128 / i8(-1), std::runtime_error);
+  EXPECT_THROW(1000 / i8(1), std::runtime_error);
+  EXPECT_EQ(1001 % i8(10), i8(1));
+  EXPECT_EQ(-1001 % i8(10), i8(-1));
+
+  // a negative remainder does not fit an unsigned result
+  EXPECT_THROW(-7 % u8(3), std::runtime_error);
+  EXPECT_THROW(-7 % u16(3), std::runtime_error);
+  EXPECT_THROW(-7 % u32(3), std::runtime_error);
+  EXPECT_THROW(int64_t{-7} % u64(3), std::runtime_error);
+  EXPECT_THROW(int64_t{-7} % u128(3), std::runtime_error);
+  EXPECT_EQ(-6 % u32(3), u32(0));
+  EXPECT_EQ(7 % u64(3), u64(1));
+
+  EXPECT_TRUE(-200 < i8(5));
+  EXPECT_TRUE(300 > i8(44));
+  EXPECT_FALSE(300 == i8(44));
+  EXPECT_TRUE(-129 <= i8::MIN);
+  EXPECT_FALSE(-129 >= i8::MIN);
+}
@@ -0,0 +1,73 @@
+#include "gtest/gtest.h"
+
+#include <optional>
+#include <vector>
+
+#include "niche.hh"
+#include "random.hh"
+
+using namespace numbers;
+
+static_assert(sizeof(niche_optional<i64>) == sizeof(i64));
+static_assert(sizeof(niche_optional<i8>) == 1);
+static_assert(sizeof(niche_optional<u32>) == sizeof(u32));
+static_assert(sizeof(niche_optional<i128>) == sizeof(i128));
+
+TEST(nicheIntegerTest, Optional) {
+  niche_optional<i64> empty;
+  EXPECT_FALSE(empty.has_value());
+  EXPECT_FALSE(empty);
+  EXPECT_THROW(empty.value(), std::bad_optional_access);
+  EXPECT_EQ(empty.value_or(i64(7)), i64(7));
+  EXPECT_EQ(empty, std::nullopt);
+  EXPECT_EQ(niche_optional<i64>::niche(), i64::MIN);
+
+  niche_optional<i64> five = i64(5);
+  EXPECT_TRUE(five);
+  EXPECT_EQ(*five, i64(5));
+  EXPECT_EQ(five.value(), i64(5));
+  EXPECT_EQ(five->abs(), i64(5));
+  EXPECT_NE(five, empty);
+  EXPECT_EQ(five, niche_optional<i64>(std::optional<i64>(i64(5))));
+  EXPECT_EQ(std::optional<i64>(five), std::optional<i64>(i64(5)));
+  EXPECT_EQ(std::optional<i64>(empty), std::nullopt);
+  five.reset();
+  EXPECT_EQ(five, empty);
+
+  // the reserved value can not be held
+  EXPECT_FALSE(niche_optional<i64>(i64::MIN));
+  EXPECT_TRUE(niche_optional<i64>(i64::MIN + i64(1)));
+  EXPECT_FALSE(niche_optional<u16>(u16::MAX));
+  EXPECT_EQ(niche_optional<u16>(u16(0)).value(), u16(0));
+}
+
+TEST(nicheIntegerTest, Checked) {
+  EXPECT_EQ(niche_checked_add(i64(1), i64(2)).value(), i64(3));
+  EXPECT_FALSE(niche_checked_add(i64::MAX, i64(1)));
+  // MIN is in range but reserved
+  EXPECT_FALSE(niche_checked_sub(i64::MIN + i64(1), i64(1)));
+  EXPECT_FALSE(niche_checked_mul(i32(1 << 16), i32(1 << 15)));
+  EXPECT_EQ(*niche_checked_mul(i32(-3), i32(7)), i32(-21));
+  EXPECT_FALSE(niche_checked_div(i64(1), i64(0)));
+  EXPECT_FALSE(niche_checked_div(i64::MIN, i64(-1)));
+  EXPECT_EQ(*niche_checked_div(i64(-9), i64(2)), i64(-4));
+  EXPECT_FALSE(niche_checked_neg(i8::MIN));
+  EXPECT_EQ(*niche_checked_abs(i8(-128 + 1)), i8(127));
+
+  EXPECT_FALSE(niche_checked_sub(u64(1), u64(2)));
+  EXPECT_FALSE(niche_checked_add(u64::MAX - u64(1), u64(1)));
+  EXPECT_EQ(*niche_checked_add(u64::MAX - u64(2), u64(1)), u64::MAX - u64(1));
+  EXPECT_FALSE(niche_checked_div(u32(1), u32(0)));
+  EXPECT_FALSE(niche_checked_mul(i128::MAX, i128(2)));
+}
+
+TEST(nicheIntegerTest, MatchesChecked) {
+  xoshiro256ss engine(3);
+  for (int i = 0; i < 10000; ++i) {
+    const i64 a = i64(static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 0, 63));
+    const i64 b = i64(static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 0, 63));
+    EXPECT_EQ(niche_checked_add(a, b), niche_optional<i64>(a.checked_add(b)));
+    EXPECT_EQ(niche_checked_sub(a, b), niche_optional<i64>(a.checked_sub(b)));
+    EXPECT_EQ(niche_checked_mul(a, b), niche_optional<i64>(a.checked_mul(b)));
+  }
+}
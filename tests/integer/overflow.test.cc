@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "atomic.hh"
+#include "cast.hh"
+#include "ct.hh"
+#include "decimal.hh"
+#include "expr.hh"
+#include "fixed.hh"
+#include "fused.hh"
+#include "mixed.hh"
+#include "numbers.h"
+#include "overflow.hh"
+#include "rational.hh"
+
+using namespace numbers;
+
+namespace {
+
+template <typename F>
+overflow_error catch_overflow(F f) {
+  try {
+    f();
+  } catch (const overflow_error &err) {
+    return err;
+  }
+  ADD_FAILURE() << "no overflow_error thrown";
+  return overflow_error("none", "", "");
+}
+
+}  // namespace
+
+TEST(overflowIntegerTest, Operands) {
+  overflow_error err = catch_overflow([] { return i32(2147483647) + i32(1); });
+  EXPECT_STREQ(err.op(), "add");
+  EXPECT_STREQ(err.lhs(), "2147483647");
+  EXPECT_STREQ(err.rhs(), "1");
+  EXPECT_STREQ(err.what(), "add overflow: 2147483647 + 1");
+  EXPECT_EQ(err.location().line(), 0u);
+
+  err = catch_overflow([] { return i8(-128) / i8(-1); });
+  EXPECT_STREQ(err.what(), "div overflow: -128 / -1");
+
+  err = catch_overflow([] { return -i16(-32768); });
+  EXPECT_STREQ(err.what(), "neg overflow: neg(-32768)");
+  EXPECT_STREQ(err.rhs(), "");
+
+  err = catch_overflow([] { return i64::MIN.abs(); });
+  EXPECT_STREQ(err.lhs(), "-9223372036854775808");
+
+  err = catch_overflow([] { return u8(3) - u8(4); });
+  EXPECT_STREQ(err.what(), "sub overflow: 3 - 4");
+
+  // add and sub report lhs worked out from the wrapped result
+  err = catch_overflow([] { return i8(-100) - i8(100); });
+  EXPECT_STREQ(err.what(), "sub overflow: -100 - 100");
+  err = catch_overflow([] { return i64::MIN + i64(-1); });
+  EXPECT_STREQ(err.what(), "add overflow: -9223372036854775808 + -1");
+  err = catch_overflow([] { return u64::MAX + u64::MAX; });
+  EXPECT_STREQ(err.what(), "add overflow: 18446744073709551615 + 18446744073709551615");
+
+  err = catch_overflow([] { return u128::MAX * u128(2); });
+  EXPECT_STREQ(err.lhs(), "340282366920938463463374607431768211455");
+
+  err = catch_overflow([] { return i128::MIN - i128(1); });
+  EXPECT_STREQ(err.lhs(), "-170141183460469231731687303715884105728");
+}
+
+TEST(overflowIntegerTest, MixedOperands) {
+  overflow_error err = catch_overflow([] { return 100 + i8(100); });
+  EXPECT_STREQ(err.what(), "add overflow: 100 + 100");
+
+  err = catch_overflow([] { return i64(-1) * u64::MAX; });
+  EXPECT_STREQ(err.what(), "mul overflow: -1 * 18446744073709551615");
+
+  err = catch_overflow([] { return -7 % u32(3); });
+  EXPECT_STREQ(err.what(), "rem overflow: -7 % 3");
+}
+
+TEST(overflowIntegerTest, OtherTypes) {
+  using money = decimal64<2>;
+  overflow_error err = catch_overflow([] { return money::MAX * money::from_units(i64(200)); });
+  EXPECT_STREQ(err.what(), "mul overflow: 9223372036854775807 * 200");
+  err = catch_overflow([] { return money::from_units(i64(5)) / money(); });
+  EXPECT_STREQ(err.what(), "div overflow: 5 / 0");
+  err = catch_overflow([] { return money::from_integer(i64::MAX); });
+  EXPECT_STREQ(err.what(), "mul overflow: 9223372036854775807 * 100");
+
+  using ratio = rational<i128>;
+  err = catch_overflow([] { return ratio::MAX + ratio::from(i128(1), i128(2)); });
+  EXPECT_STREQ(err.what(), "add overflow: 170141183460469231731687303715884105727/1 + 1/2");
+  err = catch_overflow([] { return -ratio::MIN; });
+  EXPECT_STREQ(err.what(), "neg overflow: neg(-170141183460469231731687303715884105728/1)");
+  err = catch_overflow([] { return ratio() / ratio(); });
+  EXPECT_STREQ(err.what(), "div overflow: 0/1 / 0/1");
+  err = catch_overflow([] { return rational<i64>::from(i64(1), i64(0)); });
+  EXPECT_STREQ(err.what(), "div overflow: 1 / 0");
+
+  err = catch_overflow([] { return q15::MIN * q15::MIN; });
+  EXPECT_STREQ(err.what(), "mul overflow: -32768 * -32768");
+
+  err = catch_overflow([] { return try_from<u8>(i32(-1)); });
+  EXPECT_STREQ(err.what(), "cast overflow: cast(-1)");
+}
+
+TEST(overflowIntegerTest, FirstStep) {
+  overflow_error err = catch_overflow([] { return mul_add(i32(65536), i32(65536), i32(0)); });
+  EXPECT_STREQ(err.what(), "mul overflow: 65536 * 65536");
+  err = catch_overflow([] { return mul_sub(u8(2), u8(3), u8(7)); });
+  EXPECT_STREQ(err.what(), "sub overflow: 6 - 7");
+  err = catch_overflow([] { return dot2(i8(10), i8(10), i8(10), i8(3)); });
+  EXPECT_STREQ(err.what(), "add overflow: 100 + 30");
+  err = catch_overflow([] { return sum3(u16(1), u16(65535), u16(0)); });
+  EXPECT_STREQ(err.what(), "add overflow: 1 + 65535");
+
+  const i32 a = i32::MAX;
+  err = catch_overflow([&] { return i32(expr(a) * 2 - 1); });
+  EXPECT_STREQ(err.what(), "mul overflow: 2147483647 * 2");
+  err = catch_overflow([&] { return i8(expr(i8(1)) + 300); });
+  EXPECT_STREQ(err.what(), "cast overflow: cast(300)");
+  err = catch_overflow([&] { return u32(-expr(u32(1)) + 0); });
+  EXPECT_STREQ(err.what(), "neg overflow: neg(1)");
+
+  atomic<i16> counter(i16(32000));
+  err = catch_overflow([&] { return counter.fetch_add(i16(1000)); });
+  EXPECT_STREQ(err.what(), "add overflow: 32000 + 1000");
+  err = catch_overflow([&] { return counter.fetch_sub(i16(-1000)); });
+  EXPECT_STREQ(err.what(), "sub overflow: 32000 - -1000");
+  EXPECT_EQ(counter.load(), i16(32000));
+}
+
+TEST(overflowIntegerTest, Location) {
+  const int line = __LINE__ + 1;
+  overflow_error err = catch_overflow([] { return ct::mul(i64::MAX, i64(2)); });
+  EXPECT_STREQ(err.op(), "mul");
+#ifdef NUMBERS_INTERNAL_HAVE_SOURCE_LOCATION
+  EXPECT_EQ(err.location().line(), static_cast<unsigned>(line));
+  EXPECT_NE(std::strstr(err.location().file_name(), "overflow.test.cc"), nullptr);
+  EXPECT_NE(std::string(err.what()).find("overflow.test.cc:" + std::to_string(line)), std::string::npos);
+#endif
+
+  err = catch_overflow([] { return ct::shl(u32(3), 31); });
+  EXPECT_EQ(std::string(err.what()).rfind("shl overflow: 3 << 31", 0), 0u);
+}
+
+TEST(overflowIntegerTest, IsRuntimeError) {
+  EXPECT_THROW(i32(2147483647) + i32(1), std::runtime_error);
+  const overflow_error err("add", "1", "2");
+  const overflow_error copy = err;
+  EXPECT_STREQ(copy.what(), "add overflow: 1 + 2");
+  static_assert(std::is_nothrow_copy_constructible_v<overflow_error>);
+}
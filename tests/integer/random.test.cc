@@ -0,0 +1,55 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <vector>
+
+#include "random.hh"
+
+using namespace numbers;
+
+TEST(randomTest, UniformSigned) {
+  xoshiro256ss engine(17);
+  std::array<int, 5> histogram{};
+  for (int i = 0; i < 50000; ++i) {
+    const i8 v = uniform(engine, i8(-2), i8(2));
+    ASSERT_GE(v, i8(-2));
+    ASSERT_LE(v, i8(2));
+    ++histogram[static_cast<int8_t>(v) + 2];
+  }
+  for (int count : histogram) {
+    EXPECT_GT(count, 9500);
+    EXPECT_LT(count, 10500);
+  }
+
+  bool negative = false;
+  bool positive = false;
+  for (int i = 0; i < 100; ++i) {
+    const i64 v = uniform(engine, i64::MIN, i64::MAX);
+    negative |= v < i64(0);
+    positive |= v > i64(0);
+  }
+  EXPECT_TRUE(negative && positive);
+  EXPECT_EQ(uniform(engine, int32_t{-5}, int32_t{-5}), -5);
+  EXPECT_THROW(uniform(engine, i16(0), i16(-1)), std::runtime_error);
+}
+
+TEST(randomTest, Uniform128) {
+  pcg64 engine(19);
+  const i128 lo = i128(make_int128(-2, 0));
+  const i128 hi = i128(make_int128(1, 0));
+  bool below = false;
+  bool above = false;
+  for (int i = 0; i < 1000; ++i) {
+    const i128 v = uniform(engine, lo, hi);
+    ASSERT_GE(v, lo);
+    ASSERT_LE(v, hi);
+    below |= v < i128(make_int128(-1, 0));
+    above |= v > i128(0);
+  }
+  EXPECT_TRUE(below && above);
+  EXPECT_EQ(uniform(engine, i128::MIN, i128::MIN), i128::MIN);
+
+  std::vector<i128> values(64);
+  fill_uniform(engine, values.data(), values.size(), i128::MIN, i128::MAX);
+  EXPECT_NE(values[0], values[1]);
+}
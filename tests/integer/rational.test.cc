@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "random.hh"
+#include "rational.hh"
+
+using namespace numbers;
+
+namespace {
+
+using r64 = rational<i64>;
+using r128 = rational<i128>;
+
+r64 q(int64_t num, int64_t den) { return r64::from(i64(num), i64(den)); }
+
+}  // namespace
+
+TEST(rationalIntegerTest, Normalize) {
+  EXPECT_EQ(q(6, -4).numerator(), i64(-3));
+  EXPECT_EQ(q(6, -4).denominator(), i64(2));
+  EXPECT_EQ(q(0, -5), r64());
+  EXPECT_EQ(q(0, -5).denominator(), i64(1));
+  EXPECT_EQ(q(-7, -14), q(1, 2));
+  EXPECT_EQ(q(INT64_MIN, 2).numerator(), i64(INT64_MIN / 2));
+  EXPECT_EQ(q(INT64_MIN, INT64_MIN), q(1, 1));
+  EXPECT_THROW(q(1, 0), std::runtime_error);
+  EXPECT_EQ(r64::checked_from(i64(1), i64(INT64_MIN)), std::nullopt);
+  EXPECT_EQ(r64::checked_from(i64(INT64_MIN), i64(-1)), std::nullopt);
+  EXPECT_EQ(q(3, 4).to_double(), 0.75);
+}
+
+TEST(rationalIntegerTest, Arithmetic) {
+  EXPECT_EQ(q(1, 3) + q(1, 6), q(1, 2));
+  EXPECT_EQ(q(1, 2) - q(3, 4), q(-1, 4));
+  EXPECT_EQ(q(2, 3) * q(9, 4), q(3, 2));
+  EXPECT_EQ(q(1, 2) / q(-1, 4), q(-2, 1));
+  EXPECT_EQ(q(5, 7) - q(5, 7), r64());
+  EXPECT_EQ(-q(5, 7), q(-5, 7));
+  EXPECT_THROW(-r64::MIN, std::runtime_error);
+  EXPECT_THROW(q(1, 2) / r64(), std::runtime_error);
+  EXPECT_EQ(q(1, 2).checked_div(r64()), std::nullopt);
+  EXPECT_EQ(q(-1, 2).saturating_div(r64()), r64::MIN);
+  EXPECT_EQ(r64().saturating_div(r64()), r64());
+
+  // the naive products would overflow, the reduced results fit
+  const int64_t big = int64_t{1} << 62;
+  EXPECT_EQ(q(big, 3) * q(3, big), q(1, 1));
+  EXPECT_EQ(q(1, big) + q(1, big), q(1, big / 2));
+  EXPECT_EQ(q(INT64_MAX, 2) - q(INT64_MAX - 2, 2), q(1, 1));
+  EXPECT_EQ(q(INT64_MIN, 3) / q(INT64_MIN, 3), q(1, 1));
+}
+
+TEST(rationalIntegerTest, Overflow) {
+  EXPECT_THROW(r64::MAX + q(1, 1), std::runtime_error);
+  EXPECT_EQ(r64::MAX.checked_add(q(1, 1)), std::nullopt);
+  EXPECT_EQ(r64::MAX.saturating_add(q(1, 1)), r64::MAX);
+  EXPECT_EQ(r64::MIN.saturating_sub(q(1, 2)), r64::MIN);
+  EXPECT_THROW(q(1, INT64_MAX) * q(1, INT64_MAX), std::runtime_error);
+
+  // in range but not representable: rounded to the nearest fraction that fits
+  EXPECT_EQ(q(1, INT64_MAX).saturating_mul(q(1, INT64_MAX)), r64());
+  EXPECT_EQ(q(INT64_MAX, 3).saturating_mul(q(2, 1)), q(6148914691236517205, 1));
+  EXPECT_EQ(q(-INT64_MAX, 3).saturating_mul(q(2, 1)), q(-6148914691236517205, 1));
+  const r64 near_one = q(INT64_MAX - 1, INT64_MAX).saturating_mul(q(INT64_MAX - 2, INT64_MAX - 1));
+  EXPECT_NEAR(near_one.to_double(), 1.0, 1e-15);
+  // the best approximations with denominators up to INT64_MAX, as found by
+  // Python's Fraction.limit_denominator
+  EXPECT_EQ(q(3, 2).saturating_add(q(1, INT64_MAX)), q((int64_t{3} << 61) - 1, (int64_t{1} << 62) - 1));
+  EXPECT_EQ(q(-3842892157, 2605387282264973547).saturating_mul(q(114050619944573, 7663428599030521515)),
+            q(-171817, 7827186621608107009));
+  EXPECT_EQ(q(INT64_MAX - 1, INT64_MAX).saturating_mul(q(INT64_MAX - 2, INT64_MAX - 1)),
+            q(INT64_MAX - 2, INT64_MAX));
+  EXPECT_EQ(q(INT64_MIN, 3).saturating_mul(q(2, 1)), q(-6148914691236517205, 1));
+  EXPECT_EQ(q(INT64_MAX, 1).saturating_mul(q(INT64_MAX, 1)), r64::MAX);
+  EXPECT_EQ(q(INT64_MAX, 1).saturating_mul(q(-INT64_MAX, 1)), r64::MIN);
+}
+
+TEST(rationalIntegerTest, Compare) {
+  EXPECT_LT(q(1, 3), q(1, 2));
+  EXPECT_LT(q(-1, 2), q(-1, 3));
+  EXPECT_GT(q(INT64_MAX, INT64_MAX - 1), q(1, 1));
+  EXPECT_LT(q(INT64_MAX - 1, INT64_MAX), q(1, 1));
+  EXPECT_LT(q(INT64_MAX - 2, INT64_MAX - 1), q(INT64_MAX - 1, INT64_MAX));
+  EXPECT_LT(r64::MIN, q(INT64_MIN + 1, INT64_MAX));
+  EXPECT_LE(q(2, 4), q(1, 2));
+  EXPECT_GE(q(2, 4), q(1, 2));
+  EXPECT_NE(q(2, 3), q(3, 4));
+}
+
+TEST(rationalIntegerTest, Wide) {
+  const i128 two_99 = i128(1) << 99;
+  const r128 a = r128::from(i128(1), two_99 * i128(2));
+  const r128 b = r128::from(i128(1), two_99 * i128(3));
+  EXPECT_EQ(a + b, r128::from(i128(5), two_99 * i128(6)));
+  EXPECT_EQ(a.checked_mul(b), std::nullopt);
+  EXPECT_EQ(a.saturating_mul(b), r128());
+  EXPECT_EQ(a * r128::from(two_99, i128(3)), r128::from(i128(1), i128(6)));
+  EXPECT_EQ((a / b), r128::from(i128(3), i128(2)));
+  EXPECT_LT(b, a);
+
+  const r128 max = r128::MAX;
+  const r128 almost = r128::from(i128::MAX - i128(1), i128::MAX);
+  EXPECT_LT(almost, r128(i128(1)));
+  EXPECT_GT(r128::from(i128::MAX, i128::MAX - i128(1)), r128(i128(1)));
+  EXPECT_EQ(max.checked_mul(max), std::nullopt);
+  EXPECT_EQ(max.saturating_mul(max), max);
+  EXPECT_EQ(almost * almost.saturating_div(almost), almost);
+  EXPECT_EQ(r128::from(i128::MAX, i128(3)).saturating_mul(r128(i128(2))).denominator(), i128(1));
+  EXPECT_EQ(r128::from(i128(3), i128(2)).saturating_add(r128::from(i128(1), i128::MAX)),
+            r128::from(i128(3) * (i128(1) << 125) - i128(1), (i128(1) << 126) - i128(1)));
+  EXPECT_EQ(r128::from(i128::MIN, i128(3)) - r128::from(i128::MIN, i128(3)), r128());
+}
+
+namespace {
+
+long double to_long_double(int64_t v) { return static_cast<long double>(v); }
+long double to_long_double(int128 v) { return static_cast<long double>(v); }
+
+// Checks that the saturating operations that have to round land within a few
+// ulps of long double of the exact result, for random rational<IntT> made
+// from numerators and denominators drawn by `part`.
+template <typename IntT, typename Part>
+void check_approximations(Part part) {
+  using R = rational<IntT>;
+  using raw_type = numbers_internal::raw_type_t<IntT>;
+  // Between 2^-20 and 2^20 the nearest fraction that fits is far closer to
+  // the exact result than long double can tell.
+  const long double tolerance = 16 * std::numeric_limits<long double>::epsilon();
+  int approximated = 0;
+  for (int i = 0; i < 20000; ++i) {
+    const raw_type an = part(true);
+    const raw_type ad = part(false);
+    const raw_type bn = part(true);
+    const raw_type bd = part(false);
+    const R a = R::from(IntT(an), IntT(ad));
+    const R b = R::from(IntT(bn), IntT(bd));
+    const long double x = to_long_double(an) / to_long_double(ad);
+    const long double y = to_long_double(bn) / to_long_double(bd);
+    const auto check = [&](const R &got, long double exact, const char *op) {
+      ++approximated;
+      if (std::fabs(exact) < 0x1p-20L || std::fabs(exact) > 0x1p20L) {
+        return;
+      }
+      const long double value = to_long_double(static_cast<raw_type>(got.numerator())) /
+                                to_long_double(static_cast<raw_type>(got.denominator()));
+      EXPECT_LE(std::fabs(value - exact), tolerance * std::fabs(exact))
+          << a.to_double() << " " << op << " " << b.to_double();
+    };
+    if (!a.checked_add(b)) {
+      check(a.saturating_add(b), x + y, "+");
+    }
+    if (!a.checked_mul(b)) {
+      check(a.saturating_mul(b), x * y, "*");
+    }
+    if (bn != 0 && !a.checked_div(b)) {
+      check(a.saturating_div(b), x / y, "/");
+    }
+  }
+  EXPECT_GT(approximated, 1000);
+}
+
+}  // namespace
+
+TEST(rationalIntegerTest, ApproximationError) {
+  xoshiro256ss engine(5);
+  check_approximations<i64>([&](bool numerator) {
+    const uint64_t bits = uniform<uint64_t>(engine) >> uniform(engine, 1, 63);
+    return numerator ? static_cast<int64_t>(bits) * (uniform(engine, 0, 1) ? 1 : -1) : static_cast<int64_t>(bits | 1);
+  });
+  check_approximations<i128>([&](bool numerator) {
+    const int128 bits = int128(uniform<uint64_t>(engine) >> uniform(engine, 1, 63)) << uniform(engine, 0, 63);
+    return numerator ? (uniform(engine, 0, 1) ? bits : -bits) : bits | 1;
+  });
+}
+
+#ifdef __SIZEOF_INT128__
+TEST(rationalIntegerTest, MatchesNaiveInt128) {
+  const auto gcd = [](__int128 a, __int128 b) {
+    a = a < 0 ? -a : a;
+    b = b < 0 ? -b : b;
+    while (b != 0) {
+      const __int128 t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  };
+  // the naive num/den reduced, or nullopt if it does not fit
+  const auto reduce = [&](__int128 num, __int128 den) -> std::optional<r64> {
+    if (den < 0) {
+      num = -num;
+      den = -den;
+    }
+    const __int128 g = gcd(num, den);
+    num /= g;
+    den /= g;
+    if (num < INT64_MIN || num > INT64_MAX || den > INT64_MAX) {
+      return {};
+    }
+    return q(static_cast<int64_t>(num), static_cast<int64_t>(den));
+  };
+
+  xoshiro256ss engine(11);
+  std::vector<r64> values;
+  for (int i = 0; i < 20000; ++i) {
+    const int64_t an = static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 1, 63);
+    const int64_t ad = static_cast<int64_t>(uniform<uint64_t>(engine) >> uniform(engine, 1, 63)) | 1;
+    const int64_t bn = static_cast<int64_t>(uniform<uint64_t>(engine)) >> uniform(engine, 1, 63);
+    const int64_t bd = static_cast<int64_t>(uniform<uint64_t>(engine) >> uniform(engine, 1, 63)) | 1;
+    const r64 a = q(an, ad);
+    const r64 b = q(bn, bd);
+    values.push_back(a);
+    const __int128 x = static_cast<int64_t>(a.numerator());
+    const __int128 y = static_cast<int64_t>(a.denominator());
+    const __int128 z = static_cast<int64_t>(b.numerator());
+    const __int128 w = static_cast<int64_t>(b.denominator());
+
+    EXPECT_EQ(a.checked_add(b), reduce(x * w + z * y, y * w)) << an << "/" << ad << " + " << bn << "/" << bd;
+    EXPECT_EQ(a.checked_sub(b), reduce(x * w - z * y, y * w)) << an << "/" << ad << " - " << bn << "/" << bd;
+    EXPECT_EQ(a.checked_mul(b), reduce(x * z, y * w)) << an << "/" << ad << " * " << bn << "/" << bd;
+    if (z != 0) {
+      EXPECT_EQ(a.checked_div(b), reduce(x * w, y * z)) << an << "/" << ad << " / " << bn << "/" << bd;
+    }
+    EXPECT_EQ(a < b, x * w < z * y);
+    EXPECT_EQ(a == b, x * w == z * y);
+
+    // the same fractions in i128 order the same way
+    const r128 wa = r128::from(i128(an), i128(ad));
+    const r128 wb = r128::from(i128(bn), i128(bd));
+    EXPECT_EQ(wa < wb, a < b);
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), [](const r64 &l, const r64 &r) {
+    return static_cast<__int128>(static_cast<int64_t>(l.numerator())) * static_cast<int64_t>(r.denominator()) <
+           static_cast<__int128>(static_cast<int64_t>(r.numerator())) * static_cast<int64_t>(l.denominator());
+  }));
+}
+#endif
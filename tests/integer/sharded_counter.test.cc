@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "sharded_counter.hh"
+
+using namespace numbers;
+
+TEST(shardedCounterIntegerTest, Basic) {
+  sharded_counter<i64> counter(2);
+  EXPECT_EQ(counter.shards(), 2);
+  counter.add(i64(10));
+  counter.add(i64(-25));
+  EXPECT_EQ(counter.load(), i64(-15));
+  EXPECT_EQ(counter.checked_load(), i64(-15));
+  EXPECT_EQ(counter.load_as<i128>(), i128(-15));
+}
+
+TEST(shardedCounterIntegerTest, LoadAsKeepsTheSign) {
+  sharded_counter<i64> counter(4);
+  counter.add(i64(-5));
+  EXPECT_EQ(counter.load(), i64(-5));
+  EXPECT_EQ(counter.load_as<i64>(), i64(-5));
+  EXPECT_EQ(counter.load_as<i128>(), i128(-5));
+  // both adds land on this thread's slot, which saturates
+  counter.add(i64::MIN);
+  EXPECT_EQ(counter.load_as<i128>(), i128(i64::MIN));
+
+  // an unsigned alias would turn -5 into 2^64 - 5 or 2^128 - 5, and does not compile
+  static_assert(!sharded_internal::holds_all_v<u64, i64>);
+  static_assert(!sharded_internal::holds_all_v<u128, i64>);
+  static_assert(!sharded_internal::holds_all_v<i32, i64>);
+  static_assert(sharded_internal::holds_all_v<i128, i64>);
+}
+
+TEST(shardedCounterIntegerTest, Saturation) {
+  sharded_counter<i8> counter(1);
+  counter.add(i8(100));
+  counter.add(i8(100));
+  EXPECT_EQ(counter.load(), i8::MAX);
+  counter.add(i8(-128));
+  counter.add(i8(-128));
+  counter.add(i8(-128));
+  EXPECT_EQ(counter.load(), i8::MIN);
+}
+
+TEST(shardedCounterIntegerTest, Threads) {
+  constexpr int kThreads = 4;
+  sharded_counter<i16> counter(kThreads);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] { counter.add(i16(-20000)); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter.load(), i16::MIN);
+  EXPECT_EQ(counter.checked_load(), std::nullopt);
+  EXPECT_EQ(counter.load_as<i32>(), i32(-80000));
+}
@@ -0,0 +1,29 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "sketch.hh"
+
+using namespace numbers;
+
+TEST(sketchIntegerTest, SignedKeys) {
+  count_min<u16> sketch(512, 4);
+  hyperloglog hll(10);
+  std::vector<i64> keys;
+  for (int64_t k = -500; k < 500; ++k) {
+    keys.push_back(i64(k));
+  }
+  sketch.add(keys.data(), keys.size());
+  hll.add(keys.data(), keys.size());
+  sketch.add_conservative(i64(-1), u16(10));
+
+  EXPECT_GE(sketch.estimate(i64(-1)), u16(11));
+  EXPECT_GE(sketch.estimate(i64(499)), u16(1));
+  EXPECT_NEAR(hll.estimate(), 1000, 100);
+
+  // the same value hashes the same whatever its type
+  count_min<u8> typed(64, 2);
+  typed.add(i128(-3));
+  typed.add(int128(-3));
+  EXPECT_EQ(typed.estimate(i128(-3)), u8(2));
+}
@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "atomic.hh"
+
+using namespace numbers;
+
+TEST(atomicUintegerTest, Basic) {
+  atomic<u32> a;
+  EXPECT_EQ(a.load(), u32(0));
+  a.store(u32(5));
+  EXPECT_EQ(a.exchange(u32(7)), u32(5));
+  EXPECT_EQ(static_cast<u32>(a), u32(7));
+
+  u32 expected = u32(1);
+  EXPECT_FALSE(a.compare_exchange_strong(expected, u32(2)));
+  EXPECT_EQ(expected, u32(7));
+  EXPECT_TRUE(a.compare_exchange_strong(expected, u32(2)));
+  EXPECT_EQ(a.load(), u32(2));
+  EXPECT_TRUE(atomic<u64>::is_always_lock_free);
+}
+
+TEST(atomicUintegerTest, FetchOperations) {
+  atomic<u8> a(u8(250));
+  EXPECT_EQ(a.fetch_checked_add(u8(5)), u8(250));
+  EXPECT_EQ(a.fetch_checked_add(u8(1)), std::nullopt);
+  EXPECT_EQ(a.load(), u8::MAX);
+  EXPECT_THROW(a.fetch_add(u8(1)), std::runtime_error);
+  EXPECT_EQ(a.load(), u8::MAX);
+
+  EXPECT_EQ(a.fetch_saturating_add(u8(10)), u8::MAX);
+  EXPECT_EQ(a.load(), u8::MAX);
+  EXPECT_EQ(a.fetch_wrapping_add(u8(2)), u8::MAX);
+  EXPECT_EQ(a.load(), u8(1));
+
+  EXPECT_EQ(a.fetch_overflowing_sub(u8(2)), std::make_tuple(u8(1), true));
+  EXPECT_EQ(a.load(), u8::MAX);
+  EXPECT_EQ(a.fetch_overflowing_sub(u8(5)), std::make_tuple(u8::MAX, false));
+
+  a.store(u8(3));
+  EXPECT_EQ(a.fetch_saturating_sub(u8(10)), u8(3));
+  EXPECT_EQ(a.load(), u8(0));
+  EXPECT_EQ(a.fetch_checked_sub(u8(1)), std::nullopt);
+  EXPECT_THROW(a.fetch_sub(u8(1)), std::runtime_error);
+  EXPECT_EQ(a.fetch_wrapping_sub(u8(1)), u8(0));
+  EXPECT_EQ(a.load(), u8::MAX);
+}
+
+TEST(atomicUintegerTest, Threads) {
+  constexpr int kThreads = 4;
+  constexpr uint64_t kAdds = 20000;
+  atomic<u64> saturating(u64(u64::MAX - kThreads * kAdds / 2));
+  atomic<u64> checked;
+  atomic<u64> wrapping;
+  atomic<u32> refused;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (uint64_t i = 0; i < kAdds; ++i) {
+        saturating.fetch_saturating_add(u64(1), std::memory_order_relaxed);
+        wrapping.fetch_wrapping_add(u64(3), std::memory_order_relaxed);
+        // only the first kAdds succeed
+        if (!checked.fetch_checked_add(u64(u64::MAX / kAdds), std::memory_order_relaxed)) {
+          refused.fetch_wrapping_add(u32(1), std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(saturating.load(), u64::MAX);
+  EXPECT_EQ(wrapping.load(), u64(3 * kThreads * kAdds));
+  EXPECT_EQ(checked.load(), u64(u64::MAX / kAdds * kAdds));
+  EXPECT_EQ(refused.load(), u32(static_cast<uint32_t>((kThreads - 1) * kAdds)));
+}
+
+TEST(atomicUintegerTest, Wide) {
+  EXPECT_EQ(alignof(atomic<u128>), 16u);
+#if defined(__x86_64__) || defined(_M_X64)
+  EXPECT_TRUE(atomic<u128>::is_always_lock_free);
+#endif
+
+  const u128 big = u128(make_uint128(1, 0));
+  atomic<u128> a(big);
+  EXPECT_EQ(a.load(), big);
+  EXPECT_EQ(a.fetch_wrapping_sub(u128(1)), big);
+  EXPECT_EQ(a.load(), u128(u64::MAX));
+  EXPECT_EQ(a.fetch_checked_add(u128::MAX), std::nullopt);
+  EXPECT_EQ(a.fetch_saturating_add(u128::MAX), u128(u64::MAX));
+  EXPECT_EQ(a.load(), u128::MAX);
+  EXPECT_EQ(a.fetch_overflowing_add(u128(2)), std::make_tuple(u128::MAX, true));
+  EXPECT_EQ(a.exchange(u128(0)), u128(1));
+
+  u128 expected = u128(5);
+  EXPECT_FALSE(a.compare_exchange_weak(expected, big));
+  EXPECT_EQ(expected, u128(0));
+  EXPECT_TRUE(a.compare_exchange_strong(expected, big));
+  a.store(u128::MAX);
+  EXPECT_EQ(a.load(), u128::MAX);
+}
+
+TEST(atomicUintegerTest, WideThreads) {
+  constexpr int kThreads = 4;
+  constexpr uint64_t kAdds = 20000;
+  // every add carries into the high word
+  const u128 step = u128(make_uint128(1, uint64_t{1} << 63));
+  atomic<u128> counter;
+  atomic<u128> tickets(u128(make_uint128(0, ~uint64_t{0} - 10)));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (uint64_t i = 0; i < kAdds; ++i) {
+        counter.fetch_wrapping_add(step);
+        tickets.fetch_saturating_add(u128(1));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter.load(), step * u128(kThreads * kAdds));
+  EXPECT_EQ(tickets.load(), u128(make_uint128(0, ~uint64_t{0} - 10)) + u128(kThreads * kAdds));
+}
+
+TEST(atomicUintegerTest, LockedFallback) {
+  atomic_internal::locked_cell<uint128> cell(make_uint128(1, 2));
+  EXPECT_FALSE(cell.is_lock_free());
+  EXPECT_EQ(cell.fetch_sub(3), make_uint128(1, 2));
+  EXPECT_EQ(cell.load(), make_uint128(0, ~uint64_t{0}));
+  EXPECT_EQ(cell.fetch_add(1), make_uint128(0, ~uint64_t{0}));
+  uint128 expected = 0;
+  EXPECT_FALSE(cell.compare_exchange_strong(expected, 7));
+  EXPECT_EQ(expected, make_uint128(1, 0));
+  EXPECT_TRUE(cell.compare_exchange_strong(expected, 7));
+  EXPECT_EQ(cell.exchange(8), uint128(7));
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 10000; ++i) {
+        cell.fetch_add(make_uint128(1, 1));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(cell.load(), make_uint128(40000, 40008));
+}
@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "cast.hh"
+
+using namespace numbers;
+
+TEST(castUintegerTest, Narrowing) {
+  EXPECT_EQ(checked_cast<u32>(u64(1) << 32), std::nullopt);
+  EXPECT_EQ(checked_cast<u32>(u64(u32::MAX)), u32::MAX);
+  EXPECT_EQ(saturating_cast<u8>(u64::MAX), u8::MAX);
+  EXPECT_EQ(wrapping_cast<u8>(u16(0x1234)), u8(0x34));
+  EXPECT_THROW(try_from<u16>(u32(65536)), std::runtime_error);
+  EXPECT_EQ(checked_cast<u64>(u128(1) << 64), std::nullopt);
+  EXPECT_EQ(saturating_cast<u64>(u128::MAX), u64::MAX);
+  EXPECT_EQ(checked_cast<i8>(u8(128)), std::nullopt);
+  EXPECT_EQ(saturating_cast<i8>(u8(128)), i8::MAX);
+  auto [ret, overflow] = overflowing_cast<u16>(u128::MAX);
+  EXPECT_EQ(ret, u16::MAX);
+  EXPECT_TRUE(overflow);
+}
+
+TEST(castUintegerTest, Widening) {
+  EXPECT_EQ(try_from<u64>(u8::MAX), u64(255));
+  EXPECT_EQ(try_from<u128>(u64::MAX), u128(UINT64_MAX));
+  EXPECT_EQ(try_from<i128>(u64::MAX), i128(UINT64_MAX));
+  EXPECT_EQ(checked_cast<uint128>(u32::MAX), uint128(UINT32_MAX));
+}
+
+TEST(castUintegerTest, Batch) {
+  std::vector<u32> src = {u32(1), u32(70000), u32(65535)};
+  std::vector<u16> dst(src.size());
+  EXPECT_FALSE(checked_cast(src.data(), src.size(), dst.data()));
+  EXPECT_EQ(dst[1], u16::MAX);
+  wrapping_cast(src.data(), src.size(), dst.data());
+  EXPECT_EQ(dst[1], u16(70000 - 65536));
+}
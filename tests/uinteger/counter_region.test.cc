@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "counter_region.hh"
+
+using namespace numbers;
+
+namespace {
+
+// Runs `fn` in `children` forked processes and waits for all of them.
+template <typename F>
+void in_children(int children, F &&fn) {
+  std::vector<pid_t> pids;
+  for (int c = 0; c < children; ++c) {
+    const pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      fn(c);
+      _exit(0);
+    }
+    pids.push_back(pid);
+  }
+  for (const pid_t pid : pids) {
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+}
+
+std::string temp_path(const char *name) {
+  return std::string(testing::TempDir()) + "numbers_" + name + "_" + std::to_string(getpid());
+}
+
+}  // namespace
+
+TEST(counterRegionUintegerTest, Basic) {
+  const counter_region region = counter_region::anonymous(3, 2);
+  EXPECT_EQ(region.u64_slots(), 3);
+  EXPECT_EQ(region.u128_slots(), 2);
+  region.add(0, u64(5));
+  region.add(2, u64::MAX);
+  region.add(2, u64(1));
+  region.add(1, u128::MAX);
+  region.u64_slot(1).fetch_wrapping_add(u64(7));
+  region.u128_slot(0).fetch_wrapping_sub(u128(1));
+
+  u64 u64s[3];
+  u128 u128s[2];
+  region.snapshot(u64s, u128s);
+  EXPECT_EQ(u64s[0], u64(5));
+  EXPECT_EQ(u64s[1], u64(7));
+  EXPECT_EQ(u64s[2], u64::MAX);
+  EXPECT_EQ(u128s[0], u128::MAX);
+  EXPECT_EQ(u128s[1], u128::MAX);
+}
+
+TEST(counterRegionUintegerTest, Fork) {
+  constexpr int kChildren = 4;
+  constexpr uint64_t kAdds = 10000;
+  const counter_region region = counter_region::anonymous(2, 1);
+  region.u64_slot(1).store(u64(u64::MAX - kChildren * kAdds / 2));
+
+  in_children(kChildren, [&](int) {
+    for (uint64_t i = 0; i < kAdds; ++i) {
+      region.add(0, u64(1));
+      region.add(1, u64(1));
+      region.add(0, u128(u64::MAX));
+    }
+  });
+
+  u64 u64s[2];
+  u128 u128s[1];
+  region.snapshot(u64s, u128s);
+  EXPECT_EQ(u64s[0], u64(kChildren * kAdds));
+  EXPECT_EQ(u64s[1], u64::MAX);
+  EXPECT_EQ(u128s[0], u128(kChildren * kAdds) * u128(u64::MAX));
+}
+
+TEST(counterRegionUintegerTest, File) {
+  const std::string path = temp_path("counters");
+  std::remove(path.c_str());
+  {
+    const counter_region region = counter_region::create(path, 4, 1);
+    region.add(3, u64(42));
+  }
+
+  // a separate process opens the file by name
+  in_children(1, [&](int) {
+    const counter_region region = counter_region::open(path);
+    if (region.u64_slots() != 4 || region.u128_slots() != 1 || region.u64_slot(3).load() != u64(42)) {
+      _exit(1);
+    }
+    region.add(0, u128(9));
+  });
+
+  // the counters persist
+  const counter_region region = counter_region::create(path, 4, 1);
+  EXPECT_EQ(region.u64_slot(3).load(), u64(42));
+  EXPECT_EQ(region.u128_slot(0).load(), u128(9));
+
+  EXPECT_THROW(counter_region::create(path, 5, 1), std::runtime_error);
+  EXPECT_THROW(counter_region::open(path + "_missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(counterRegionUintegerTest, BadFile) {
+  const std::string path = temp_path("garbage");
+  std::FILE *f = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(f, nullptr);
+  const std::vector<char> garbage(256, 'x');
+  std::fwrite(garbage.data(), 1, garbage.size(), f);
+  std::fclose(f);
+
+  EXPECT_THROW(counter_region::open(path), std::runtime_error);
+  EXPECT_THROW(counter_region::create(path, 1, 1), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(counterRegionUintegerTest, Move) {
+  counter_region a = counter_region::anonymous(1, 0);
+  a.add(0, u64(3));
+  counter_region b = std::move(a);
+  EXPECT_EQ(b.u64_slot(0).load(), u64(3));
+  a = counter_region::anonymous(2, 0);
+  EXPECT_EQ(a.u64_slots(), 2);
+  b = std::move(a);
+  EXPECT_EQ(b.u64_slots(), 2);
+  EXPECT_EQ(b.u64_slot(1).load(), u64(0));
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "flat_map.hh"
+
+using namespace numbers;
+
+TEST(flatMapUintegerTest, Basic) {
+  flat_map<u64, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(u64(1)), nullptr);
+  EXPECT_FALSE(map.erase(u64(1)));
+
+  EXPECT_TRUE(map.insert(u64(1), 10));
+  EXPECT_FALSE(map.insert(u64(1), 20));
+  EXPECT_EQ(*map.find(u64(1)), 10);
+  map.insert_or_assign(u64(1), 30);
+  EXPECT_EQ(*map.find(u64(1)), 30);
+  map[u64(2)] += 5;
+  EXPECT_EQ(map[u64(2)], 5);
+  EXPECT_EQ(map.size(), 2u);
+  EXPECT_TRUE(map.contains(u64(2)));
+  EXPECT_EQ(map.count(u64(3)), 0u);
+
+  EXPECT_TRUE(map.erase(u64(1)));
+  EXPECT_FALSE(map.contains(u64(1)));
+  EXPECT_EQ(map.size(), 1u);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(u64(2)));
+}
+
+TEST(flatMapUintegerTest, AgainstUnorderedMap) {
+  std::mt19937_64 engine(7);
+  flat_map<u128, uint64_t> map;
+  std::unordered_map<u128, uint64_t> expected;
+  for (int i = 0; i < 200000; ++i) {
+    // a small key space, so that inserts, hits and erases all happen often
+    const uint64_t x = engine() % 5000;
+    const u128 key = u128(make_uint128(x, 2 * x));
+    switch (engine() % 3) {
+      case 0:
+        EXPECT_EQ(map.insert(key, x), expected.emplace(key, x).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), expected.erase(key) == 1);
+        break;
+      default: {
+        const auto it = expected.find(key);
+        const uint64_t *value = map.find(key);
+        ASSERT_EQ(value != nullptr, it != expected.end());
+        if (value) {
+          EXPECT_EQ(*value, it->second);
+        }
+      }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+  }
+
+  size_t visited = 0;
+  map.for_each([&](const u128 &key, uint64_t value) {
+    EXPECT_EQ(expected.at(key), value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, expected.size());
+}
+
+TEST(flatMapUintegerTest, Grow) {
+  flat_map<uint32_t, uint32_t> map(10);
+  const size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 10u);
+  for (uint32_t i = 0; i < 100000; ++i) {
+    map[i] = i * 3;
+  }
+  EXPECT_EQ(map.size(), 100000u);
+  EXPECT_GT(map.capacity(), capacity);
+  for (uint32_t i = 0; i < 100000; ++i) {
+    ASSERT_EQ(*map.find(i), i * 3);
+  }
+
+  // erasing and inserting in turn reuses the room instead of growing without bound
+  const size_t grown = map.capacity();
+  for (uint32_t i = 0; i < 1000000; ++i) {
+    map.erase(i);
+    map[i + 100000] = i;
+  }
+  EXPECT_EQ(map.size(), 100000u);
+  EXPECT_LE(map.capacity(), grown * 2);
+}
+
+TEST(flatMapUintegerTest, Bulk) {
+  std::vector<u64> keys;
+  std::vector<u32> values;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    keys.push_back(u64(i * 7919));
+    values.push_back(u32(static_cast<uint32_t>(i)));
+  }
+  keys.push_back(keys.front());
+  values.push_back(u32(12345));
+
+  flat_map<u64, u32> map;
+  EXPECT_EQ(map.insert(keys.data(), values.data(), keys.size()), 1000u);
+  EXPECT_EQ(map.size(), 1000u);
+  EXPECT_EQ(*map.find(keys.front()), u32(0));
+
+  std::vector<u64> queries = {u64(0), u64(1), u64(7919 * 999), u64(7919 * 1000)};
+  std::vector<u32> found(queries.size());
+  EXPECT_EQ(map.find(queries.data(), queries.size(), found.data(), u32::MAX), 2u);
+  EXPECT_EQ(found, (std::vector<u32>{u32(0), u32::MAX, u32(999), u32::MAX}));
+}
+
+TEST(flatSetUintegerTest, Basic) {
+  flat_set<uint128> set;
+  EXPECT_TRUE(set.insert(uint128_max()));
+  EXPECT_FALSE(set.insert(uint128_max()));
+  EXPECT_TRUE(set.insert(0));
+  EXPECT_TRUE(set.contains(uint128_max()));
+  EXPECT_FALSE(set.contains(1));
+  EXPECT_TRUE(set.erase(0));
+  EXPECT_EQ(set.size(), 1u);
+
+  std::vector<uint128> keys;
+  for (uint64_t i = 0; i < 300; ++i) {
+    keys.push_back(make_uint128(i, i));
+  }
+  EXPECT_EQ(set.insert(keys.data(), keys.size()), 300u);
+  EXPECT_EQ(set.insert(keys.data(), keys.size()), 0u);
+
+  keys.push_back(make_uint128(1, 0));
+  std::unique_ptr<bool[]> found(new bool[keys.size()]);
+  EXPECT_EQ(set.contains(keys.data(), keys.size(), found.get()), 300u);
+  EXPECT_TRUE(found[0]);
+  EXPECT_FALSE(found[300]);
+
+  std::unordered_set<uint128> visited;
+  set.for_each([&](const uint128 &key) { visited.insert(key); });
+  EXPECT_EQ(visited.size(), set.size());
+}
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+
+#include "floating.hh"
+
+using namespace numbers;
+
+TEST(floatingUintegerTest, FromFloat) {
+  EXPECT_EQ(checked_from_float<u8>(-0.9), u8(0));
+  EXPECT_EQ(checked_from_float<u8>(-1.0), std::nullopt);
+  EXPECT_EQ(checked_from_float<u8>(255.9f), u8::MAX);
+  EXPECT_EQ(checked_from_float<u64>(18446744073709551616.0), std::nullopt);
+  EXPECT_EQ(checked_from_float<u64>(18446744073709549568.0), u64(18446744073709549568ull));
+  EXPECT_EQ(checked_from_float<u128>(std::ldexp(1.0, 128)), std::nullopt);
+  EXPECT_EQ(checked_from_float<u128>(std::ldexp(1.0, 100)), u128(1) << 100);
+  EXPECT_EQ(checked_from_float<u128>(std::numeric_limits<float>::max()), u128(std::numeric_limits<float>::max()));
+
+  EXPECT_EQ(saturating_from_float<u16>(-5.0), u16(0));
+  EXPECT_EQ(saturating_from_float<u16>(1e9f), u16::MAX);
+  EXPECT_EQ(saturating_from_float<u128>(1e300), u128::MAX);
+  EXPECT_EQ(saturating_from_float<u128>(std::numeric_limits<double>::quiet_NaN()), u128(0));
+  EXPECT_EQ(u32(-3.5), u32(0));
+  EXPECT_EQ(u64(1e30), u64::MAX);
+}
+
+TEST(floatingUintegerTest, ToFloat) {
+  EXPECT_EQ(to_double(u128::MAX), std::ldexp(1.0, 128));
+  EXPECT_EQ(to_float(u128::MAX), std::numeric_limits<float>::infinity());
+  EXPECT_EQ(to_double(u64::MAX), std::ldexp(1.0, 64));
+  // 2^64 + 2^11 is a tie between 2^64 and 2^64 + 2^12, and rounds to even
+  EXPECT_EQ(to_double(make_uint128(1, 2048)), std::ldexp(1.0, 64));
+  EXPECT_EQ(to_double(make_uint128(1, 2049)), std::ldexp(1.0, 64) + 4096);
+  EXPECT_EQ(to_double(make_uint128(1, 6144)), std::ldexp(1.0, 64) + 8192);
+  EXPECT_EQ(to_double(make_uint128(0x468de09d224fea, 0x133bb4c2baaad651)), 0x1.1a378274893fbp+118);
+}
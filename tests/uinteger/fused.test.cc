@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+
+#include "fused.hh"
+
+using namespace numbers;
+
+typedef ::testing::Types<u8, u16, u32, u64, u128> Uintegers;
+
+template <typename T>
+class fusedUintegerTest : public ::testing::Test {};
+
+TYPED_TEST_SUITE(fusedUintegerTest, Uintegers);
+
+TYPED_TEST(fusedUintegerTest, MulAdd) {
+  TypeParam max = TypeParam::MAX;
+  EXPECT_EQ(mul_add(TypeParam(3), 4, 5), TypeParam(17));
+  EXPECT_EQ(mul_add(max, 1, 0), max);
+  EXPECT_EQ(checked_mul_add(max, max, max), std::nullopt);
+  EXPECT_EQ(checked_mul_add(max, 1, 1), std::nullopt);
+  EXPECT_EQ(saturating_mul_add(max, max, max), max);
+  EXPECT_EQ(wrapping_mul_add(max, 1, 1), TypeParam(0));
+  EXPECT_EQ(wrapping_mul_add(max, max, 0), TypeParam(1));
+  EXPECT_TRUE(std::get<1>(overflowing_mul_add(max, 2, 0)));
+  EXPECT_THROW(mul_add(max, 2, 0), std::runtime_error);
+}
+
+TYPED_TEST(fusedUintegerTest, MulSub) {
+  TypeParam max = TypeParam::MAX;
+  EXPECT_EQ(mul_sub(TypeParam(3), 4, 5), TypeParam(7));
+  // max * 2 overflows on its own, the fused result does not
+  EXPECT_EQ(mul_sub(max, 2, max), max);
+  EXPECT_EQ(checked_mul_sub(TypeParam(1), 1, 2), std::nullopt);
+  EXPECT_EQ(saturating_mul_sub(TypeParam(1), 1, 2), TypeParam(0));
+  EXPECT_EQ(saturating_mul_sub(max, max, 1), max);
+  EXPECT_EQ(wrapping_mul_sub(TypeParam(1), 1, 2), max);
+  auto [ret, overflow] = overflowing_mul_sub(TypeParam(0), 0, 1);
+  EXPECT_EQ(ret, max);
+  EXPECT_TRUE(overflow);
+  EXPECT_THROW(mul_sub(TypeParam(0), 0, 1), std::runtime_error);
+}
+
+TYPED_TEST(fusedUintegerTest, Dot2) {
+  TypeParam max = TypeParam::MAX;
+  EXPECT_EQ(dot2(TypeParam(3), 4, 5, 6), TypeParam(42));
+  EXPECT_EQ(dot2(max, 1, 0, 0), max);
+  // max * max + max * max leaves the wide type
+  EXPECT_EQ(checked_dot2(max, max, max, max), std::nullopt);
+  EXPECT_EQ(saturating_dot2(max, max, max, max), max);
+  EXPECT_EQ(wrapping_dot2(max, max, max, max), TypeParam(2));
+  EXPECT_TRUE(std::get<1>(overflowing_dot2(max, 1, 1, 1)));
+  EXPECT_THROW(dot2(max, 1, 1, 1), std::runtime_error);
+}
+
+TYPED_TEST(fusedUintegerTest, Sum3) {
+  TypeParam max = TypeParam::MAX;
+  EXPECT_EQ(sum3(TypeParam(1), 2, 3), TypeParam(6));
+  EXPECT_EQ(checked_sum3(max, max, max), std::nullopt);
+  EXPECT_EQ(saturating_sum3(max, 1, 0), max);
+  EXPECT_EQ(wrapping_sum3(max, max, max), max.wrapping_mul(3));
+  EXPECT_FALSE(std::get<1>(overflowing_sum3(max, 0, 0)));
+  EXPECT_THROW(sum3(max, 0, 1), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "hash.hh"
+
+using namespace numbers;
+
+TEST(hashUintegerTest, MatchesStdHash) {
+  if constexpr (sizeof(size_t) == sizeof(uint64_t)) {
+    EXPECT_EQ(std::hash<u8>()(u8(7)), numbers::hash(u8(7)));
+    EXPECT_EQ(std::hash<u32>()(u32(7)), numbers::hash(u32(7)));
+    EXPECT_EQ(std::hash<u64>()(u64::MAX), numbers::hash(u64::MAX));
+    EXPECT_EQ(std::hash<u128>()(u128::MAX), numbers::hash(u128::MAX));
+    EXPECT_EQ(std::hash<uint128>()(make_uint128(3, 4)), numbers::hash(u128(make_uint128(3, 4))));
+  }
+  EXPECT_EQ(numbers::hash(u64(42)), numbers::hash(uint64_t{42}));
+}
+
+TEST(hashUintegerTest, Mum) {
+  const uint64_t values[] = {0, 1, 0xffffffff, 0x100000000, 0x8bb84b93962eacc9ull, ~uint64_t{0}};
+  for (uint64_t x : values) {
+    for (uint64_t y : values) {
+      uint64_t lo = x;
+      uint64_t hi = y;
+      numbers_internal::hash_mum(lo, hi);
+      EXPECT_EQ(make_uint128(hi, lo), uint128(x) * uint128(y));
+    }
+  }
+}
+
+TEST(hashUintegerTest, StructuredKeys) {
+  // (hi << 1) ^ lo used to be 0 for every one of these keys
+  constexpr uint64_t kKeys = 1 << 16;
+  std::unordered_set<uint64_t> hashes;
+  std::unordered_set<uint64_t> buckets;
+  for (uint64_t x = 0; x < kKeys; ++x) {
+    const uint64_t h = numbers::hash(u128(make_uint128(x, 2 * x)));
+    hashes.insert(h);
+    buckets.insert(h & (kKeys - 1));
+  }
+  EXPECT_EQ(hashes.size(), kKeys);
+  // throwing 2^16 keys into 2^16 buckets at random fills about 63% of them
+  EXPECT_GT(buckets.size(), kKeys * 6 / 10);
+
+  // sequential narrow keys spread over the low bits as well
+  buckets.clear();
+  for (uint64_t x = 0; x < kKeys; ++x) {
+    buckets.insert(std::hash<u32>()(u32(static_cast<uint32_t>(x << 8))) & 0xff);
+  }
+  EXPECT_EQ(buckets.size(), 256u);
+}
+
+TEST(hashUintegerTest, Seeded) {
+  EXPECT_EQ(numbers::hash(u128(9), 1), numbers::hash(u128(9), 1));
+  EXPECT_NE(numbers::hash(u128(9), 1), numbers::hash(u128(9), 2));
+  EXPECT_NE(numbers::hash(u16(9), 0), numbers::hash(u16(9)));
+
+  seeded_hash<u128> hasher(5);
+  EXPECT_EQ(hasher(u128(9)), static_cast<size_t>(numbers::hash(u128(9), 5)));
+
+  std::unordered_set<u128, seeded_hash<u128>> set(16, seeded_hash<u128>(123));
+  for (uint64_t x = 0; x < 1000; ++x) {
+    set.insert(u128(make_uint128(x, x)));
+  }
+  EXPECT_EQ(set.size(), 1000u);
+  EXPECT_EQ(set.count(u128(make_uint128(999, 999))), 1u);
+}
+
+TEST(hashUintegerTest, Batch) {
+  std::vector<u128> keys;
+  for (uint64_t x = 0; x < 37; ++x) {
+    keys.push_back(u128(make_uint128(x * 31, ~x)));
+  }
+  std::vector<uint64_t> hashes(keys.size());
+
+  numbers::hash(keys.data(), keys.size(), hashes.data());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(hashes[i], numbers::hash(keys[i]));
+  }
+
+  numbers::hash(keys.data(), keys.size(), hashes.data(), 77);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(hashes[i], numbers::hash(keys[i], 77));
+  }
+}
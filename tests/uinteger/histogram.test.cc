@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "histogram.hh"
+
+using namespace numbers;
+
+TEST(histogramUintegerTest, Buckets) {
+  const histogram h(3);
+  EXPECT_EQ(h.buckets(), size_t{62 * 8});
+  // exact up to 2^(precision + 1)
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(h.bucket_lowest(i), u64(i));
+    EXPECT_EQ(h.bucket_highest(i), u64(i));
+  }
+  // then 8 sub-buckets per power of two
+  EXPECT_EQ(h.bucket_lowest(16), u64(16));
+  EXPECT_EQ(h.bucket_highest(16), u64(17));
+  EXPECT_EQ(h.bucket_lowest(24), u64(32));
+  EXPECT_EQ(h.bucket_highest(24), u64(35));
+  EXPECT_EQ(h.bucket_highest(h.buckets() - 1), u64::MAX);
+  for (size_t i = 0; i + 1 < h.buckets(); ++i) {
+    EXPECT_EQ(static_cast<uint64_t>(h.bucket_highest(i)) + 1, static_cast<uint64_t>(h.bucket_lowest(i + 1)));
+  }
+
+  EXPECT_THROW(histogram(0), std::runtime_error);
+  EXPECT_THROW(histogram(histogram::kMaxPrecision + 1), std::runtime_error);
+}
+
+TEST(histogramUintegerTest, Record) {
+  histogram h;
+  EXPECT_EQ(h.count(), i128(0));
+  EXPECT_EQ(h.min(), u64(0));
+  EXPECT_EQ(h.percentile(50), u64(0));
+
+  for (uint64_t v = 1; v <= 1000; ++v) {
+    h.record(u64(v));
+  }
+  EXPECT_EQ(h.count(), i128(1000));
+  EXPECT_EQ(h.sum(), i128(500500));
+  EXPECT_DOUBLE_EQ(h.mean(), 500.5);
+  EXPECT_EQ(h.min(), u64(1));
+  EXPECT_EQ(h.max(), u64(1000));
+  EXPECT_EQ(h.percentile(0), u64(1));
+  EXPECT_EQ(h.percentile(100), u64(1000));
+  // within 1/2^7 of the exact value
+  for (const double p : {10.0, 50.0, 90.0, 99.0, 99.9}) {
+    const double exact = p * 10;
+    const double got = static_cast<double>(static_cast<uint64_t>(h.percentile(p)));
+    EXPECT_GE(got, exact);
+    EXPECT_LE(got, exact * (1 + 1.0 / 128));
+  }
+
+  h.record(u64::MAX, u64(3));
+  EXPECT_EQ(h.count(), i128(1003));
+  EXPECT_EQ(h.sum(), i128(500500) + i128(3) * i128(static_cast<uint64_t>(u64::MAX)));
+  EXPECT_EQ(h.percentile(100), u64::MAX);
+
+  h.reset();
+  EXPECT_EQ(h.count(), i128(0));
+  EXPECT_EQ(h.max(), u64(0));
+}
+
+TEST(histogramUintegerTest, Saturation) {
+  histogram h;
+  h.record(u64(5), u64::MAX);
+  h.record(u64(5), u64::MAX);
+  h.record(u64(7));
+  EXPECT_EQ(h.bucket_count(5), u64::MAX);
+  EXPECT_EQ(h.count(), i128(static_cast<uint64_t>(u64::MAX)) * i128(2) + i128(1));
+  EXPECT_EQ(h.percentile(100), u64(7));
+}
+
+TEST(histogramUintegerTest, Merge) {
+  histogram a;
+  histogram b;
+  a.record(u64(10));
+  b.record(u64(1000), u64(3));
+  b.record(u64(2));
+  a.merge(b);
+  EXPECT_EQ(a.count(), i128(5));
+  EXPECT_EQ(a.sum(), i128(3012));
+  EXPECT_EQ(a.min(), u64(2));
+  EXPECT_EQ(a.max(), u64(1000));
+  EXPECT_EQ(a.percentile(40), u64(10));
+
+  histogram c(5);
+  EXPECT_THROW(a.merge(c), std::runtime_error);
+}
+
+TEST(histogramUintegerTest, MergeWhileRecording) {
+  constexpr uint64_t kValues = 200000;
+  histogram live;
+  std::atomic<bool> done{false};
+  std::thread writer([&] {
+    for (uint64_t v = 1; v <= kValues; ++v) {
+      live.record(u64(v));
+    }
+    done.store(true);
+  });
+
+  // The values come in order, so the totals of one record are count = max = n
+  // and sum = n(n + 1)/2; a torn read would break that.
+  bool finished = false;
+  while (!finished) {
+    finished = done.load();
+    histogram merged;
+    merged.merge(live);
+    const i128 n = merged.count();
+    EXPECT_LE(n, i128(kValues));
+    EXPECT_EQ(merged.sum(), n * (n + i128(1)) / i128(2));
+    EXPECT_EQ(merged.max(), u64(static_cast<uint64_t>(static_cast<int128>(n))));
+    EXPECT_EQ(merged.min(), n == i128(0) ? u64(0) : u64(1));
+    i128 buckets(0);
+    for (size_t i = 0; i < merged.buckets(); ++i) {
+      buckets += i128(static_cast<uint64_t>(merged.bucket_count(i)));
+    }
+    EXPECT_GE(buckets, n);
+    const u64 p50 = live.percentile(50);
+    EXPECT_LE(p50, u64(kValues));
+  }
+  writer.join();
+
+  const histogram copy(live);
+  EXPECT_EQ(copy.count(), i128(kValues));
+  EXPECT_EQ(copy.sum(), i128(kValues) * i128(kValues + 1) / i128(2));
+  EXPECT_EQ(copy.percentile(100), u64(kValues));
+}
+
+TEST(histogramUintegerTest, Serialize) {
+  histogram h(5);
+  h.record(u64(3));
+  h.record(u64(123456789), u64(42));
+  h.record(u64::MAX);
+  const std::vector<uint8_t> bytes = h.serialize();
+  EXPECT_LT(bytes.size(), size_t{64});
+
+  const histogram back = histogram::deserialize(bytes.data(), bytes.size());
+  EXPECT_EQ(back.precision(), 5);
+  EXPECT_EQ(back.count(), h.count());
+  EXPECT_EQ(back.sum(), h.sum());
+  EXPECT_EQ(back.min(), h.min());
+  EXPECT_EQ(back.max(), h.max());
+  for (size_t i = 0; i < h.buckets(); ++i) {
+    EXPECT_EQ(back.bucket_count(i), h.bucket_count(i));
+  }
+
+  const histogram empty = histogram::deserialize(histogram().serialize().data(), histogram().serialize().size());
+  EXPECT_EQ(empty.count(), i128(0));
+
+  EXPECT_THROW(histogram::deserialize(bytes.data(), 1), std::runtime_error);
+  EXPECT_THROW(histogram::deserialize(bytes.data(), bytes.size() - 1), std::runtime_error);
+  std::vector<uint8_t> bad = bytes;
+  bad[1] = 0;
+  EXPECT_THROW(histogram::deserialize(bad.data(), bad.size()), std::runtime_error);
+  bad = bytes;
+  bad.push_back(0xff);
+  bad.push_back(0x7f);
+  bad.push_back(1);
+  EXPECT_THROW(histogram::deserialize(bad.data(), bad.size()), std::runtime_error);
+}
@@ -0,0 +1,36 @@
+#include "gtest/gtest.h"
+
+#include "mixed.hh"
+
+using namespace numbers;
+
+TEST(mixedUintegerTest, RawOperand) {
+  EXPECT_EQ(0 + u64::MAX, u64::MAX);
+  EXPECT_EQ(-1 + u8(3), u8(2));
+  EXPECT_EQ(300 - u8(100), u8(200));
+  EXPECT_EQ(3 * u8(5), u8(15));
+  EXPECT_THROW(256 + u8(0), std::runtime_error);
+  EXPECT_THROW(-1 + u8(0), std::runtime_error);
+  EXPECT_THROW(-1 * u8(1), std::runtime_error);
+  EXPECT_EQ(-1 * u8(0), u8(0));
+  EXPECT_EQ(1000 / u8(10), u8(100));
+  EXPECT_EQ(-1 / u8(10), u8(0));
+  EXPECT_THROW(-10 / u8(1), std::runtime_error);
+  EXPECT_EQ(1001 % u8(10), u8(1));
+
+  EXPECT_TRUE(-1 < u8(0));
+  EXPECT_TRUE(256 > u8::MAX);
+  EXPECT_FALSE(-1 == u32::MAX);
+  EXPECT_TRUE(uint64_t{1} << 40 >= u32::MAX);
+}
+
+TEST(mixedUintegerTest, Mixed) {
+  EXPECT_EQ(u8(200) + u16(100), u16(300));
+  EXPECT_EQ(checked_add(u64::MAX, u8(1)), std::nullopt);
+  EXPECT_EQ(saturating_add(u64::MAX, u8(1)), u64::MAX);
+  EXPECT_EQ(saturating_sub(u8(0), u128(1)), u128(0));
+  EXPECT_EQ(checked_mul(u128(1) << 64, u64(1) << 63), u128(1) << 127);
+  EXPECT_EQ(checked_mul(u128(1) << 65, u64::MAX), std::nullopt);
+  EXPECT_EQ(saturating_mul(u128::MAX, u8(2)), u128::MAX);
+  EXPECT_EQ(wrapping_mul(u128::MAX, u8(2)), u128::MAX - u128(1));
+}
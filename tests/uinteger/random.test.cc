@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "random.hh"
+
+using namespace numbers;
+
+TEST(randomUintegerTest, Pcg64ReferenceSequence) {
+  // pcg64 of the PCG reference implementation seeded with (42, 54)
+  pcg64 engine(42, 54);
+  const uint64_t expected[] = {0x86b1da1d72062b68ull, 0x1304aa46c9853d39ull, 0xa3670e9e0dd50358ull,
+                               0xf9090e529a7dae00ull, 0xc85b9fd837996f2cull, 0x606121f8e3919196ull};
+  for (uint64_t value : expected) {
+    EXPECT_EQ(engine(), value);
+  }
+}
+
+TEST(randomUintegerTest, Pcg64Discard) {
+  pcg64 a(7);
+  pcg64 b(7);
+  for (int i = 0; i < 1000; ++i) {
+    a();
+  }
+  b.discard(1000);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a(), b());
+  EXPECT_NE(a, pcg64(7));
+
+  pcg64 c;
+  pcg64 d;
+  c.discard(0);
+  EXPECT_EQ(c, d);
+}
+
+TEST(randomUintegerTest, Xoshiro) {
+  xoshiro256ss engine(1, 2, 3, 4);
+  // rotl(2 * 5, 7) * 9
+  EXPECT_EQ(engine(), 11520u);
+  EXPECT_EQ(engine(), 0u);
+
+  xoshiro256ss a(99);
+  xoshiro256ss b(99);
+  EXPECT_EQ(a, b);
+  b.jump();
+  EXPECT_NE(a, b);
+  a.discard(3);
+  xoshiro256ss c(99);
+  c();
+  c();
+  c();
+  EXPECT_EQ(a, c);
+}
+
+TEST(randomUintegerTest, StandardDistributions) {
+  pcg64 engine(3);
+  std::uniform_int_distribution<int> dist(1, 6);
+  for (int i = 0; i < 1000; ++i) {
+    const int v = dist(engine);
+    ASSERT_GE(v, 1);
+    ASSERT_LE(v, 6);
+  }
+  std::vector<int> values = {1, 2, 3, 4, 5};
+  std::shuffle(values.begin(), values.end(), engine);
+  EXPECT_EQ(std::count(values.begin(), values.end(), 3), 1);
+}
+
+TEST(randomUintegerTest, UniformBounds) {
+  xoshiro256ss engine(5);
+  std::array<int, 7> histogram{};
+  for (int i = 0; i < 70000; ++i) {
+    const u8 v = uniform(engine, u8(3), u8(9));
+    ASSERT_GE(v, u8(3));
+    ASSERT_LE(v, u8(9));
+    ++histogram[static_cast<uint8_t>(v) - 3];
+  }
+  for (int count : histogram) {
+    // 10000 expected, the standard deviation is about 93
+    EXPECT_GT(count, 9500);
+    EXPECT_LT(count, 10500);
+  }
+
+  EXPECT_EQ(uniform(engine, u64(17), u64(17)), u64(17));
+  EXPECT_EQ(uniform(engine, u128::MAX, u128::MAX), u128::MAX);
+  EXPECT_THROW(uniform(engine, u32(2), u32(1)), std::runtime_error);
+
+  // a range of 3 * 2^62 values: taking a random u64 modulo it would put 5/8 of the results in the lower half
+  const u64 last = u64(3 * (uint64_t{1} << 62) - 1);
+  const u64 middle = u64(3 * (uint64_t{1} << 61));
+  int low = 0;
+  for (int i = 0; i < 10000; ++i) {
+    const u64 v = uniform(engine, u64(0), last);
+    ASSERT_LE(v, last);
+    low += v < middle;
+  }
+  EXPECT_GT(low, 4700);
+  EXPECT_LT(low, 5300);
+}
+
+TEST(randomUintegerTest, Uniform128) {
+  pcg64 engine(11);
+  const u128 hi = u128(make_uint128(3, 0));
+  bool above_64 = false;
+  for (int i = 0; i < 1000; ++i) {
+    const u128 v = uniform(engine, u128(0), hi);
+    ASSERT_LE(v, hi);
+    above_64 |= v > u128(u64::MAX);
+  }
+  EXPECT_TRUE(above_64);
+
+  // uniform<T>(engine) draws the full range
+  const uint128 full = uniform<uint128>(engine);
+  EXPECT_NE(uint128_high64(full), 0u);
+}
+
+TEST(randomUintegerTest, Fill) {
+  pcg64 engine(13);
+  pcg64 copy = engine;
+  std::vector<u32> values(100);
+  fill_uniform(engine, values.data(), values.size(), u32(10), u32(20));
+  for (size_t i = 0; i < values.size(); ++i) {
+    // the bulk variant draws the same values as the scalar one
+    EXPECT_EQ(values[i], uniform(copy, u32(10), u32(20)));
+  }
+  EXPECT_EQ(engine, copy);
+
+  std::vector<u128> wide(10);
+  fill(engine, wide.data(), wide.size());
+  for (const u128 &v : wide) {
+    EXPECT_EQ(v, uniform<u128>(copy));
+  }
+}
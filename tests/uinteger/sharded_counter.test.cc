@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "sharded_counter.hh"
+
+using namespace numbers;
+
+TEST(shardedCounterUintegerTest, Basic) {
+  sharded_counter<u64> counter(3);
+  EXPECT_EQ(counter.shards(), 4);
+  EXPECT_EQ(counter.load(), u64(0));
+  counter.add(u64(5));
+  counter.add(u64(7));
+  EXPECT_EQ(counter.load(), u64(12));
+  EXPECT_EQ(counter.checked_load(), u64(12));
+  EXPECT_EQ(counter.load_as<u128>(), u128(12));
+  counter.reset();
+  EXPECT_EQ(counter.load(), u64(0));
+
+  sharded_counter<u64> single(1);
+  EXPECT_EQ(single.shards(), 1);
+  sharded_counter<u64> per_thread;
+  EXPECT_GE(per_thread.shards(), 1);
+}
+
+TEST(shardedCounterUintegerTest, Saturation) {
+  sharded_counter<u8> counter(1);
+  counter.add(u8(200));
+  counter.add(u8(100));
+  EXPECT_EQ(counter.load(), u8::MAX);
+  EXPECT_EQ(counter.checked_load(), u8::MAX);
+  EXPECT_EQ(counter.load_as<u16>(), u16(255));
+}
+
+TEST(shardedCounterUintegerTest, LoadAsSigned) {
+  sharded_counter<u64> counter(1);
+  counter.add(u64::MAX);
+  EXPECT_EQ(counter.load_as<u128>(), u128(u64::MAX));
+  EXPECT_EQ(counter.load_as<i128>(), i128(static_cast<uint64_t>(u64::MAX)));
+
+  // i64 would read u64::MAX as -1, and does not compile
+  static_assert(!sharded_internal::holds_all_v<i64, u64>);
+  static_assert(sharded_internal::holds_all_v<i128, u64>);
+  static_assert(sharded_internal::holds_all_v<u64, u64>);
+}
+
+TEST(shardedCounterUintegerTest, Threads) {
+  constexpr int kThreads = 8;
+  constexpr uint64_t kAdds = 20000;
+  sharded_counter<u64> counter(4);
+  sharded_counter<u32> narrow(kThreads);
+  sharded_counter<u64> large(kThreads);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&] {
+      for (uint64_t i = 0; i < kAdds; ++i) {
+        counter.add(u64(1));
+      }
+      narrow.add(u32(u32::MAX / 4));
+      large.add(u64::MAX);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(counter.load(), u64(kThreads * kAdds));
+  EXPECT_EQ(counter.checked_load(), u64(kThreads * kAdds));
+
+  // each thread landed on its own shard, so no shard saturated, but the sum does not fit
+  EXPECT_EQ(narrow.load(), u32::MAX);
+  EXPECT_EQ(narrow.checked_load(), std::nullopt);
+  EXPECT_EQ(narrow.load_as<u64>(), u64(kThreads * uint64_t{u32::MAX / 4}));
+  EXPECT_EQ(large.load_as<u128>(), u128(kThreads) * u128(u64::MAX));
+}
@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "sketch.hh"
+
+using namespace numbers;
+
+TEST(sketchUintegerTest, CountMin) {
+  count_min<u32> sketch(1000, 4);
+  EXPECT_EQ(sketch.width(), 1024);
+  EXPECT_EQ(sketch.depth(), 4);
+  EXPECT_EQ(sketch.estimate(u64(1)), u32(0));
+
+  for (uint64_t k = 0; k < 2000; ++k) {
+    sketch.add(u64(k), u32(k % 10 + 1));
+  }
+  sketch.add(u64(7), u32(1000));
+  // never below the true count
+  for (uint64_t k = 0; k < 2000; ++k) {
+    EXPECT_GE(sketch.estimate(u64(k)), u32(k % 10 + 1 + (k == 7 ? 1000 : 0)));
+  }
+  EXPECT_LT(sketch.estimate(u64(7)), u32(1100));
+
+  sketch.reset();
+  EXPECT_EQ(sketch.estimate(u64(7)), u32(0));
+  EXPECT_THROW(count_min<u8>(0, 4), std::runtime_error);
+  EXPECT_THROW(count_min<u8>(16, 0), std::runtime_error);
+}
+
+TEST(sketchUintegerTest, CountMinSaturates) {
+  count_min<u8> narrow(64, 2);
+  for (int i = 0; i < 300; ++i) {
+    narrow.add(u128(42));
+  }
+  EXPECT_EQ(narrow.estimate(u128(42)), u8::MAX);
+  narrow.add_conservative(u128(42), u8(10));
+  EXPECT_EQ(narrow.estimate(u128(42)), u8::MAX);
+
+  count_min<u16> wide(1, 1);
+  wide.add(u16(1), u16(60000));
+  wide.add(u16(2), u16(60000));
+  EXPECT_EQ(wide.estimate(u16(3)), u16::MAX);
+}
+
+TEST(sketchUintegerTest, CountMinConservative) {
+  count_min<u16> plain(64, 4, 1);
+  count_min<u16> conservative(64, 4, 1);
+  std::vector<u64> keys;
+  for (uint64_t k = 0; k < 500; ++k) {
+    keys.push_back(u64(k % 100));
+  }
+  for (const u64 key : keys) {
+    plain.add(key);
+  }
+  conservative.add_conservative(keys.data(), keys.size());
+
+  uint64_t plain_error = 0;
+  uint64_t conservative_error = 0;
+  for (uint64_t k = 0; k < 100; ++k) {
+    EXPECT_GE(conservative.estimate(u64(k)), u16(5));
+    EXPECT_LE(conservative.estimate(u64(k)), plain.estimate(u64(k)));
+    plain_error += static_cast<uint16_t>(plain.estimate(u64(k))) - 5;
+    conservative_error += static_cast<uint16_t>(conservative.estimate(u64(k))) - 5;
+  }
+  EXPECT_LT(conservative_error, plain_error);
+}
+
+TEST(sketchUintegerTest, CountMinBatchAndMerge) {
+  std::vector<u32> keys;
+  for (uint32_t k = 0; k < 100; ++k) {
+    keys.push_back(u32(k * 7919));
+  }
+  count_min<u32> batch(256, 3, 9);
+  count_min<u32> single(256, 3, 9);
+  batch.add(keys.data(), keys.size(), u32(2));
+  for (const u32 key : keys) {
+    single.add(key, u32(2));
+  }
+  for (const u32 key : keys) {
+    EXPECT_EQ(batch.estimate(key), single.estimate(key));
+  }
+
+  batch.merge(single);
+  for (const u32 key : keys) {
+    EXPECT_EQ(batch.estimate(key), single.estimate(key) * u32(2));
+  }
+
+  count_min<u32> big(256, 3, 9);
+  big.add(keys[0], u32::MAX - 1);
+  big.merge(single);
+  EXPECT_EQ(big.estimate(keys[0]), u32::MAX);
+
+  count_min<u8> bytes(256, 3);
+  count_min<u8> other(256, 3);
+  bytes.add(u8(1), u8(200));
+  other.add(u8(1), u8(100));
+  bytes.merge(other);
+  EXPECT_EQ(bytes.estimate(u8(1)), u8::MAX);
+
+  EXPECT_THROW(batch.merge(count_min<u32>(256, 3, 10)), std::runtime_error);
+  EXPECT_THROW(batch.merge(count_min<u32>(128, 3, 9)), std::runtime_error);
+}
+
+TEST(sketchUintegerTest, HyperLogLog) {
+  hyperloglog hll;
+  EXPECT_EQ(hll.precision(), 12);
+  EXPECT_EQ(hll.estimate(), 0);
+
+  for (uint64_t k = 0; k < 100; ++k) {
+    hll.add(u64(k));
+    hll.add(u64(k));
+  }
+  EXPECT_NEAR(hll.estimate(), 100, 5);
+
+  std::vector<u64> keys;
+  for (uint64_t k = 0; k < 100000; ++k) {
+    keys.push_back(u64(k));
+  }
+  hll.add(keys.data(), keys.size());
+  // 1.04 / sqrt(4096) is about 1.6%
+  EXPECT_NEAR(hll.estimate(), 100000, 5000);
+
+  hyperloglog other;
+  for (uint64_t k = 100000; k < 200000; ++k) {
+    other.add(u64(k));
+  }
+  hll.merge(other);
+  EXPECT_NEAR(hll.estimate(), 200000, 10000);
+
+  hll.reset();
+  EXPECT_EQ(hll.estimate(), 0);
+  EXPECT_THROW(hll.merge(hyperloglog(10)), std::runtime_error);
+  EXPECT_THROW(hll.merge(hyperloglog(12, 1)), std::runtime_error);
+  EXPECT_THROW(hyperloglog(3), std::runtime_error);
+  EXPECT_THROW(hyperloglog(19), std::runtime_error);
+}
@@ -17,6 +17,7 @@
 #include "int128.hh"
 
 #include <random>
+#include <string>
 
 #include "gtest/gtest.h"
 
@@ -376,6 +377,43 @@ TEST_F(Uint128Test, Constexpr) {
   EXPECT_EQ(minus_two, numbers::make_uint128(-1, -2));
 }
 
+// Division, float conversion and formatting run at compile time.
+constexpr numbers::uint128 kTenPow38 = numbers::make_uint128(0x4B3B4CA85A86C47A, 0x098A224000000000);
+static_assert(kTenPow38 / 10 * 10 == kTenPow38);
+static_assert(kTenPow38 % 7 == 2);
+static_assert(numbers::uint128_max() / kTenPow38 == 3);
+static_assert(numbers::uint128(1e30) == numbers::make_uint128(0xC9F2C9CD0, 0x4675000000000000));
+static_assert(static_cast<double>(numbers::make_uint128(1, 0)) == 18446744073709551616.0);
+static_assert(static_cast<float>(numbers::uint128(12345)) == 12345.0f);
+
+struct DecimalText {
+  char text[40];
+  size_t size;
+};
+
+constexpr DecimalText decimal(numbers::uint128 value) {
+  DecimalText result{};
+  result.size = static_cast<size_t>(numbers::to_chars(result.text, result.text + 40, value) - result.text);
+  return result;
+}
+
+constexpr DecimalText kMaxText = decimal(numbers::uint128_max());
+static_assert(kMaxText.size == 39);
+static_assert(kMaxText.text[0] == '3' && kMaxText.text[38] == '5');
+
+TEST_F(Uint128Test, ConstexprDivisionAndFormatting) {
+  EXPECT_EQ(std::string(kMaxText.text, kMaxText.size), "340282366920938463463374607431768211455");
+
+  char buf[130];
+  char *end = numbers::to_chars(buf, buf + sizeof(buf), numbers::uint128_max(), 2);
+  EXPECT_EQ(std::string(buf, end), std::string(128, '1'));
+  end = numbers::to_chars(buf, buf + sizeof(buf), numbers::make_uint128(0xDEADBEEF, 0), 16);
+  EXPECT_EQ(std::string(buf, end), "deadbeef0000000000000000");
+  end = numbers::to_chars(buf, buf + sizeof(buf), numbers::uint128(0), 36);
+  EXPECT_EQ(std::string(buf, end), "0");
+  EXPECT_EQ(numbers::to_chars(buf, buf + 38, numbers::uint128_max()), nullptr);
+}
+
 TEST_F(Uint128Test, NumericLimits) {
   EXPECT_EQ(std::numeric_limits<numbers::uint128>::max(), numbers::uint128_max());
   EXPECT_EQ(std::numeric_limits<numbers::uint128>::min(), numbers::uint128(0));
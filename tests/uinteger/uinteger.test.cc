@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 
 #include <unordered_set>
+#include "io.hh"
 #include "test/utils.hh"
 #include "uinteger.hh"
 
@@ -47,6 +48,32 @@ TEST(UintegerTest, UintegerStringStream) {
     stream << num;
     ASSERT_EQ(stream.str(), std::to_string(n));
   }
+
+  std::ostringstream stream;
+  stream << u8(65) << ' ' << u128::MAX;
+  ASSERT_EQ(stream.str(), "65 340282366920938463463374607431768211455");
+}
+
+TEST(UintegerTest, UintegerStreamIn) {
+  std::istringstream stream("255 340282366920938463463374607431768211455 18446744073709551616");
+  u8 a;
+  u128 b;
+  u128 c;
+  stream >> a >> b >> c;
+  ASSERT_TRUE(stream.eof());
+  ASSERT_FALSE(stream.fail());
+  ASSERT_EQ(a, u8(255));
+  ASSERT_EQ(b, u128::MAX);
+  ASSERT_EQ(c, u128(uint128(1) << 64));
+
+  std::istringstream big("256 340282366920938463463374607431768211456");
+  big >> a;
+  ASSERT_TRUE(big.fail());
+  ASSERT_EQ(a, u8::MAX);
+  big.clear();
+  big >> b;
+  ASSERT_TRUE(big.fail());
+  ASSERT_EQ(b, u128::MAX);
 }
 
 TEST(UintegerTest, UintegerAdd) {
@@ -1,16 +1,11 @@
 #include "test/utils.hh"
 
-#include <cctype>
 #include <random>
 
-using u32 = uint_least32_t;
-using engine = std::mt19937;
+#include "random.hh"
 
 int random_integer(int min, int max) {
-  std::random_device os_seed;
-  const u32 seed = os_seed();
-  engine generator(seed);
-  std::uniform_int_distribution<u32> distribute(min, max);
-
-  return distribute(generator);
-}
\ No newline at end of file
+  // Seeded once per thread; reseeding from std::random_device on every call is slow and draws from the OS each time.
+  thread_local numbers::xoshiro256ss engine(std::random_device{}());
+  return numbers::uniform(engine, min, max);
+}